@@ -6,6 +6,7 @@
 */
 
 #include "FFT.tpp"
+#include "FftwSettings.h"
 
 namespace Pscf {
 namespace Prdc {
@@ -26,7 +27,7 @@ namespace Cpu {
                           CField<1>& cFieldIn, CField<1>& cFieldOut)
    {
       int n0 = rSize_;
-      unsigned int flags = FFTW_ESTIMATE;
+      unsigned int flags = FftwSettings::plannerFlags();
       rcfPlan_ = fftw_plan_dft_r2c_1d(n0, &rField[0], &kField[0], flags);
       criPlan_ = fftw_plan_dft_c2r_1d(n0, &kField[0], &rField[0], flags);
       int sign = FFTW_FORWARD;
@@ -41,7 +42,7 @@ namespace Cpu {
    void FFT<2>::makePlans(RField<2>& rField, RFieldDft<2>& kField,
                           CField<2>& cFieldIn, CField<2>& cFieldOut)
    {
-      unsigned int flags = FFTW_ESTIMATE;
+      unsigned int flags = FftwSettings::plannerFlags();
       int n0 = meshDimensions_[0];
       int n1 = meshDimensions_[1];
       rcfPlan_ = fftw_plan_dft_r2c_2d(n0, n1, &rField[0], &kField[0], flags);
@@ -58,7 +59,7 @@ namespace Cpu {
    void FFT<3>::makePlans(RField<3>& rField, RFieldDft<3>& kField,
                           CField<3>& cFieldIn, CField<3>& cFieldOut)
    {
-      unsigned int flags = FFTW_ESTIMATE;
+      unsigned int flags = FftwSettings::plannerFlags();
       int n0 = meshDimensions_[0];
       int n1 = meshDimensions_[1];
       int n2 = meshDimensions_[2];
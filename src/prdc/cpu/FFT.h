@@ -69,6 +69,23 @@ namespace Cpu {
       */
       void forwardTransform(RField<D> const & in, RFieldDft<D>& out) const;
 
+      /**
+      * Compute forward (real-to-complex) DFT without rescaling.
+      *
+      * The resulting complex array is the unaltered output of FFTW's 
+      * forward transform, which differs from that of forwardTransform
+      * by a factor of N (the number of grid points). This is intended 
+      * for use by callers that fold the factor 1/N into a subsequent 
+      * pointwise operation, avoiding a separate pass over the output.
+      *
+      * This function does not overwrite or corrupt the input array.
+      * 
+      * \param in  array of real values on r-space grid
+      * \param out  array of complex values on k-space grid
+      */
+      void forwardTransformUnscaled(RField<D> const & in, RFieldDft<D>& out)
+      const;
+
       /**
       * Compute inverse (complex-to-real) DFT, overwriting the input.
       * 
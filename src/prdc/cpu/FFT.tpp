@@ -151,6 +151,25 @@ namespace Cpu {
    void FFT<D>::forwardTransform(RField<D> const & rField, 
                                  RFieldDft<D>& kField)   
    const
+   {
+      // Execute preplanned forward transform 
+      forwardTransformUnscaled(rField, kField);
+
+      // Rescale the resulting array
+      double scale = 1.0/double(rSize_);
+      for (int i = 0; i < kSize_; ++i) {
+         kField[i][0] *= scale;
+         kField[i][1] *= scale;
+      }
+   }
+
+   /*
+   * Execute real-to-complex forward transform, without rescaling.
+   */
+   template <int D>
+   void FFT<D>::forwardTransformUnscaled(RField<D> const & rField, 
+                                         RFieldDft<D>& kField)   
+   const
    {
       UTIL_CHECK(isSetup_)
       UTIL_CHECK(rField.capacity() == rSize_);
@@ -162,13 +181,6 @@ namespace Cpu {
       // (See note at top of file explaining this use of const_cast)
       fftw_execute_dft_r2c(rcfPlan_, const_cast<double*>(&rField[0]), 
                            &kField[0]);
-
-      // Rescale the resulting array
-      double scale = 1.0/double(rSize_);
-      for (int i = 0; i < kSize_; ++i) {
-         kField[i][0] *= scale;
-         kField[i][1] *= scale;
-      }
    }
 
    /*
@@ -0,0 +1,20 @@
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2024, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "FFTBatched.tpp"
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+   template class FFTBatched<1>;
+   template class FFTBatched<2>;
+   template class FFTBatched<3>;
+
+} // namespace Pscf::Prdc::Cpu
+} // namespace Pscf::Prdc
+} // namespace Pscf
@@ -0,0 +1,200 @@
+#ifndef PRDC_CPU_FFT_BATCHED_H
+#define PRDC_CPU_FFT_BATCHED_H
+
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2024, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <prdc/cpu/FftwDArray.h>
+#include <pscf/math/IntVec.h>
+#include <util/global.h>
+
+#include <fftw3.h>
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+   using namespace Util;
+   using namespace Pscf;
+
+   /**
+   * Batched Fourier transform wrapper for real data.
+   *
+   * An FFTBatched<D> performs a batch of batchSize() independent
+   * real-to-complex or complex-to-real transforms with a single call
+   * to the FFTW library, using plans created by fftw_plan_many_dft_r2c
+   * and fftw_plan_many_dft_c2r. Fields in a batch are stored contiguously
+   * in a single array, such that field i of the batch begins at element
+   * i*N of an r-grid array, or at element i*K of a k-grid array, where
+   * N is the number of r-grid points and K is the number of k-grid
+   * points in the real-to-complex DFT mesh.
+   *
+   * This is the CPU analog of Prdc::Cuda::FFTBatched. Plans use the
+   * planner flags and thread count set in FftwSettings.
+   *
+   * \ingroup Prdc_Cpu_Module
+   */
+   template <int D>
+   class FFTBatched
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      FFTBatched();
+
+      /**
+      * Destructor.
+      */
+      virtual ~FFTBatched();
+
+      /**
+      * Set up FFT calculation (get grid dimensions and make FFT plans).
+      *
+      * \param meshDimensions  dimensions of real-space grid
+      * \param batchSize  number of simultaneous FFTs to perform
+      */
+      void setup(IntVec<D> const & meshDimensions, int batchSize);
+
+      /**
+      * Compute batched forward (real-to-complex) DFTs.
+      *
+      * The resulting complex array is the output of FFTW's batched
+      * forward transform scaled by a factor of 1/N (where N is the
+      * number of grid points). The scaling ensures that a round-trip
+      * Fourier transform (forward + inverse) reproduces the original
+      * input array.
+      *
+      * This function does not overwrite or corrupt the input array.
+      *
+      * \param rFields  real values on r-grid for all fields (input)
+      * \param kFields  complex values on k-grid for all fields (output)
+      */
+      void forwardTransform(FftwDArray<double> const & rFields,
+                            FftwDArray<fftw_complex>& kFields) const;
+
+      /**
+      * Compute batched forward (real-to-complex) DFTs without rescaling.
+      *
+      * Identical to forwardTransform, except that the output is not
+      * multiplied by 1/N. See FFT<D>::forwardTransformUnscaled.
+      *
+      * \param rFields  real values on r-grid for all fields (input)
+      * \param kFields  complex values on k-grid for all fields (output)
+      */
+      void forwardTransformUnscaled(FftwDArray<double> const & rFields,
+                                    FftwDArray<fftw_complex>& kFields) 
+      const;
+
+      /**
+      * Compute batched inverse (complex-to-real) DFTs.
+      *
+      * The resulting real array is the unaltered output of FFTW's inverse
+      * transform function.
+      *
+      * As for FFT<D>::inverseTransformUnsafe, the input array is
+      * overwritten by the complex-to-real transform.
+      *
+      * \param kFields  complex values on k-grid (input, overwritten)
+      * \param rFields  real values on r-grid (output)
+      */
+      void inverseTransformUnsafe(FftwDArray<fftw_complex>& kFields,
+                                  FftwDArray<double>& rFields) const;
+
+      /**
+      * Set the batch size to a new value. isSetup() must already be true.
+      *
+      * \param batchSize  the new batch size
+      */
+      void resetBatchSize(int batchSize);
+
+      /**
+      * Return the dimensions of the grid for which this was setup.
+      */
+      IntVec<D> const & meshDimensions() const;
+
+      /**
+      * Return the number of fields in each batch.
+      */
+      int batchSize() const;
+
+      /**
+      * Has the setup method been called?
+      */
+      bool isSetup() const;
+
+   private:
+
+      /// Vector containing number of r-grid points in each direction.
+      IntVec<D> meshDimensions_;
+
+      /// Number of FFTs in batch
+      int batchSize_;
+
+      /// Number of points in r-space grid
+      int rSize_;
+
+      /// Number of points in k-space grid
+      int kSize_;
+
+      /// Plan for a batched real-to-complex forward transform.
+      fftw_plan fPlan_;
+
+      /// Plan for a batched complex-to-real inverse transform.
+      fftw_plan iPlan_;
+
+      /// Have array dimension and plans been initialized?
+      bool isSetup_;
+
+      /**
+      * Make FFTW plans for transform and inverse transform.
+      *
+      * \param batchSize  number of simultaneous FFTs to perform
+      */
+      void makePlans(int batchSize);
+
+      /**
+      * Destroy any existing FFTW plans.
+      */
+      void destroyPlans();
+
+   };
+
+   /*
+   * Return the dimensions of the grid for which this was setup.
+   */
+   template <int D>
+   inline IntVec<D> const & FFTBatched<D>::meshDimensions() const
+   {  return meshDimensions_; }
+
+   /*
+   * Return the number of fields in each batch.
+   */
+   template <int D>
+   inline int FFTBatched<D>::batchSize() const
+   {  return batchSize_; }
+
+   /*
+   * Has the setup method been called?
+   */
+   template <int D>
+   inline bool FFTBatched<D>::isSetup() const
+   {  return isSetup_; }
+
+   #ifndef PRDC_CPU_FFT_BATCHED_TPP
+   // Suppress implicit instantiation
+   extern template class FFTBatched<1>;
+   extern template class FFTBatched<2>;
+   extern template class FFTBatched<3>;
+   #endif
+
+} // namespace Pscf::Prdc::Cpu
+} // namespace Pscf::Prdc
+} // namespace Pscf
+#endif
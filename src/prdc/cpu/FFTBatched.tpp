@@ -0,0 +1,218 @@
+#ifndef PRDC_CPU_FFT_BATCHED_TPP
+#define PRDC_CPU_FFT_BATCHED_TPP
+
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2024, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "FFTBatched.h"
+#include "FftwSettings.h"
+
+/*
+* A note about const_casts: See the corresponding note at the top of
+* the file FFT.tpp. The forward real-to-complex transform does not
+* modify its input, but FFTW requires a non-const pointer to the input.
+*
+* A note about alignment: The new-array execute functions used here
+* require that arrays passed to a plan have the same alignment as the
+* arrays used to create the plan. All arrays are FftwDArray objects,
+* which are allocated from the FieldPool with 64 byte alignment, and so
+* satisfy this requirement.
+*/
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+   using namespace Util;
+
+   /*
+   * Default constructor.
+   */
+   template <int D>
+   FFTBatched<D>::FFTBatched()
+    : meshDimensions_(0),
+      batchSize_(0),
+      rSize_(0),
+      kSize_(0),
+      fPlan_(0),
+      iPlan_(0),
+      isSetup_(false)
+   {}
+
+   /*
+   * Destructor.
+   */
+   template <int D>
+   FFTBatched<D>::~FFTBatched()
+   {  destroyPlans(); }
+
+   /*
+   * Set up FFT calculation (store grid dimensions and make FFT plans)
+   */
+   template <int D>
+   void FFTBatched<D>::setup(IntVec<D> const & meshDimensions, int batchSize)
+   {
+      // Preconditions
+      UTIL_CHECK(!isSetup_);
+      UTIL_CHECK(batchSize > 0);
+
+      // Set mesh dimensions
+      rSize_ = 1;
+      kSize_ = 1;
+      for (int i = 0; i < D; ++i) {
+         UTIL_CHECK(meshDimensions[i] > 0);
+         meshDimensions_[i] = meshDimensions[i];
+         rSize_ *= meshDimensions[i];
+         if (i < D - 1) {
+            kSize_ *= meshDimensions[i];
+         } else {
+            kSize_ *= (meshDimensions[i]/2 + 1);
+         }
+      }
+
+      // Make FFT plans
+      makePlans(batchSize);
+
+      isSetup_ = true;
+   }
+
+   /*
+   * Set the batch size to a new value. isSetup() must already be true.
+   */
+   template <int D>
+   void FFTBatched<D>::resetBatchSize(int batchSize)
+   {
+      UTIL_CHECK(isSetup_);
+      UTIL_CHECK(batchSize > 0);
+
+      if (batchSize == batchSize_) {
+         // Nothing to do
+         return;
+      } else {
+         // Remake FFT plans
+         makePlans(batchSize);
+      }
+   }
+
+   /*
+   * Make plans for a specified batch size.
+   */
+   template <int D>
+   void FFTBatched<D>::makePlans(int batchSize)
+   {
+      UTIL_CHECK(rSize_ > 0);
+      UTIL_CHECK(kSize_ > 0);
+      destroyPlans();
+      batchSize_ = batchSize;
+
+      int n[D];
+      for (int i = 0; i < D; ++i) {
+         n[i] = meshDimensions_[i];
+      }
+
+      // Temporary aligned arrays used only for planning
+      FftwDArray<double> rFields;
+      FftwDArray<fftw_complex> kFields;
+      rFields.allocate(rSize_*batchSize_);
+      kFields.allocate(kSize_*batchSize_);
+
+      unsigned int flags = FftwSettings::plannerFlags();
+      fPlan_ = fftw_plan_many_dft_r2c(D, n, batchSize_,
+                                      &rFields[0], NULL, 1, rSize_,
+                                      &kFields[0], NULL, 1, kSize_,
+                                      flags);
+      iPlan_ = fftw_plan_many_dft_c2r(D, n, batchSize_,
+                                      &kFields[0], NULL, 1, kSize_,
+                                      &rFields[0], NULL, 1, rSize_,
+                                      flags);
+      if (!fPlan_ || !iPlan_) {
+         UTIL_THROW("Failure to create batched FFTW plans");
+      }
+   }
+
+   /*
+   * Destroy any existing plans.
+   */
+   template <int D>
+   void FFTBatched<D>::destroyPlans()
+   {
+      if (fPlan_) {
+         fftw_destroy_plan(fPlan_);
+         fPlan_ = 0;
+      }
+      if (iPlan_) {
+         fftw_destroy_plan(iPlan_);
+         iPlan_ = 0;
+      }
+   }
+
+   /*
+   * Execute batched forward (real-to-complex) transform.
+   */
+   template <int D>
+   void FFTBatched<D>::forwardTransform(FftwDArray<double> const & rFields,
+                                        FftwDArray<fftw_complex>& kFields)
+   const
+   {
+      // Execute preplanned forward transform
+      forwardTransformUnscaled(rFields, kFields);
+
+      // Rescale the resulting array
+      double scale = 1.0/double(rSize_);
+      int n = kSize_ * batchSize_;
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for
+      #endif
+      for (int i = 0; i < n; ++i) {
+         kFields[i][0] *= scale;
+         kFields[i][1] *= scale;
+      }
+   }
+
+   /*
+   * Execute batched forward (real-to-complex) transform, without rescaling.
+   */
+   template <int D>
+   void 
+   FFTBatched<D>::forwardTransformUnscaled(
+                                 FftwDArray<double> const & rFields,
+                                 FftwDArray<fftw_complex>& kFields)
+   const
+   {
+      // Preconditions
+      UTIL_CHECK(isSetup_);
+      UTIL_CHECK(rFields.capacity() == rSize_ * batchSize_);
+      UTIL_CHECK(kFields.capacity() == kSize_ * batchSize_);
+
+      // Execute preplanned forward transform
+      // (See note at top of file explaining this use of const_cast)
+      fftw_execute_dft_r2c(fPlan_, const_cast<double*>(&rFields[0]),
+                           &kFields[0]);
+   }
+
+   /*
+   * Execute batched inverse (complex-to-real) transform.
+   */
+   template <int D>
+   void
+   FFTBatched<D>::inverseTransformUnsafe(FftwDArray<fftw_complex>& kFields,
+                                         FftwDArray<double>& rFields)
+   const
+   {
+      // Preconditions
+      UTIL_CHECK(isSetup_);
+      UTIL_CHECK(kFields.capacity() == kSize_ * batchSize_);
+      UTIL_CHECK(rFields.capacity() == rSize_ * batchSize_);
+
+      // Execute preplanned inverse transform
+      fftw_execute_dft_c2r(iPlan_, &kFields[0], &rFields[0]);
+   }
+
+}
+}
+}
+#endif
@@ -0,0 +1,205 @@
+#ifndef PRDC_CPU_FFT_MIRROR_H
+#define PRDC_CPU_FFT_MIRROR_H
+
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2024, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <prdc/cpu/RField.h>
+#include <pscf/math/IntVec.h>
+#include <util/containers/DArray.h>
+#include <util/global.h>
+
+#include <fftw3.h>
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+   using namespace Util;
+   using namespace Pscf;
+
+   /**
+   * Real-to-real Fourier transform for mirror-symmetric real fields.
+   *
+   * An FFTMirror<D> transforms real periodic fields that are even under
+   * a reflection x_i -> -x_i through the origin along every axis i of
+   * the mesh, i.e., fields with f(..., x_i, ...) = f(..., -x_i, ...).
+   * The DFT of such a field is real and is even in each wavevector
+   * index, and the field and its DFT are both fully specified by their
+   * values in a reduced grid with N_i/2 + 1 points along each axis i,
+   * where N_i is the number of full mesh points along axis i (which
+   * must be even). On the reduced grid, the DFT is a D-dimensional
+   * type-I discrete cosine transform (FFTW kind REDFT00), which requires
+   * roughly 2^D times fewer operations than a real-to-complex FFT of
+   * the full field.
+   *
+   * The transform computed by transform() is unscaled. It is its own
+   * inverse up to a factor of N, the number of points in the full mesh:
+   * applying it twice multiplies a field by N. On the reduced grid,
+   * the unscaled transform is equal to the unscaled forward DFT of
+   * the full field, restricted to non-negative wavevector indices.
+   *
+   * The functions gather() and scatter() copy a full field to and from
+   * the reduced grid. The reduced grid uses the same row-major ordering
+   * as the full mesh, with reduced dimensions N_i/2 + 1.
+   *
+   * Plans use the planner flags and thread count set in FftwSettings.
+   *
+   * \ingroup Prdc_Cpu_Module
+   */
+   template <int D>
+   class FFTMirror
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      FFTMirror();
+
+      /**
+      * Destructor.
+      */
+      virtual ~FFTMirror();
+
+      /**
+      * Setup grid dimensions, index maps and FFT plan.
+      *
+      * Every element of meshDimensions must be even.
+      *
+      * \param meshDimensions  dimensions of the full real-space grid
+      */
+      void setup(IntVec<D> const & meshDimensions);
+
+      /**
+      * Compute the unscaled type-I cosine transform on the reduced grid.
+      *
+      * Arrays in and out must be distinct and have capacity reducedSize().
+      * The input array is not modified.
+      *
+      * \param in  field values on the reduced grid (input)
+      * \param out  transformed values on the reduced grid (output)
+      */
+      void transform(RField<D> const & in, RField<D>& out) const;
+
+      /**
+      * Copy values of a full mirror-symmetric field to the reduced grid.
+      *
+      * \param full  field on the full mesh (input)
+      * \param reduced  field on the reduced grid (output)
+      */
+      void gather(RField<D> const & full, RField<D>& reduced) const;
+
+      /**
+      * Expand a field on the reduced grid to the full mesh.
+      *
+      * Each full mesh point is assigned the value of the reduced grid
+      * point to which it is mapped by reflections.
+      *
+      * \param reduced  field on the reduced grid (input)
+      * \param full  field on the full mesh (output)
+      */
+      void scatter(RField<D> const & reduced, RField<D>& full) const;
+
+      /**
+      * Return the dimensions of the full grid.
+      */
+      IntVec<D> const & meshDimensions() const;
+
+      /**
+      * Return the dimensions of the reduced grid (N_i/2 + 1).
+      */
+      IntVec<D> const & reducedDimensions() const;
+
+      /**
+      * Return the number of points in the reduced grid.
+      */
+      int reducedSize() const;
+
+      /**
+      * Has the setup method been called?
+      */
+      bool isSetup() const;
+
+      /**
+      * Can a mesh with these dimensions be used by an FFTMirror?
+      *
+      * Returns true if every dimension is even.
+      *
+      * \param meshDimensions  dimensions of the full real-space grid
+      */
+      static bool isValidMesh(IntVec<D> const & meshDimensions);
+
+   private:
+
+      /// Number of grid points in each direction of the full mesh.
+      IntVec<D> meshDimensions_;
+
+      /// Number of grid points in each direction of the reduced grid.
+      IntVec<D> reducedDimensions_;
+
+      /// Number of points in the full mesh.
+      int rSize_;
+
+      /// Number of points in the reduced grid.
+      int reducedSize_;
+
+      /// Full mesh rank of each reduced grid point (used by gather).
+      DArray<int> fullIds_;
+
+      /// Reduced grid rank of each full mesh point (used by scatter).
+      DArray<int> reducedIds_;
+
+      /// Plan for the type-I cosine transform.
+      fftw_plan plan_;
+
+      /// Have array dimensions and plans been initialized?
+      bool isSetup_;
+
+      /// Copy constructor (private and not implemented)
+      FFTMirror(FFTMirror const &);
+
+      /// Assignment operator (private and not implemented)
+      FFTMirror& operator = (FFTMirror const &);
+
+      /**
+      * Destroy any existing FFTW plan.
+      */
+      void destroyPlan();
+
+   };
+
+   // Inline functions
+
+   template <int D>
+   inline IntVec<D> const & FFTMirror<D>::meshDimensions() const
+   {  return meshDimensions_; }
+
+   template <int D>
+   inline IntVec<D> const & FFTMirror<D>::reducedDimensions() const
+   {  return reducedDimensions_; }
+
+   template <int D>
+   inline int FFTMirror<D>::reducedSize() const
+   {  return reducedSize_; }
+
+   template <int D>
+   inline bool FFTMirror<D>::isSetup() const
+   {  return isSetup_; }
+
+   #ifndef PRDC_CPU_FFT_MIRROR_TPP
+   // Suppress implicit instantiation
+   extern template class FFTMirror<1>;
+   extern template class FFTMirror<2>;
+   extern template class FFTMirror<3>;
+   #endif
+
+} // namespace Pscf::Prdc::Cpu
+} // namespace Pscf::Prdc
+} // namespace Pscf
+#endif
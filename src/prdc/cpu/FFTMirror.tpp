@@ -0,0 +1,205 @@
+#ifndef PRDC_CPU_FFT_MIRROR_TPP
+#define PRDC_CPU_FFT_MIRROR_TPP
+
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2024, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "FFTMirror.h"
+#include "FftwDArray.h"
+#include "FftwSettings.h"
+#include <pscf/mesh/MeshIterator.h>
+
+/*
+* A note about const_casts: See the corresponding note at the top of
+* the file FFT.tpp. The real-to-real transform does not modify its
+* input, but FFTW requires a non-const pointer to the input.
+*
+* A note about alignment: The new-array execute function used here
+* requires that arrays passed to the plan have the same alignment as
+* the arrays used to create the plan. All arrays are RField objects,
+* which are allocated from the FieldPool with 64 byte alignment, and so
+* satisfy this requirement.
+*/
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+   using namespace Util;
+
+   /*
+   * Default constructor.
+   */
+   template <int D>
+   FFTMirror<D>::FFTMirror()
+    : meshDimensions_(0),
+      reducedDimensions_(0),
+      rSize_(0),
+      reducedSize_(0),
+      fullIds_(),
+      reducedIds_(),
+      plan_(0),
+      isSetup_(false)
+   {}
+
+   /*
+   * Destructor.
+   */
+   template <int D>
+   FFTMirror<D>::~FFTMirror()
+   {  destroyPlan(); }
+
+   /*
+   * Can a mesh with these dimensions be used by an FFTMirror?
+   */
+   template <int D>
+   bool FFTMirror<D>::isValidMesh(IntVec<D> const & meshDimensions)
+   {
+      for (int i = 0; i < D; ++i) {
+         if (meshDimensions[i] < 2 || meshDimensions[i] % 2 != 0) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   /*
+   * Set up dimensions, index maps and plan.
+   */
+   template <int D>
+   void FFTMirror<D>::setup(IntVec<D> const & meshDimensions)
+   {
+      // Preconditions
+      UTIL_CHECK(!isSetup_);
+      if (!isValidMesh(meshDimensions)) {
+         UTIL_THROW("FFTMirror requires even mesh dimensions");
+      }
+
+      // Set full and reduced grid dimensions
+      rSize_ = 1;
+      reducedSize_ = 1;
+      for (int i = 0; i < D; ++i) {
+         meshDimensions_[i] = meshDimensions[i];
+         reducedDimensions_[i] = meshDimensions[i]/2 + 1;
+         rSize_ *= meshDimensions_[i];
+         reducedSize_ *= reducedDimensions_[i];
+      }
+
+      // Map each full mesh point to its image in the reduced grid,
+      // folding index p along each axis to min(p, N - p).
+      reducedIds_.allocate(rSize_);
+      fullIds_.allocate(reducedSize_);
+      MeshIterator<D> iter;
+      iter.setDimensions(meshDimensions_);
+      IntVec<D> position;
+      int p, reducedRank, fullRank;
+      bool isReduced;
+      for (iter.begin(); !iter.atEnd(); ++iter) {
+         position = iter.position();
+         reducedRank = 0;
+         isReduced = true;
+         for (int i = 0; i < D; ++i) {
+            p = position[i];
+            if (p > meshDimensions_[i]/2) {
+               p = meshDimensions_[i] - p;
+               isReduced = false;
+            }
+            reducedRank = reducedRank*reducedDimensions_[i] + p;
+         }
+         fullRank = iter.rank();
+         reducedIds_[fullRank] = reducedRank;
+         if (isReduced) {
+            fullIds_[reducedRank] = fullRank;
+         }
+      }
+
+      // Make plan, using temporary aligned arrays
+      int n[D];
+      fftw_r2r_kind kinds[D];
+      for (int i = 0; i < D; ++i) {
+         n[i] = reducedDimensions_[i];
+         kinds[i] = FFTW_REDFT00;
+      }
+      FftwDArray<double> in;
+      FftwDArray<double> out;
+      in.allocate(reducedSize_);
+      out.allocate(reducedSize_);
+      unsigned int flags = FftwSettings::plannerFlags();
+      plan_ = fftw_plan_r2r(D, n, &in[0], &out[0], kinds, flags);
+      if (!plan_) {
+         UTIL_THROW("Failure to create mirror FFTW plan");
+      }
+
+      isSetup_ = true;
+   }
+
+   /*
+   * Compute the unscaled type-I cosine transform on the reduced grid.
+   */
+   template <int D>
+   void FFTMirror<D>::transform(RField<D> const & in, RField<D>& out)
+   const
+   {
+      UTIL_CHECK(isSetup_);
+      UTIL_CHECK(in.capacity() == reducedSize_);
+      UTIL_CHECK(out.capacity() == reducedSize_);
+      UTIL_CHECK(&in[0] != &out[0]);
+
+      fftw_execute_r2r(plan_, const_cast<double*>(&in[0]), &out[0]);
+   }
+
+   /*
+   * Copy a full mirror-symmetric field to the reduced grid.
+   */
+   template <int D>
+   void FFTMirror<D>::gather(RField<D> const & full, RField<D>& reduced)
+   const
+   {
+      UTIL_CHECK(isSetup_);
+      UTIL_CHECK(full.capacity() == rSize_);
+      UTIL_CHECK(reduced.capacity() == reducedSize_);
+
+      for (int i = 0; i < reducedSize_; ++i) {
+         reduced[i] = full[fullIds_[i]];
+      }
+   }
+
+   /*
+   * Expand a field on the reduced grid to the full mesh.
+   */
+   template <int D>
+   void FFTMirror<D>::scatter(RField<D> const & reduced, RField<D>& full)
+   const
+   {
+      UTIL_CHECK(isSetup_);
+      UTIL_CHECK(full.capacity() == rSize_);
+      UTIL_CHECK(reduced.capacity() == reducedSize_);
+
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for
+      #endif
+      for (int i = 0; i < rSize_; ++i) {
+         full[i] = reduced[reducedIds_[i]];
+      }
+   }
+
+   /*
+   * Destroy any existing plan.
+   */
+   template <int D>
+   void FFTMirror<D>::destroyPlan()
+   {
+      if (plan_) {
+         fftw_destroy_plan(plan_);
+         plan_ = 0;
+      }
+   }
+
+}
+}
+}
+#endif
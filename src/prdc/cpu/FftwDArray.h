@@ -22,9 +22,11 @@ namespace Cpu {
    /**
    * Dynamic array with data aligned for use with FFTW library.
    *
-   * The allocate and deallocate functions of this class use functions
-   * provided by the FFTW library to allocate and free aligned memory. 
-   * The class is otherwise similar in most respects to a Util::DArray.
+   * The allocate and deallocate functions of this class obtain memory
+   * from and return memory to the FieldPool, which provides blocks that
+   * are aligned to 64 byte boundaries, as required for efficient use of
+   * SIMD instructions by FFTW and by VecOp kernels. The class is 
+   * otherwise similar in most respects to a Util::DArray.
    *
    * \ingroup Prdc_Cpu_Module
    */
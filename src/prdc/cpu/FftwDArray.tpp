@@ -9,7 +9,7 @@
 */
 
 #include "FftwDArray.h"
-#include <fftw3.h>
+#include "FieldPool.h"
 
 namespace Pscf {
 namespace Prdc {
@@ -32,7 +32,8 @@ namespace Cpu {
    FftwDArray<Data>::~FftwDArray()
    {
       if (isAllocated()) {
-         fftw_free(data_);
+         FieldPool::release((void*) data_, sizeof(Data)*capacity_);
+         data_ = 0;
          capacity_ = 0;
       }
    }
@@ -40,7 +41,8 @@ namespace Cpu {
    /*
    * Allocate the underlying C array.
    *
-   * Throw an Exception if the FftwDArray has already been allocated.
+   * Memory is obtained from the FieldPool, and is aligned to a 64 byte
+   * boundary. Throw an Exception if the FftwDArray has already been allocated.
    *
    * \param capacity number of elements to allocate.
    */
@@ -53,8 +55,8 @@ namespace Cpu {
       if (capacity <= 0) {
          UTIL_THROW("Attempt to allocate FftwDArray with capacity <= 0");
       }
+      data_ = (Data*) FieldPool::allocate(sizeof(Data)*capacity);
       capacity_ = capacity;
-      data_ = (Data*) fftw_malloc(sizeof(Data)*capacity);
    }
 
    /*
@@ -68,7 +70,8 @@ namespace Cpu {
       if (!isAllocated()) {
          UTIL_THROW("Array is not allocated");
       }
-      fftw_free(data_);
+      FieldPool::release((void*) data_, sizeof(Data)*capacity_);
+      data_ = 0;
       capacity_ = 0;
    }
 
@@ -0,0 +1,147 @@
+/*
+* PSCF Package 
+*
+* Copyright 2016 - 2024, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "FftwSettings.h"
+#include <util/global.h>
+#include <util/misc/Log.h>
+
+#include <fftw3.h>
+
+using namespace Util;
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+namespace FftwSettings {
+
+   // Anonymous namespace for static global variables
+   namespace {
+
+      // Number of threads used by new plans
+      int nThread_ = 1;
+
+      // Name of planner rigor level
+      std::string plannerRigor_ = "estimate";
+
+      // FFTW planner flags
+      unsigned int plannerFlags_ = FFTW_ESTIMATE;
+
+      #ifdef PSCF_OPENMP
+      // Has fftw_init_threads been called?
+      bool hasThreads_ = false;
+      #endif
+
+   }
+
+   /*
+   * Set the number of threads used by new plans.
+   */
+   void setNThread(int nThread)
+   {
+      if (nThread <= 0) {
+         UTIL_THROW("Non-positive number of FFTW threads");
+      }
+      #ifdef PSCF_OPENMP
+      if (!hasThreads_) {
+         if (fftw_init_threads() == 0) {
+            UTIL_THROW("Failure in fftw_init_threads");
+         }
+         hasThreads_ = true;
+      }
+      fftw_plan_with_nthreads(nThread);
+      nThread_ = nThread;
+      #else
+      if (nThread > 1) {
+         Log::file() << "Warning: OpenMP is not enabled, "
+                     << "FFTW will use 1 thread" << std::endl;
+      }
+      #endif
+   }
+
+   /*
+   * Get the number of threads used by new plans.
+   */
+   int nThread()
+   {  return nThread_; }
+
+   /*
+   * Set the planner rigor level by name.
+   */
+   void setPlannerRigor(std::string const & rigor)
+   {
+      if (rigor == "estimate") {
+         plannerFlags_ = FFTW_ESTIMATE;
+      } else 
+      if (rigor == "measure") {
+         plannerFlags_ = FFTW_MEASURE;
+      } else 
+      if (rigor == "patient") {
+         plannerFlags_ = FFTW_PATIENT;
+      } else 
+      if (rigor == "exhaustive") {
+         plannerFlags_ = FFTW_EXHAUSTIVE;
+      } else {
+         std::string msg = "Unknown FFTW planner rigor [";
+         msg += rigor;
+         msg += "]";
+         UTIL_THROW(msg.c_str());
+      }
+      plannerRigor_ = rigor;
+   }
+
+   /*
+   * Get the name of the planner rigor level.
+   */
+   std::string const & plannerRigor()
+   {  return plannerRigor_; }
+
+   /*
+   * Get the planner flags.
+   */
+   unsigned int plannerFlags()
+   {  return plannerFlags_; }
+
+   /*
+   * Import wisdom from a file, if it exists.
+   */
+   bool importWisdom(std::string const & filename)
+   {
+      int status = fftw_import_wisdom_from_filename(filename.c_str());
+      return (status != 0);
+   }
+
+   /*
+   * Export accumulated wisdom to a file.
+   */
+   void exportWisdom(std::string const & filename)
+   {
+      int status = fftw_export_wisdom_to_filename(filename.c_str());
+      if (status == 0) {
+         Log::file() << "Warning: Failure to write FFTW wisdom file "
+                     << filename << std::endl;
+      }
+   }
+
+   /*
+   * Free all FFTW global data.
+   */
+   void cleanup()
+   {
+      #ifdef PSCF_OPENMP
+      if (hasThreads_) {
+         fftw_cleanup_threads();
+         hasThreads_ = false;
+         return;
+      }
+      #endif
+      fftw_cleanup();
+   }
+
+} // namespace FftwSettings
+} // namespace Pscf::Prdc::Cpu
+} // namespace Pscf::Prdc
+} // namespace Pscf
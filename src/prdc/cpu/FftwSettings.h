@@ -0,0 +1,105 @@
+#ifndef PRDC_CPU_FFTW_SETTINGS_H
+#define PRDC_CPU_FFTW_SETTINGS_H
+
+/*
+* PSCF Package 
+*
+* Copyright 2016 - 2024, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <string>
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+/**
+* Global settings used by the FFTW planner.
+*
+* The FFTW library stores the number of threads used by new plans and
+* accumulated "wisdom" (records of previously measured plans) as global
+* state of the process. The functions in this namespace control these
+* global settings and the planner rigor flag used by all subsequent calls
+* to FFT<D>::setup, FFTBatched<D>::setup and related functions.
+*
+* Multithreaded transforms are only available if the package is compiled
+* with OpenMP enabled (i.e., with PSCF_OPENMP defined), in which case 
+* FFTW's OpenMP threads library must also be linked. 
+*/
+namespace FftwSettings {
+
+   /**
+   * \defgroup Prdc_Cpu_FftwSettings_Module FftwSettings
+   *
+   * Global settings for the FFTW planner.
+   *
+   * \ingroup Prdc_Cpu_Module
+   * @{
+   */
+
+   /**
+   * Set the number of threads used by subsequently created plans.
+   *
+   * Has no effect except for printing a warning if OpenMP is disabled.
+   *
+   * \param nThread  number of threads (must be positive)
+   */
+   void setNThread(int nThread);
+
+   /**
+   * Get the number of threads used by new FFTW plans.
+   */
+   int nThread();
+
+   /**
+   * Set the planner rigor by name.
+   *
+   * Allowed values are "estimate", "measure", "patient" and 
+   * "exhaustive", corresponding to the FFTW planner flags FFTW_ESTIMATE, 
+   * FFTW_MEASURE, FFTW_PATIENT and FFTW_EXHAUSTIVE. An Exception is 
+   * thrown for any other string. The default is "estimate".
+   *
+   * \param rigor  name of planner rigor level
+   */
+   void setPlannerRigor(std::string const & rigor);
+
+   /**
+   * Get the name of the current planner rigor level.
+   */
+   std::string const & plannerRigor();
+
+   /**
+   * Get the FFTW planner flag for the current rigor level.
+   */
+   unsigned int plannerFlags();
+
+   /**
+   * Import FFTW wisdom from a file, if the file exists.
+   *
+   * \param filename  name of wisdom file
+   * \return true if wisdom was imported, false otherwise
+   */
+   bool importWisdom(std::string const & filename);
+
+   /**
+   * Export all accumulated FFTW wisdom to a file.
+   *
+   * \param filename  name of wisdom file
+   */
+   void exportWisdom(std::string const & filename);
+
+   /**
+   * Free all memory and global data used by FFTW.
+   *
+   * This should be called once at the end of the main program.
+   */
+   void cleanup();
+
+   /** @} */
+
+} // namespace FftwSettings
+} // namespace Pscf::Prdc::Cpu
+} // namespace Pscf::Prdc
+} // namespace Pscf
+#endif
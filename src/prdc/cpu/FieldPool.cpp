@@ -0,0 +1,207 @@
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2024, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "FieldPool.h"
+#include <util/global.h>
+
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+using namespace Util;
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+namespace FieldPool {
+
+   // Anonymous namespace for static global variables and functions
+   namespace {
+
+      // Global state of the pool
+      struct State
+      {
+         // Free blocks, indexed by rounded size in bytes
+         std::map< std::size_t, std::vector<void*> > freeLists;
+
+         // Total size of all blocks in freeLists
+         std::size_t cachedBytes;
+
+         // Number of calls to allocate
+         long nAllocate;
+
+         // Number of calls to allocate served from freeLists
+         long nReuse;
+
+         // Are released blocks cached for reuse?
+         bool isEnabled;
+
+         State()
+          : freeLists(),
+            cachedBytes(0),
+            nAllocate(0),
+            nReuse(0),
+            isEnabled(false)
+         {}
+      };
+
+      /*
+      * Return the global pool state.
+      *
+      * The state is created on first use and never destroyed, so that
+      * fields with static storage duration may be safely destroyed at
+      * program exit.
+      */
+      State& state()
+      {
+         static State* statePtr = new State();
+         return *statePtr;
+      }
+
+      /*
+      * Round a size up to a multiple of the alignment.
+      */
+      std::size_t roundedSize(std::size_t nBytes)
+      {  return ((nBytes + alignment - 1)/alignment)*alignment; }
+
+      /*
+      * Free all cached blocks (caller must hold the lock).
+      */
+      void freeCached(State& s)
+      {
+         std::map< std::size_t, std::vector<void*> >::iterator iter;
+         for (iter = s.freeLists.begin(); iter != s.freeLists.end(); ++iter) {
+            for (std::size_t i = 0; i < iter->second.size(); ++i) {
+               std::free(iter->second[i]);
+            }
+         }
+         s.freeLists.clear();
+         s.cachedBytes = 0;
+      }
+
+   }
+
+   /*
+   * Obtain an aligned block of at least nBytes bytes.
+   */
+   void* allocate(std::size_t nBytes)
+   {
+      UTIL_CHECK(nBytes > 0);
+      std::size_t size = roundedSize(nBytes);
+      void* ptr = 0;
+
+      #ifdef PSCF_OPENMP
+      #pragma omp critical(PrdcCpuFieldPool)
+      #endif
+      {
+         State& s = state();
+         ++s.nAllocate;
+         std::map< std::size_t, std::vector<void*> >::iterator iter;
+         iter = s.freeLists.find(size);
+         if (iter != s.freeLists.end() && !iter->second.empty()) {
+            ptr = iter->second.back();
+            iter->second.pop_back();
+            s.cachedBytes -= size;
+            ++s.nReuse;
+         }
+      }
+
+      if (!ptr) {
+         if (posix_memalign(&ptr, alignment, size) != 0) {
+            ptr = 0;
+         }
+      }
+      if (!ptr) {
+         UTIL_THROW("Failure to allocate aligned field memory");
+      }
+      return ptr;
+   }
+
+   /*
+   * Return a block to the pool, or free it if the pool is disabled.
+   */
+   void release(void* ptr, std::size_t nBytes)
+   {
+      if (!ptr) return;
+      std::size_t size = roundedSize(nBytes);
+      bool isCached = false;
+
+      #ifdef PSCF_OPENMP
+      #pragma omp critical(PrdcCpuFieldPool)
+      #endif
+      {
+         State& s = state();
+         if (s.isEnabled) {
+            s.freeLists[size].push_back(ptr);
+            s.cachedBytes += size;
+            isCached = true;
+         }
+      }
+
+      if (!isCached) {
+         std::free(ptr);
+      }
+   }
+
+   /*
+   * Enable or disable reuse of released blocks.
+   */
+   void setEnabled(bool enabled)
+   {
+      #ifdef PSCF_OPENMP
+      #pragma omp critical(PrdcCpuFieldPool)
+      #endif
+      {
+         State& s = state();
+         s.isEnabled = enabled;
+         if (!enabled) {
+            freeCached(s);
+         }
+      }
+   }
+
+   /*
+   * Is reuse of released blocks enabled?
+   */
+   bool isEnabled()
+   {  return state().isEnabled; }
+
+   /*
+   * Free all cached blocks.
+   */
+   void clear()
+   {
+      #ifdef PSCF_OPENMP
+      #pragma omp critical(PrdcCpuFieldPool)
+      #endif
+      {
+         freeCached(state());
+      }
+   }
+
+   /*
+   * Get the total number of calls to allocate().
+   */
+   long nAllocate()
+   {  return state().nAllocate; }
+
+   /*
+   * Get the number of calls to allocate() served by a cached block.
+   */
+   long nReuse()
+   {  return state().nReuse; }
+
+   /*
+   * Get the total size of all cached blocks.
+   */
+   std::size_t cachedBytes()
+   {  return state().cachedBytes; }
+
+} // namespace FieldPool
+} // namespace Pscf::Prdc::Cpu
+} // namespace Pscf::Prdc
+} // namespace Pscf
@@ -0,0 +1,116 @@
+#ifndef PRDC_CPU_FIELD_POOL_H
+#define PRDC_CPU_FIELD_POOL_H
+
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2024, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <cstddef>
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+/**
+* Process-wide pool of aligned memory blocks used by field arrays.
+*
+* All memory used by FftwDArray<Data> containers, and thus by RField<D>
+* and RFieldDft<D> fields, is obtained from and returned to this pool.
+* Every block is aligned to a 64 byte boundary (the width of a cache
+* line and of an AVX-512 vector register), and has a size that is
+* rounded up to a multiple of 64 bytes. Blocks of equal rounded size
+* form a size class.
+*
+* If the pool is enabled, blocks that are released are kept in a free
+* list for their size class, and are handed out again by later requests
+* for blocks of the same size class, rather than being returned to the
+* system. A typical calculation uses only a few distinct field sizes,
+* so repeated reallocation of fields (e.g., of propagator slices when
+* the contour discretization changes during a sweep) then reuses the 
+* same memory. Cached blocks are only freed by clear() or by disabling
+* the pool. If the pool is disabled (the default), released blocks are
+* freed immediately.
+*
+* The functions in this namespace may be called from within an OpenMP
+* parallel region.
+*/
+namespace FieldPool {
+
+   /**
+   * \defgroup Prdc_Cpu_FieldPool_Module FieldPool
+   *
+   * Pool of aligned memory blocks used by field arrays.
+   *
+   * \ingroup Prdc_Cpu_Module
+   * @{
+   */
+
+   /**
+   * Alignment of every block, in bytes.
+   */
+   const std::size_t alignment = 64;
+
+   /**
+   * Obtain an aligned block of at least nBytes bytes.
+   *
+   * \throw Exception if nBytes == 0 or if memory cannot be allocated.
+   *
+   * \param nBytes  requested size in bytes
+   * \return pointer to a block aligned to a 64 byte boundary
+   */
+   void* allocate(std::size_t nBytes);
+
+   /**
+   * Return a block obtained from allocate() to the pool.
+   *
+   * The value of nBytes must equal that passed to allocate().
+   *
+   * \param ptr  pointer to the block
+   * \param nBytes  size requested when the block was allocated
+   */
+   void release(void* ptr, std::size_t nBytes);
+
+   /**
+   * Enable or disable reuse of released blocks.
+   *
+   * Disabling the pool frees all cached blocks.
+   *
+   * \param enabled  true to enable reuse, false to disable
+   */
+   void setEnabled(bool enabled);
+
+   /**
+   * Is reuse of released blocks enabled?
+   */
+   bool isEnabled();
+
+   /**
+   * Free all cached blocks that are not currently in use.
+   */
+   void clear();
+
+   /**
+   * Get the total number of calls to allocate().
+   */
+   long nAllocate();
+
+   /**
+   * Get the number of calls to allocate() served by a cached block.
+   */
+   long nReuse();
+
+   /**
+   * Get the total size, in bytes, of all cached blocks.
+   */
+   std::size_t cachedBytes();
+
+   /** @} */
+
+} // namespace FieldPool
+} // namespace Pscf::Prdc::Cpu
+} // namespace Pscf::Prdc
+} // namespace Pscf
+#endif
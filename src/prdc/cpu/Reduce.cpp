@@ -0,0 +1,256 @@
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "Reduce.h"
+#include "simd.h"
+
+#include <cmath>
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+namespace Reduce {
+
+// Serial kernels
+// ~~~~~~~~~~~~~~
+//
+// Sums use four independent partial sums, so that the loop can be
+// vectorized without reassociation of floating point additions.
+
+namespace {
+
+   /*
+   * Sum of n array elements.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   Real _sum(Real const * in, int n)
+   {
+      Real s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+      int m = n - n%4;
+      for (int i = 0; i < m; i += 4) {
+         s0 += in[i];
+         s1 += in[i+1];
+         s2 += in[i+2];
+         s3 += in[i+3];
+      }
+      for (int i = m; i < n; ++i) {
+         s0 += in[i];
+      }
+      return (s0 + s1) + (s2 + s3);
+   }
+
+   /*
+   * Inner product of two arrays of n elements.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   Real _innerProduct(Real const * a, Real const * b, int n)
+   {
+      Real s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+      int m = n - n%4;
+      for (int i = 0; i < m; i += 4) {
+         s0 += a[i]*b[i];
+         s1 += a[i+1]*b[i+1];
+         s2 += a[i+2]*b[i+2];
+         s3 += a[i+3]*b[i+3];
+      }
+      for (int i = m; i < n; ++i) {
+         s0 += a[i]*b[i];
+      }
+      return (s0 + s1) + (s2 + s3);
+   }
+
+   /*
+   * Maximum of n > 0 array elements.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   Real _max(Real const * in, int n)
+   {
+      Real m = in[0];
+      for (int i = 1; i < n; ++i) {
+         m = (in[i] > m) ? in[i] : m;
+      }
+      return m;
+   }
+
+   /*
+   * Maximum absolute magnitude of n > 0 array elements.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   Real _maxAbs(Real const * in, int n)
+   {
+      Real m = std::abs(in[0]);
+      Real x;
+      for (int i = 1; i < n; ++i) {
+         x = std::abs(in[i]);
+         m = (x > m) ? x : m;
+      }
+      return m;
+   }
+
+   /*
+   * Minimum of n > 0 array elements.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   Real _min(Real const * in, int n)
+   {
+      Real m = in[0];
+      for (int i = 1; i < n; ++i) {
+         m = (in[i] < m) ? in[i] : m;
+      }
+      return m;
+   }
+
+   /*
+   * Minimum absolute magnitude of n > 0 array elements.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   Real _minAbs(Real const * in, int n)
+   {
+      Real m = std::abs(in[0]);
+      Real x;
+      for (int i = 1; i < n; ++i) {
+         x = std::abs(in[i]);
+         m = (x < m) ? x : m;
+      }
+      return m;
+   }
+
+}
+
+// Wrapper functions
+// ~~~~~~~~~~~~~~~~~
+
+// Compute sum of array elements.
+Real sum(Array<Real> const & in)
+{
+   const int n = in.capacity();
+   Real const * inp = in.cArray();
+   Real result = 0.0;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize) \
+                        reduction(+:result)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      result += _sum(inp + begin, end - begin);
+   }
+   return result;
+}
+
+// Get maximum of array elements.
+Real max(Array<Real> const & in)
+{
+   const int n = in.capacity();
+   UTIL_CHECK(n > 0);
+   Real const * inp = in.cArray();
+   Real result = inp[0];
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize) \
+                        reduction(max:result)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      if (end > begin) {
+         Real m = _max(inp + begin, end - begin);
+         result = (m > result) ? m : result;
+      }
+   }
+   return result;
+}
+
+// Get maximum absolute magnitude of array elements.
+Real maxAbs(Array<Real> const & in)
+{
+   const int n = in.capacity();
+   UTIL_CHECK(n > 0);
+   Real const * inp = in.cArray();
+   Real result = 0.0;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize) \
+                        reduction(max:result)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      if (end > begin) {
+         Real m = _maxAbs(inp + begin, end - begin);
+         result = (m > result) ? m : result;
+      }
+   }
+   return result;
+}
+
+// Get minimum of array elements.
+Real min(Array<Real> const & in)
+{
+   const int n = in.capacity();
+   UTIL_CHECK(n > 0);
+   Real const * inp = in.cArray();
+   Real result = inp[0];
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize) \
+                        reduction(min:result)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      if (end > begin) {
+         Real m = _min(inp + begin, end - begin);
+         result = (m < result) ? m : result;
+      }
+   }
+   return result;
+}
+
+// Get minimum absolute magnitude of array elements.
+Real minAbs(Array<Real> const & in)
+{
+   const int n = in.capacity();
+   UTIL_CHECK(n > 0);
+   Real const * inp = in.cArray();
+   Real result = std::abs(inp[0]);
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize) \
+                        reduction(min:result)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      if (end > begin) {
+         Real m = _minAbs(inp + begin, end - begin);
+         result = (m < result) ? m : result;
+      }
+   }
+   return result;
+}
+
+// Compute inner product of two real arrays.
+Real innerProduct(Array<Real> const & a, Array<Real> const & b)
+{
+   const int n = a.capacity();
+   UTIL_CHECK(b.capacity() >= n);
+   Real const * ap = a.cArray();
+   Real const * bp = b.cArray();
+   Real result = 0.0;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize) \
+                        reduction(+:result)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      result += _innerProduct(ap + begin, bp + begin, end - begin);
+   }
+   return result;
+}
+
+}
+}
+}
+}
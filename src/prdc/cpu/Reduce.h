@@ -0,0 +1,94 @@
+#ifndef PRDC_CPU_REDUCE_H
+#define PRDC_CPU_REDUCE_H
+
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "types.h"
+#include <util/containers/Array.h>
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+   using namespace Util;
+
+/**
+* Functions that perform reductions of real arrays on the CPU.
+*
+* This namespace is the CPU analog of Prdc::Cuda::Reduce, and provides
+* functions with the same names. Each function reduces all elements of
+* one array (or two arrays, for innerProduct) to a single value.
+*
+* Each reduction is performed by a serial kernel, defined in an
+* anonymous namespace in Reduce.cpp, that is compiled for several
+* vector instruction sets (see simd.h). Sums are accumulated in several
+* independent partial sums, which allows the compiler to vectorize the
+* loop without reordering floating point operations. If OpenMP is
+* enabled, arrays with at least Simd::minParallelSize elements are
+* divided among threads, and the results for different threads are
+* combined by an OpenMP reduction. Results of sums may thus differ in
+* the last few bits from those of a simple sequential loop.
+*
+* \ingroup Prdc_Cpu_Module
+* @{
+*/
+namespace Reduce {
+
+/**
+* Compute sum of array elements.
+*
+* \param in  input array
+*/
+Real sum(Array<Real> const & in);
+
+/**
+* Get maximum of array elements.
+*
+* \param in  input array
+*/
+Real max(Array<Real> const & in);
+
+/**
+* Get maximum absolute magnitude of array elements.
+*
+* \param in  input array
+*/
+Real maxAbs(Array<Real> const & in);
+
+/**
+* Get minimum of array elements.
+*
+* \param in  input array
+*/
+Real min(Array<Real> const & in);
+
+/**
+* Get minimum absolute magnitude of array elements.
+*
+* \param in  input array
+*/
+Real minAbs(Array<Real> const & in);
+
+/**
+* Compute inner product of two real arrays.
+*
+* Array b must be at least as long as array a. The sum runs over all
+* elements of array a.
+*
+* \param a  first input array
+* \param b  second input array
+*/
+Real innerProduct(Array<Real> const & a, Array<Real> const & b);
+
+/** @} */
+
+}
+}
+}
+}
+#endif
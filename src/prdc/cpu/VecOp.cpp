@@ -0,0 +1,737 @@
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "VecOp.h"
+#include "simd.h"
+
+#include <cmath>
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+namespace VecOp {
+
+// Serial kernels
+// ~~~~~~~~~~~~~~
+//
+// Kernels operate on raw pointers. Complex arrays are passed as pointers
+// to interleaved (real, imaginary) pairs of Real values.
+
+namespace {
+
+   /*
+   * Vector assignment, a[i] = b[i] (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _eqV(Real* a, Real const * b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b[i];
+      }
+   }
+
+   /*
+   * Vector assignment, a[i] = b[i] (Complex).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _eqVC(Real* a, Real const * b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[2*i] = b[2*i];
+         a[2*i+1] = b[2*i+1];
+      }
+   }
+
+   /*
+   * Vector assignment, a[i] = b (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _eqS(Real* a, Real const b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b;
+      }
+   }
+
+   /*
+   * Vector addition, a[i] = b[i] + c[i] (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addVV(Real* a, Real const * b, Real const * c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b[i] + c[i];
+      }
+   }
+
+   /*
+   * Vector addition, a[i] = b[i] + c (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addVS(Real* a, Real const * b, Real const c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b[i] + c;
+      }
+   }
+
+   /*
+   * Vector subtraction, a[i] = b[i] - c[i] (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _subVV(Real* a, Real const * b, Real const * c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b[i] - c[i];
+      }
+   }
+
+   /*
+   * Vector subtraction, a[i] = b[i] - c (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _subVS(Real* a, Real const * b, Real const c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b[i] - c;
+      }
+   }
+
+   /*
+   * Vector multiplication, a[i] = b[i] * c[i] (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _mulVV(Real* a, Real const * b, Real const * c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b[i] * c[i];
+      }
+   }
+
+   /*
+   * Vector multiplication, a[i] = b[i] * c[i] (mixed, c = real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _mulVVC(Real* a, Real const * b, Real const * c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[2*i] = b[2*i] * c[i];
+         a[2*i+1] = b[2*i+1] * c[i];
+      }
+   }
+
+   /*
+   * Vector multiplication, a[i] = b[i] * c (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _mulVS(Real* a, Real const * b, Real const c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b[i] * c;
+      }
+   }
+
+   /*
+   * Vector multiplication, a[i] = b[i] * c (mixed, c = real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _mulVSC(Real* a, Real const * b, Real const c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[2*i] = b[2*i] * c;
+         a[2*i+1] = b[2*i+1] * c;
+      }
+   }
+
+   /*
+   * Vector division, a[i] = b[i] / c[i] (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _divVV(Real* a, Real const * b, Real const * c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b[i] / c[i];
+      }
+   }
+
+   /*
+   * Vector division, a[i] = b[i] / c (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _divVS(Real* a, Real const * b, Real const c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b[i] / c;
+      }
+   }
+
+   /*
+   * Vector exponentiation, a[i] = exp(b[i]) (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _expV(Real* a, Real const * b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = exp(b[i]);
+      }
+   }
+
+   /*
+   * Vector addition in-place, a[i] += b[i] (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addEqV(Real* a, Real const * b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] += b[i];
+      }
+   }
+
+   /*
+   * Vector addition in-place, a[i] += b (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addEqS(Real* a, Real const b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] += b;
+      }
+   }
+
+   /*
+   * Vector subtraction in-place, a[i] -= b[i] (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _subEqV(Real* a, Real const * b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] -= b[i];
+      }
+   }
+
+   /*
+   * Vector subtraction in-place, a[i] -= b (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _subEqS(Real* a, Real const b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] -= b;
+      }
+   }
+
+   /*
+   * Vector multiplication in-place, a[i] *= b[i] (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _mulEqV(Real* a, Real const * b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] *= b[i];
+      }
+   }
+
+   /*
+   * Vector multiplication in-place, a[i] *= b[i] (mixed, b = real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _mulEqVC(Real* a, Real const * b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[2*i] *= b[i];
+         a[2*i+1] *= b[i];
+      }
+   }
+
+   /*
+   * Vector multiplication in-place, a[i] *= b (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _mulEqS(Real* a, Real const b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] *= b;
+      }
+   }
+
+   /*
+   * Vector multiplication in-place, a[i] *= b (mixed, b = real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _mulEqSC(Real* a, Real const b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[2*i] *= b;
+         a[2*i+1] *= b;
+      }
+   }
+
+   /*
+   * Vector division in-place, a[i] /= b[i] (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _divEqV(Real* a, Real const * b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] /= b[i];
+      }
+   }
+
+   /*
+   * Vector division in-place, a[i] /= b (Real).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _divEqS(Real* a, Real const b, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] /= b;
+      }
+   }
+
+}
+
+// Wrapper functions
+// ~~~~~~~~~~~~~~~~~
+
+// Vector assignment, a[i] = b[i] (Real).
+void eqV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+         const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _eqV(ap + begin, bp + begin, end - begin);
+   }
+}
+
+// Vector assignment, a[i] = b[i] (Complex).
+void eqV(Array<Complex>& a, Array<Complex> const & b,
+         const int beginIdA, const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = reinterpret_cast<Real *>(a.cArray() + beginIdA);
+   Real const * bp = reinterpret_cast<Real const *>(b.cArray() + beginIdB);
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _eqVC(ap + 2*begin, bp + 2*begin, end - begin);
+   }
+}
+
+// Vector assignment, a[i] = b (Real).
+void eqS(Array<Real>& a, Real const b, const int beginIdA, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Real* ap = a.cArray() + beginIdA;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _eqS(ap + begin, b, end - begin);
+   }
+}
+
+// Vector addition, a[i] = b[i] + c[i] (Real).
+void addVV(Array<Real>& a, Array<Real> const & b, Array<Real> const & c,
+           const int beginIdA, const int beginIdB, const int beginIdC,
+           const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Simd::checkSlice(c.capacity(), beginIdC, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   Real const * cp = c.cArray() + beginIdC;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addVV(ap + begin, bp + begin, cp + begin, end - begin);
+   }
+}
+
+// Vector addition, a[i] = b[i] + c (Real).
+void addVS(Array<Real>& a, Array<Real> const & b, Real const c,
+           const int beginIdA, const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addVS(ap + begin, bp + begin, c, end - begin);
+   }
+}
+
+// Vector subtraction, a[i] = b[i] - c[i] (Real).
+void subVV(Array<Real>& a, Array<Real> const & b, Array<Real> const & c,
+           const int beginIdA, const int beginIdB, const int beginIdC,
+           const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Simd::checkSlice(c.capacity(), beginIdC, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   Real const * cp = c.cArray() + beginIdC;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _subVV(ap + begin, bp + begin, cp + begin, end - begin);
+   }
+}
+
+// Vector subtraction, a[i] = b[i] - c (Real).
+void subVS(Array<Real>& a, Array<Real> const & b, Real const c,
+           const int beginIdA, const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _subVS(ap + begin, bp + begin, c, end - begin);
+   }
+}
+
+// Vector multiplication, a[i] = b[i] * c[i] (Real).
+void mulVV(Array<Real>& a, Array<Real> const & b, Array<Real> const & c,
+           const int beginIdA, const int beginIdB, const int beginIdC,
+           const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Simd::checkSlice(c.capacity(), beginIdC, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   Real const * cp = c.cArray() + beginIdC;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _mulVV(ap + begin, bp + begin, cp + begin, end - begin);
+   }
+}
+
+// Vector multiplication, a[i] = b[i] * c[i] (mixed, c = real).
+void mulVV(Array<Complex>& a, Array<Complex> const & b,
+           Array<Real> const & c, const int beginIdA,
+           const int beginIdB, const int beginIdC, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Simd::checkSlice(c.capacity(), beginIdC, n);
+   Real* ap = reinterpret_cast<Real *>(a.cArray() + beginIdA);
+   Real const * bp = reinterpret_cast<Real const *>(b.cArray() + beginIdB);
+   Real const * cp = c.cArray() + beginIdC;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _mulVVC(ap + 2*begin, bp + 2*begin, cp + begin, end - begin);
+   }
+}
+
+// Vector multiplication, a[i] = b[i] * c (Real).
+void mulVS(Array<Real>& a, Array<Real> const & b, Real const c,
+           const int beginIdA, const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _mulVS(ap + begin, bp + begin, c, end - begin);
+   }
+}
+
+// Vector multiplication, a[i] = b[i] * c (mixed, c = real).
+void mulVS(Array<Complex>& a, Array<Complex> const & b, Real const c,
+           const int beginIdA, const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = reinterpret_cast<Real *>(a.cArray() + beginIdA);
+   Real const * bp = reinterpret_cast<Real const *>(b.cArray() + beginIdB);
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _mulVSC(ap + 2*begin, bp + 2*begin, c, end - begin);
+   }
+}
+
+// Vector division, a[i] = b[i] / c[i] (Real).
+void divVV(Array<Real>& a, Array<Real> const & b, Array<Real> const & c,
+           const int beginIdA, const int beginIdB, const int beginIdC,
+           const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Simd::checkSlice(c.capacity(), beginIdC, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   Real const * cp = c.cArray() + beginIdC;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _divVV(ap + begin, bp + begin, cp + begin, end - begin);
+   }
+}
+
+// Vector division, a[i] = b[i] / c (Real).
+void divVS(Array<Real>& a, Array<Real> const & b, Real const c,
+           const int beginIdA, const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _divVS(ap + begin, bp + begin, c, end - begin);
+   }
+}
+
+// Vector exponentiation, a[i] = exp(b[i]) (Real).
+void expV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+          const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _expV(ap + begin, bp + begin, end - begin);
+   }
+}
+
+// Vector addition in-place, a[i] += b[i] (Real).
+void addEqV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+            const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addEqV(ap + begin, bp + begin, end - begin);
+   }
+}
+
+// Vector addition in-place, a[i] += b (Real).
+void addEqS(Array<Real>& a, Real const b, const int beginIdA,
+            const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Real* ap = a.cArray() + beginIdA;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addEqS(ap + begin, b, end - begin);
+   }
+}
+
+// Vector subtraction in-place, a[i] -= b[i] (Real).
+void subEqV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+            const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _subEqV(ap + begin, bp + begin, end - begin);
+   }
+}
+
+// Vector subtraction in-place, a[i] -= b (Real).
+void subEqS(Array<Real>& a, Real const b, const int beginIdA,
+            const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Real* ap = a.cArray() + beginIdA;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _subEqS(ap + begin, b, end - begin);
+   }
+}
+
+// Vector multiplication in-place, a[i] *= b[i] (Real).
+void mulEqV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+            const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _mulEqV(ap + begin, bp + begin, end - begin);
+   }
+}
+
+// Vector multiplication in-place, a[i] *= b[i] (mixed, b = real).
+void mulEqV(Array<Complex>& a, Array<Real> const & b,
+            const int beginIdA, const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = reinterpret_cast<Real *>(a.cArray() + beginIdA);
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _mulEqVC(ap + 2*begin, bp + begin, end - begin);
+   }
+}
+
+// Vector multiplication in-place, a[i] *= b (Real).
+void mulEqS(Array<Real>& a, Real const b, const int beginIdA,
+            const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Real* ap = a.cArray() + beginIdA;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _mulEqS(ap + begin, b, end - begin);
+   }
+}
+
+// Vector multiplication in-place, a[i] *= b (mixed, b = real).
+void mulEqS(Array<Complex>& a, Real const b, const int beginIdA,
+            const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Real* ap = reinterpret_cast<Real *>(a.cArray() + beginIdA);
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _mulEqSC(ap + 2*begin, b, end - begin);
+   }
+}
+
+// Vector division in-place, a[i] /= b[i] (Real).
+void divEqV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+            const int beginIdB, const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Simd::checkSlice(b.capacity(), beginIdB, n);
+   Real* ap = a.cArray() + beginIdA;
+   Real const * bp = b.cArray() + beginIdB;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _divEqV(ap + begin, bp + begin, end - begin);
+   }
+}
+
+// Vector division in-place, a[i] /= b (Real).
+void divEqS(Array<Real>& a, Real const b, const int beginIdA,
+            const int n)
+{
+   Simd::checkSlice(a.capacity(), beginIdA, n);
+   Real* ap = a.cArray() + beginIdA;
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _divEqS(ap + begin, b, end - begin);
+   }
+}
+
+} // namespace VecOp
+} // namespace Cpu
+} // namespace Prdc
+} // namespace Pscf
@@ -0,0 +1,616 @@
+#ifndef PRDC_CPU_VEC_OP_H
+#define PRDC_CPU_VEC_OP_H
+
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "types.h"
+#include <util/containers/Array.h>
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+   using namespace Util;
+
+/**
+* Functions that perform element-wise vector operations on the CPU.
+*
+* This namespace is the CPU analog of Prdc::Cuda::VecOp, and uses the
+* same function names and argument conventions. The functions operate
+* on Array<Real> or Array<Complex> containers (e.g., RField, RFieldDft
+* or CField objects), with the output (the LHS of the operation) as the
+* first parameter. Names begin with "eq", "add", "sub", "mul", "div" or
+* "exp" to indicate the operation, or with "addEq", "subEq", "mulEq" or
+* "divEq" for compound assignment operations. Each input argument is a
+* vector (V) or a scalar (S), and vectors are listed before scalars.
+* Complex arrays may be multiplied by real vectors or scalars.
+*
+* Two functions are provided for each operation:
+* - The first accepts only the output array and inputs. Each input
+*   array must be at least as long as the output array, and the
+*   operation is performed for every element of the output array.
+* - The second operates on slices of the arrays, and takes one index
+*   for each array, giving the first element of its slice, and the
+*   slice size n. The slices are checked against array capacities.
+*
+* Each function is implemented by a serial kernel, defined in an
+* anonymous namespace in VecOp.cpp, that is written as a simple loop
+* over raw pointers so that it can be vectorized by the compiler. On
+* x86-64 Linux systems compiled with GCC, each kernel is compiled for
+* the AVX-512, AVX2 and baseline instruction sets, and the best version
+* supported by the processor is selected at load time (see simd.h).
+* If OpenMP is enabled, arrays with at least Simd::minParallelSize
+* elements are divided among threads in contiguous chunks.
+*
+* Additional functions that combine several operations in one pass are
+* declared in VecOpMisc.h, which is included at the end of this file.
+*
+* \ingroup Prdc_Cpu_Module
+* @{
+*/
+namespace VecOp {
+
+// Assignment operations:
+// ~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+* Vector assignment, a[i] = b[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void eqV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+         const int beginIdB, const int n);
+
+/**
+* Vector assignment, a[i] = b[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+*/
+inline void eqV(Array<Real>& a, Array<Real> const & b)
+{  eqV(a, b, 0, 0, a.capacity()); }
+
+/**
+* Vector assignment, a[i] = b[i] (Complex).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void eqV(Array<Complex>& a, Array<Complex> const & b, const int beginIdA,
+         const int beginIdB, const int n);
+
+/**
+* Vector assignment, a[i] = b[i] (Complex).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+*/
+inline void eqV(Array<Complex>& a, Array<Complex> const & b)
+{  eqV(a, b, 0, 0, a.capacity()); }
+
+/**
+* Vector assignment, a[i] = b (Real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param n  the number of entries to evaluate
+*/
+void eqS(Array<Real>& a, Real const b, const int beginIdA, const int n);
+
+/**
+* Vector assignment, a[i] = b (Real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+*/
+inline void eqS(Array<Real>& a, Real const b)
+{  eqS(a, b, 0, a.capacity()); }
+
+// Addition operations:
+// ~~~~~~~~~~~~~~~~~~~~
+
+/**
+* Vector addition, a[i] = b[i] + c[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param beginIdC  index of the first entry to evaluate in array c
+* \param n  the number of entries to evaluate
+*/
+void addVV(Array<Real>& a, Array<Real> const & b, Array<Real> const & c,
+           const int beginIdA, const int beginIdB, const int beginIdC,
+           const int n);
+
+/**
+* Vector addition, a[i] = b[i] + c[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+*/
+inline void addVV(Array<Real>& a, Array<Real> const & b,
+                  Array<Real> const & c)
+{  addVV(a, b, c, 0, 0, 0, a.capacity()); }
+
+/**
+* Vector addition, a[i] = b[i] + c (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void addVS(Array<Real>& a, Array<Real> const & b, Real const c,
+           const int beginIdA, const int beginIdB, const int n);
+
+/**
+* Vector addition, a[i] = b[i] + c (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar (RHS)
+*/
+inline void addVS(Array<Real>& a, Array<Real> const & b, Real const c)
+{  addVS(a, b, c, 0, 0, a.capacity()); }
+
+// Subtraction operations:
+// ~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+* Vector subtraction, a[i] = b[i] - c[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param beginIdC  index of the first entry to evaluate in array c
+* \param n  the number of entries to evaluate
+*/
+void subVV(Array<Real>& a, Array<Real> const & b, Array<Real> const & c,
+           const int beginIdA, const int beginIdB, const int beginIdC,
+           const int n);
+
+/**
+* Vector subtraction, a[i] = b[i] - c[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+*/
+inline void subVV(Array<Real>& a, Array<Real> const & b,
+                  Array<Real> const & c)
+{  subVV(a, b, c, 0, 0, 0, a.capacity()); }
+
+/**
+* Vector subtraction, a[i] = b[i] - c (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void subVS(Array<Real>& a, Array<Real> const & b, Real const c,
+           const int beginIdA, const int beginIdB, const int n);
+
+/**
+* Vector subtraction, a[i] = b[i] - c (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar (RHS)
+*/
+inline void subVS(Array<Real>& a, Array<Real> const & b, Real const c)
+{  subVS(a, b, c, 0, 0, a.capacity()); }
+
+// Multiplication operations:
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+* Vector multiplication, a[i] = b[i] * c[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param beginIdC  index of the first entry to evaluate in array c
+* \param n  the number of entries to evaluate
+*/
+void mulVV(Array<Real>& a, Array<Real> const & b, Array<Real> const & c,
+           const int beginIdA, const int beginIdB, const int beginIdC,
+           const int n);
+
+/**
+* Vector multiplication, a[i] = b[i] * c[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+*/
+inline void mulVV(Array<Real>& a, Array<Real> const & b,
+                  Array<Real> const & c)
+{  mulVV(a, b, c, 0, 0, 0, a.capacity()); }
+
+/**
+* Vector multiplication, a[i] = b[i] * c[i] (mixed, c = real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param beginIdC  index of the first entry to evaluate in array c
+* \param n  the number of entries to evaluate
+*/
+void mulVV(Array<Complex>& a, Array<Complex> const & b,
+           Array<Real> const & c, const int beginIdA, const int beginIdB,
+           const int beginIdC, const int n);
+
+/**
+* Vector multiplication, a[i] = b[i] * c[i] (mixed, c = real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+*/
+inline void mulVV(Array<Complex>& a, Array<Complex> const & b,
+                  Array<Real> const & c)
+{  mulVV(a, b, c, 0, 0, 0, a.capacity()); }
+
+/**
+* Vector multiplication, a[i] = b[i] * c (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void mulVS(Array<Real>& a, Array<Real> const & b, Real const c,
+           const int beginIdA, const int beginIdB, const int n);
+
+/**
+* Vector multiplication, a[i] = b[i] * c (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar (RHS)
+*/
+inline void mulVS(Array<Real>& a, Array<Real> const & b, Real const c)
+{  mulVS(a, b, c, 0, 0, a.capacity()); }
+
+/**
+* Vector multiplication, a[i] = b[i] * c (mixed, c = real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void mulVS(Array<Complex>& a, Array<Complex> const & b, Real const c,
+           const int beginIdA, const int beginIdB, const int n);
+
+/**
+* Vector multiplication, a[i] = b[i] * c (mixed, c = real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar (RHS)
+*/
+inline void mulVS(Array<Complex>& a, Array<Complex> const & b, Real const c)
+{  mulVS(a, b, c, 0, 0, a.capacity()); }
+
+// Division operations:
+// ~~~~~~~~~~~~~~~~~~~~
+
+/**
+* Vector division, a[i] = b[i] / c[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param beginIdC  index of the first entry to evaluate in array c
+* \param n  the number of entries to evaluate
+*/
+void divVV(Array<Real>& a, Array<Real> const & b, Array<Real> const & c,
+           const int beginIdA, const int beginIdB, const int beginIdC,
+           const int n);
+
+/**
+* Vector division, a[i] = b[i] / c[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+*/
+inline void divVV(Array<Real>& a, Array<Real> const & b,
+                  Array<Real> const & c)
+{  divVV(a, b, c, 0, 0, 0, a.capacity()); }
+
+/**
+* Vector division, a[i] = b[i] / c (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void divVS(Array<Real>& a, Array<Real> const & b, Real const c,
+           const int beginIdA, const int beginIdB, const int n);
+
+/**
+* Vector division, a[i] = b[i] / c (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar (RHS)
+*/
+inline void divVS(Array<Real>& a, Array<Real> const & b, Real const c)
+{  divVS(a, b, c, 0, 0, a.capacity()); }
+
+// Exponentiation operations:
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+* Vector exponentiation, a[i] = exp(b[i]) (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void expV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+          const int beginIdB, const int n);
+
+/**
+* Vector exponentiation, a[i] = exp(b[i]) (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+*/
+inline void expV(Array<Real>& a, Array<Real> const & b)
+{  expV(a, b, 0, 0, a.capacity()); }
+
+// Compound assignment operations:
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+* Vector addition in-place, a[i] += b[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void addEqV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+            const int beginIdB, const int n);
+
+/**
+* Vector addition in-place, a[i] += b[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+*/
+inline void addEqV(Array<Real>& a, Array<Real> const & b)
+{  addEqV(a, b, 0, 0, a.capacity()); }
+
+/**
+* Vector addition in-place, a[i] += b (Real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param n  the number of entries to evaluate
+*/
+void addEqS(Array<Real>& a, Real const b, const int beginIdA, const int n);
+
+/**
+* Vector addition in-place, a[i] += b (Real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+*/
+inline void addEqS(Array<Real>& a, Real const b)
+{  addEqS(a, b, 0, a.capacity()); }
+
+/**
+* Vector subtraction in-place, a[i] -= b[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void subEqV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+            const int beginIdB, const int n);
+
+/**
+* Vector subtraction in-place, a[i] -= b[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+*/
+inline void subEqV(Array<Real>& a, Array<Real> const & b)
+{  subEqV(a, b, 0, 0, a.capacity()); }
+
+/**
+* Vector subtraction in-place, a[i] -= b (Real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param n  the number of entries to evaluate
+*/
+void subEqS(Array<Real>& a, Real const b, const int beginIdA, const int n);
+
+/**
+* Vector subtraction in-place, a[i] -= b (Real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+*/
+inline void subEqS(Array<Real>& a, Real const b)
+{  subEqS(a, b, 0, a.capacity()); }
+
+/**
+* Vector multiplication in-place, a[i] *= b[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void mulEqV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+            const int beginIdB, const int n);
+
+/**
+* Vector multiplication in-place, a[i] *= b[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+*/
+inline void mulEqV(Array<Real>& a, Array<Real> const & b)
+{  mulEqV(a, b, 0, 0, a.capacity()); }
+
+/**
+* Vector multiplication in-place, a[i] *= b[i] (mixed, b = real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void mulEqV(Array<Complex>& a, Array<Real> const & b, const int beginIdA,
+            const int beginIdB, const int n);
+
+/**
+* Vector multiplication in-place, a[i] *= b[i] (mixed, b = real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+*/
+inline void mulEqV(Array<Complex>& a, Array<Real> const & b)
+{  mulEqV(a, b, 0, 0, a.capacity()); }
+
+/**
+* Vector multiplication in-place, a[i] *= b (Real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param n  the number of entries to evaluate
+*/
+void mulEqS(Array<Real>& a, Real const b, const int beginIdA, const int n);
+
+/**
+* Vector multiplication in-place, a[i] *= b (Real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+*/
+inline void mulEqS(Array<Real>& a, Real const b)
+{  mulEqS(a, b, 0, a.capacity()); }
+
+/**
+* Vector multiplication in-place, a[i] *= b (mixed, b = real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param n  the number of entries to evaluate
+*/
+void mulEqS(Array<Complex>& a, Real const b, const int beginIdA,
+            const int n);
+
+/**
+* Vector multiplication in-place, a[i] *= b (mixed, b = real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+*/
+inline void mulEqS(Array<Complex>& a, Real const b)
+{  mulEqS(a, b, 0, a.capacity()); }
+
+/**
+* Vector division in-place, a[i] /= b[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param beginIdB  index of the first entry to evaluate in array b
+* \param n  the number of entries to evaluate
+*/
+void divEqV(Array<Real>& a, Array<Real> const & b, const int beginIdA,
+            const int beginIdB, const int n);
+
+/**
+* Vector division in-place, a[i] /= b[i] (Real).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+*/
+inline void divEqV(Array<Real>& a, Array<Real> const & b)
+{  divEqV(a, b, 0, 0, a.capacity()); }
+
+/**
+* Vector division in-place, a[i] /= b (Real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+* \param beginIdA  index of the first entry to evaluate in array a
+* \param n  the number of entries to evaluate
+*/
+void divEqS(Array<Real>& a, Real const b, const int beginIdA, const int n);
+
+/**
+* Vector division in-place, a[i] /= b (Real).
+*
+* \param a  output array (LHS)
+* \param b  input scalar (RHS)
+*/
+inline void divEqS(Array<Real>& a, Real const b)
+{  divEqS(a, b, 0, a.capacity()); }
+
+/** @} */
+
+} // namespace VecOp
+} // namespace Cpu
+} // namespace Prdc
+} // namespace Pscf
+
+#include "VecOpMisc.h" // Ensure that if VecOp is included, so is VecOpMisc
+
+#endif
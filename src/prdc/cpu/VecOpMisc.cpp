@@ -0,0 +1,336 @@
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "VecOpMisc.h"
+#include "simd.h"
+
+#include <cmath>
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+namespace VecOp {
+
+// Serial kernels
+// ~~~~~~~~~~~~~~
+
+namespace {
+
+   /*
+   * Vector addition w/ coefficient, a[i] = (b[i]*c) + (d[i]*e).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addVcVc(Real* a, Real const * b, Real const c, Real const * d,
+                 Real const e, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = (b[i] * c) + (d[i] * e);
+      }
+   }
+
+   /*
+   * 3-vector add. w/ coeff, a[i] = (b[i]*c) + (d[i]*e) + (f[i]*g).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addVcVcVc(Real* a, Real const * b, Real const c, Real const * d,
+                   Real const e, Real const * f, Real const g, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = (b[i] * c) + (d[i] * e) + (f[i] * g);
+      }
+   }
+
+   /*
+   * Vector addition w/ coeffs and shift, a[i] = b[i]*c + d[i]*e + f.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addVcVcS(Real* a, Real const * b, Real const c, Real const * d,
+                  Real const e, Real const f, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = (b[i] * c) + (d[i] * e) + f;
+      }
+   }
+
+   /*
+   * Vector addition in-place w/ coefficient, a[i] += b[i] * c.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addEqVc(Real* a, Real const * b, Real const c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] += b[i] * c;
+      }
+   }
+
+   /*
+   * Product addition in-place w/ coefficient, a[i] += b[i]*c[i]*d.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addEqVVc(Real* a, Real const * b, Real const * c, Real const d,
+                  int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] += b[i] * c[i] * d;
+      }
+   }
+
+   /*
+   * Vector subtraction, a[i] = b[i] - c[i] - d.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _subVVS(Real* a, Real const * b, Real const * c, Real const d,
+                int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = b[i] - c[i] - d;
+      }
+   }
+
+   /*
+   * Vector exponentiation w/ coefficient, a[i] = exp(b[i]*c).
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _expVc(Real* a, Real const * b, Real const c, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = exp(b[i] * c);
+      }
+   }
+
+   /*
+   * Sum of 2 products w/ coeffs, a[i] = b[i]*c[i]*d + e[i]*f[i]*g.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addVVcVVc(Real* a, Real const * b, Real const * c, Real const d,
+                   Real const * e, Real const * f, Real const g, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = (b[i] * c[i] * d) + (e[i] * f[i] * g);
+      }
+   }
+
+   /*
+   * Sum of 3 products w/ coeffs, a[i] = b[i]*c[i]*d + ... + h[i]*p[i]*q.
+   */
+   PRDC_CPU_SIMD_TARGETS
+   void _addVVcVVcVVc(Real* a, Real const * b, Real const * c,
+                      Real const d, Real const * e, Real const * f,
+                      Real const g, Real const * h, Real const * p,
+                      Real const q, int n)
+   {
+      for (int i = 0; i < n; ++i) {
+         a[i] = (b[i] * c[i] * d) + (e[i] * f[i] * g)
+              + (h[i] * p[i] * q);
+      }
+   }
+
+}
+
+// Wrapper functions
+// ~~~~~~~~~~~~~~~~~
+
+// Vector addition w/ coefficient, a[i] = (b[i]*c) + (d[i]*e).
+void addVcVc(Array<Real>& a, Array<Real> const & b, Real const c,
+             Array<Real> const & d, Real const e)
+{
+   const int n = a.capacity();
+   UTIL_CHECK(b.capacity() >= n);
+   UTIL_CHECK(d.capacity() >= n);
+   Real* ap = a.cArray();
+   Real const * bp = b.cArray();
+   Real const * dp = d.cArray();
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addVcVc(ap + begin, bp + begin, c, dp + begin, e, end - begin);
+   }
+}
+
+// 3-vector add. w/ coeff, a[i] = (b[i]*c) + (d[i]*e) + (f[i]*g).
+void addVcVcVc(Array<Real>& a, Array<Real> const & b, Real const c,
+               Array<Real> const & d, Real const e, Array<Real> const & f,
+               Real const g)
+{
+   const int n = a.capacity();
+   UTIL_CHECK(b.capacity() >= n);
+   UTIL_CHECK(d.capacity() >= n);
+   UTIL_CHECK(f.capacity() >= n);
+   Real* ap = a.cArray();
+   Real const * bp = b.cArray();
+   Real const * dp = d.cArray();
+   Real const * fp = f.cArray();
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addVcVcVc(ap + begin, bp + begin, c, dp + begin, e, fp + begin, g,
+                 end - begin);
+   }
+}
+
+// Vector addition w/ coeffs and shift, a[i] = b[i]*c + d[i]*e + f.
+void addVcVcS(Array<Real>& a, Array<Real> const & b, Real const c,
+              Array<Real> const & d, Real const e, Real const f)
+{
+   const int n = a.capacity();
+   UTIL_CHECK(b.capacity() >= n);
+   UTIL_CHECK(d.capacity() >= n);
+   Real* ap = a.cArray();
+   Real const * bp = b.cArray();
+   Real const * dp = d.cArray();
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addVcVcS(ap + begin, bp + begin, c, dp + begin, e, f, end - begin);
+   }
+}
+
+// Vector addition in-place w/ coefficient, a[i] += b[i] * c.
+void addEqVc(Array<Real>& a, Array<Real> const & b, Real const c)
+{
+   const int n = a.capacity();
+   UTIL_CHECK(b.capacity() >= n);
+   Real* ap = a.cArray();
+   Real const * bp = b.cArray();
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addEqVc(ap + begin, bp + begin, c, end - begin);
+   }
+}
+
+// Product addition in-place w/ coefficient, a[i] += b[i]*c[i]*d.
+void addEqVVc(Array<Real>& a, Array<Real> const & b, Array<Real> const & c,
+              Real const d)
+{
+   const int n = a.capacity();
+   UTIL_CHECK(b.capacity() >= n);
+   UTIL_CHECK(c.capacity() >= n);
+   Real* ap = a.cArray();
+   Real const * bp = b.cArray();
+   Real const * cp = c.cArray();
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addEqVVc(ap + begin, bp + begin, cp + begin, d, end - begin);
+   }
+}
+
+// Vector subtraction, a[i] = b[i] - c[i] - d.
+void subVVS(Array<Real>& a, Array<Real> const & b, Array<Real> const & c,
+            Real const d)
+{
+   const int n = a.capacity();
+   UTIL_CHECK(b.capacity() >= n);
+   UTIL_CHECK(c.capacity() >= n);
+   Real* ap = a.cArray();
+   Real const * bp = b.cArray();
+   Real const * cp = c.cArray();
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _subVVS(ap + begin, bp + begin, cp + begin, d, end - begin);
+   }
+}
+
+// Vector exponentiation w/ coefficient, a[i] = exp(b[i]*c).
+void expVc(Array<Real>& a, Array<Real> const & b, Real const c)
+{
+   const int n = a.capacity();
+   UTIL_CHECK(b.capacity() >= n);
+   Real* ap = a.cArray();
+   Real const * bp = b.cArray();
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _expVc(ap + begin, bp + begin, c, end - begin);
+   }
+}
+
+// Sum of 2 products w/ coeffs, a[i] = b[i]*c[i]*d + e[i]*f[i]*g.
+void addVVcVVc(Array<Real>& a, Array<Real> const & b,
+               Array<Real> const & c, Real const d, Array<Real> const & e,
+               Array<Real> const & f, Real const g)
+{
+   const int n = a.capacity();
+   UTIL_CHECK(b.capacity() >= n);
+   UTIL_CHECK(c.capacity() >= n);
+   UTIL_CHECK(e.capacity() >= n);
+   UTIL_CHECK(f.capacity() >= n);
+   Real* ap = a.cArray();
+   Real const * bp = b.cArray();
+   Real const * cp = c.cArray();
+   Real const * ep = e.cArray();
+   Real const * fp = f.cArray();
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addVVcVVc(ap + begin, bp + begin, cp + begin, d, ep + begin,
+                 fp + begin, g, end - begin);
+   }
+}
+
+// Sum of 3 products w/ coeffs, a[i] = b[i]*c[i]*d + ... + h[i]*p[i]*q.
+void addVVcVVcVVc(Array<Real>& a, Array<Real> const & b,
+                  Array<Real> const & c, Real const d,
+                  Array<Real> const & e, Array<Real> const & f,
+                  Real const g, Array<Real> const & h,
+                  Array<Real> const & p, Real const q)
+{
+   const int n = a.capacity();
+   UTIL_CHECK(b.capacity() >= n);
+   UTIL_CHECK(c.capacity() >= n);
+   UTIL_CHECK(e.capacity() >= n);
+   UTIL_CHECK(f.capacity() >= n);
+   UTIL_CHECK(h.capacity() >= n);
+   UTIL_CHECK(p.capacity() >= n);
+   Real* ap = a.cArray();
+   Real const * bp = b.cArray();
+   Real const * cp = c.cArray();
+   Real const * ep = e.cArray();
+   Real const * fp = f.cArray();
+   Real const * hp = h.cArray();
+   Real const * pp = p.cArray();
+   #ifdef PSCF_OPENMP
+   #pragma omp parallel if (n >= Simd::minParallelSize)
+   #endif
+   {
+      int begin, end;
+      Simd::threadRange(n, begin, end);
+      _addVVcVVcVVc(ap + begin, bp + begin, cp + begin, d, ep + begin,
+                    fp + begin, g, hp + begin, pp + begin, q, end - begin);
+   }
+}
+
+} // namespace VecOp
+} // namespace Cpu
+} // namespace Prdc
+} // namespace Pscf
@@ -0,0 +1,174 @@
+#ifndef PRDC_CPU_VEC_OP_MISC_H
+#define PRDC_CPU_VEC_OP_MISC_H
+
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "types.h"
+#include <util/containers/Array.h>
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+   using namespace Util;
+
+namespace VecOp {
+
+/*
+* Miscellaneous element-wise vector operations performed on the CPU.
+*
+* Note: this file is included at the end of VecOp.h, so any file that
+* includes VecOp.h will also include this file.
+*
+* The functions defined in this file combine 2 or more element-wise
+* vector operations into a single pass over memory, which is faster
+* than consecutively calling several of the functions in VecOp.h for
+* the memory-bound loops that dominate most field operations. These
+* functions are not intended to be comprehensive. Rather, they are
+* written and included as needed during the development of other code.
+*
+* The names of these functions follow the same conventions as those in
+* VecOp, and as those in Cuda::VecOpMisc. V denotes a vector, S denotes
+* a scalar, and Vc denotes a vector that is multiplied by a scalar
+* coefficient and then used in another operation. For example,
+* addEqVc(a, b, c) performs a[i] += b[i] * c for all i. Each input
+* array must be at least as long as the output array a.
+*/
+
+// Functions that combine multiple VecOp operations
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/**
+* Vector addition w/ coefficient, a[i] = (b[i]*c) + (d[i]*e).
+*
+* \param a  output array (LHS)
+* \param b  input array 1 (RHS)
+* \param c  input scalar 1 (RHS)
+* \param d  input array 2 (RHS)
+* \param e  input scalar 2 (RHS)
+*/
+void addVcVc(Array<Real>& a,
+             Array<Real> const & b, Real const c,
+             Array<Real> const & d, Real const e);
+
+/**
+* 3-vec addition w coeff, a[i] = (b[i]*c) + (d[i]*e) + (f[i]*g).
+*
+* \param a  output array (LHS)
+* \param b  input array 1 (RHS)
+* \param c  input scalar 1 (RHS)
+* \param d  input array 2 (RHS)
+* \param e  input scalar 2 (RHS)
+* \param f  input array 3 (RHS)
+* \param g  input scalar 3 (RHS)
+*/
+void addVcVcVc(Array<Real>& a,
+               Array<Real> const & b, Real const c,
+               Array<Real> const & d, Real const e,
+               Array<Real> const & f, Real const g);
+
+/**
+* Vector addition w/ coefficients and shift, a[i] = b[i]*c + d[i]*e + f.
+*
+* \param a  output array (LHS)
+* \param b  input array 1 (RHS)
+* \param c  input scalar 1 (RHS)
+* \param d  input array 2 (RHS)
+* \param e  input scalar 2 (RHS)
+* \param f  input scalar 3 (RHS)
+*/
+void addVcVcS(Array<Real>& a,
+              Array<Real> const & b, Real const c,
+              Array<Real> const & d, Real const e,
+              Real const f);
+
+/**
+* Vector addition in-place w/ coefficient, a[i] += b[i] * c.
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar
+*/
+void addEqVc(Array<Real>& a, Array<Real> const & b, Real const c);
+
+/**
+* Product addition in-place w/ coefficient, a[i] += b[i] * c[i] * d.
+*
+* \param a  output array (LHS)
+* \param b  input array 1 (RHS)
+* \param c  input array 2 (RHS)
+* \param d  input scalar (RHS)
+*/
+void addEqVVc(Array<Real>& a, Array<Real> const & b,
+              Array<Real> const & c, Real const d);
+
+/**
+* Vector subtraction, a[i] = b[i] - c[i] - d.
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input array (RHS)
+* \param d  input scalar (RHS)
+*/
+void subVVS(Array<Real>& a, Array<Real> const & b,
+            Array<Real> const & c, Real const d);
+
+/**
+* Vector exponentiation w/ coefficient, a[i] = exp(b[i]*c).
+*
+* \param a  output array (LHS)
+* \param b  input array (RHS)
+* \param c  input scalar
+*/
+void expVc(Array<Real>& a, Array<Real> const & b, Real const c);
+
+/**
+* Sum of 2 products w/ coeffs, a[i] = b[i]*c[i]*d + e[i]*f[i]*g.
+*
+* \param a  output array (LHS)
+* \param b  input array 1 (RHS)
+* \param c  input array 2 (RHS)
+* \param d  input scalar 1 (RHS)
+* \param e  input array 3 (RHS)
+* \param f  input array 4 (RHS)
+* \param g  input scalar 2 (RHS)
+*/
+void addVVcVVc(Array<Real>& a,
+               Array<Real> const & b, Array<Real> const & c, Real const d,
+               Array<Real> const & e, Array<Real> const & f, Real const g);
+
+/**
+* Sum of 3 products w/ coeffs, a[i] = b[i]*c[i]*d + e[i]*f[i]*g + ...
+*
+* Computes a[i] = b[i]*c[i]*d + e[i]*f[i]*g + h[i]*p[i]*q.
+*
+* \param a  output array (LHS)
+* \param b  input array 1 (RHS)
+* \param c  input array 2 (RHS)
+* \param d  input scalar 1 (RHS)
+* \param e  input array 3 (RHS)
+* \param f  input array 4 (RHS)
+* \param g  input scalar 2 (RHS)
+* \param h  input array 5 (RHS)
+* \param p  input array 6 (RHS)
+* \param q  input scalar 3 (RHS)
+*/
+void addVVcVVcVVc(Array<Real>& a,
+                  Array<Real> const & b, Array<Real> const & c,
+                  Real const d,
+                  Array<Real> const & e, Array<Real> const & f,
+                  Real const g,
+                  Array<Real> const & h, Array<Real> const & p,
+                  Real const q);
+
+} // namespace VecOp
+} // namespace Cpu
+} // namespace Prdc
+} // namespace Pscf
+
+#endif
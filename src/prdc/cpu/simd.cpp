@@ -0,0 +1,59 @@
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "simd.h"
+
+#ifdef PSCF_OPENMP
+#include <omp.h>
+#endif
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+namespace Simd {
+
+   /*
+   * Get the widest vector instruction set supported at run time.
+   */
+   char const * instructionSet()
+   {
+      #if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) \
+          && defined(__linux__) && !defined(PSCF_NO_TARGET_CLONES)
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512f")) return "avx512f";
+      if (__builtin_cpu_supports("avx2")) return "avx2";
+      #endif
+      return "default";
+   }
+
+   /*
+   * Get the subrange of [0, n) assigned to the calling thread.
+   */
+   void threadRange(int n, int& begin, int& end)
+   {
+      #ifdef PSCF_OPENMP
+      int nThread = omp_get_num_threads();
+      int threadId = omp_get_thread_num();
+      int chunk = n/nThread;
+      int remainder = n%nThread;
+      if (threadId < remainder) {
+         begin = threadId*(chunk + 1);
+         end = begin + chunk + 1;
+      } else {
+         begin = remainder*(chunk + 1) + (threadId - remainder)*chunk;
+         end = begin + chunk;
+      }
+      #else
+      begin = 0;
+      end = n;
+      #endif
+   }
+
+}
+}
+}
+}
@@ -0,0 +1,87 @@
+#ifndef PRDC_CPU_SIMD_H
+#define PRDC_CPU_SIMD_H
+
+/*
+* PSCF Package
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/global.h>
+
+/*
+* Attribute used to compile a serial kernel function for several vector
+* instruction sets, with selection of the best supported version when
+* the program is loaded (GCC function multi-versioning). Kernels are
+* otherwise compiled once, for the instruction set selected by compiler
+* options. Runtime dispatch may be disabled by defining the macro
+* PSCF_NO_TARGET_CLONES.
+*/
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) \
+    && defined(__linux__) && !defined(PSCF_NO_TARGET_CLONES)
+#define PRDC_CPU_SIMD_TARGETS \
+        __attribute__((target_clones("avx512f","avx2","default")))
+#else
+#define PRDC_CPU_SIMD_TARGETS
+#endif
+
+namespace Pscf {
+namespace Prdc {
+namespace Cpu {
+
+/**
+* Utilities shared by the CPU VecOp and Reduce functions.
+*
+* \ingroup Prdc_Cpu_Module
+*/
+namespace Simd {
+
+   /**
+   * Minimum array length for which elementwise operations are threaded.
+   */
+   const int minParallelSize = 4096;
+
+   /**
+   * Get the widest vector instruction set supported at run time.
+   *
+   * Returns "avx512f", "avx2" or "default". This is the version of
+   * each VecOp and Reduce kernel that is used if runtime dispatch is
+   * enabled. Otherwise, kernels use the instruction set selected by
+   * compiler options, and "default" is returned.
+   */
+   char const * instructionSet();
+
+   /**
+   * Get the subrange of [0, n) assigned to the calling OpenMP thread.
+   *
+   * The range is divided into nearly equal contiguous subranges, one
+   * per thread of the innermost enclosing parallel region. Outside of
+   * a parallel region (or without OpenMP), returns begin = 0, end = n.
+   *
+   * \param n  number of elements
+   * \param begin  index of first element for this thread (output)
+   * \param end  index one past last element for this thread (output)
+   */
+   void threadRange(int n, int& begin, int& end);
+
+   /**
+   * Check that a slice [beginId, beginId + n) lies within an array.
+   *
+   * \param capacity  capacity of the array
+   * \param beginId  index of the first element of the slice
+   * \param n  number of elements in the slice
+   */
+   inline void checkSlice(int capacity, int beginId, int n)
+   {
+      UTIL_CHECK(n >= 0);
+      UTIL_CHECK(beginId >= 0);
+      UTIL_CHECK(beginId + n <= capacity);
+   }
+
+}
+
+}
+}
+}
+#endif
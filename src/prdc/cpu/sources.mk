@@ -4,10 +4,18 @@ prdc_cpu_= \
   prdc/cpu/RFieldDft.cpp \
   prdc/cpu/CField.cpp \
   prdc/cpu/FFT.cpp \
+  prdc/cpu/FFTBatched.cpp \
+  prdc/cpu/FFTMirror.cpp \
+  prdc/cpu/FftwSettings.cpp \
+  prdc/cpu/FieldPool.cpp \
   prdc/cpu/RFieldComparison.cpp \
   prdc/cpu/RFieldDftComparison.cpp \
   prdc/cpu/CFieldComparison.cpp \
   prdc/cpu/FieldBasisConverter.cpp \
+  prdc/cpu/simd.cpp \
+  prdc/cpu/VecOp.cpp \
+  prdc/cpu/VecOpMisc.cpp \
+  prdc/cpu/Reduce.cpp \
   prdc/cpu/complex.cpp
 
 prdc_cpu_OBJS=\
@@ -0,0 +1,18 @@
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "MeshOrbits.tpp"
+
+namespace Pscf {
+namespace Prdc {
+
+   template class MeshOrbits<1>;
+   template class MeshOrbits<2>;
+   template class MeshOrbits<3>;
+
+}
+}
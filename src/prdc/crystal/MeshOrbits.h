@@ -0,0 +1,190 @@
+#ifndef PRDC_MESH_ORBITS_H
+#define PRDC_MESH_ORBITS_H
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/Array.h>        // function argument
+#include <util/containers/DArray.h>       // member
+#include <util/global.h>
+
+namespace Pscf { 
+   template <int D> class Mesh;
+namespace Prdc { 
+
+   template <int D> class SpaceGroup;
+
+   using namespace Util;
+
+   /**
+   * Orbits of the nodes of a mesh under the operations of a space group.
+   *
+   * Each symmetry operation of a space group maps every node of a mesh 
+   * that is compatible with the group (see 
+   * SpaceGroup::checkMeshDimensions) onto another node. The set of all
+   * nodes onto which a node is mapped by the operations of the group is
+   * called an orbit. A field that is invariant under all operations of 
+   * the group has the same value at every node of each orbit, and is 
+   * thus fully specified by its values at one representative node of 
+   * each orbit, i.e., by its values within the asymmetric unit. The 
+   * representative of each orbit is the node of the orbit with the 
+   * lowest rank. Orbits are indexed in order of increasing rank of 
+   * their representatives.
+   *
+   * The functions reduce and expand copy a symmetric field to and from
+   * an array with one element per orbit. For a generic point in a group
+   * with n operations, the number of orbits is approximately 1/n times
+   * the number of mesh nodes.
+   *
+   * \ingroup Prdc_Crystal_Module
+   */
+   template <int D>
+   class MeshOrbits 
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      MeshOrbits();
+
+      /**
+      * Destructor.
+      */
+      ~MeshOrbits();
+
+      /**
+      * Construct the orbits of all nodes of a mesh.
+      *
+      * May be called more than once. The mesh dimensions must be 
+      * compatible with the space group.
+      *
+      * \param mesh  spatial discretization mesh
+      * \param group  crystallographic space group
+      */
+      void makeOrbits(Mesh<D> const & mesh, SpaceGroup<D> const & group);
+
+      /**
+      * Copy values of a symmetric field at orbit representatives.
+      *
+      * \param full  field defined on all mesh nodes (input)
+      * \param reduced  one value per orbit (output)
+      */
+      void reduce(Array<double> const & full, Array<double>& reduced) 
+      const;
+
+      /**
+      * Assign the value of each orbit to all nodes of the orbit.
+      *
+      * \param reduced  one value per orbit (input)
+      * \param full  field defined on all mesh nodes (output)
+      */
+      void expand(Array<double> const & reduced, Array<double>& full) 
+      const;
+
+      /**
+      * Assign the value of each orbit to all nodes of the orbit.
+      *
+      * This overload writes to a raw array, e.g., to one of several 
+      * fields stored contiguously in a larger array.
+      *
+      * \param reduced  one value per orbit (input)
+      * \param full  pointer to array of meshSize() elements (output)
+      */
+      void expand(Array<double> const & reduced, double* full) const;
+
+      /**
+      * Get the number of orbits.
+      */
+      int nOrbit() const;
+
+      /**
+      * Get the number of mesh nodes.
+      */
+      int meshSize() const;
+
+      /**
+      * Get the index of the orbit containing a mesh node.
+      *
+      * \param rank  rank of the node in the mesh
+      */
+      int orbitId(int rank) const;
+
+      /**
+      * Get the mesh rank of the representative node of an orbit.
+      *
+      * \param id  orbit index
+      */
+      int representative(int id) const;
+
+      /**
+      * Get the number of mesh nodes in an orbit.
+      *
+      * \param id  orbit index
+      */
+      int orbitSize(int id) const;
+
+      /**
+      * Has makeOrbits been called?
+      */
+      bool isInitialized() const;
+
+   private:
+
+      /// Orbit index for each mesh node, indexed by rank.
+      DArray<int> orbitIds_;
+
+      /// Mesh rank of the representative of each orbit.
+      DArray<int> representatives_;
+
+      /// Number of nodes in each orbit.
+      DArray<int> orbitSizes_;
+
+      /// Number of orbits.
+      int nOrbit_;
+
+      /// Number of mesh nodes.
+      int meshSize_;
+
+   };
+
+   // Inline member functions
+
+   template <int D>
+   inline int MeshOrbits<D>::nOrbit() const
+   {  return nOrbit_; }
+
+   template <int D>
+   inline int MeshOrbits<D>::meshSize() const
+   {  return meshSize_; }
+
+   template <int D>
+   inline int MeshOrbits<D>::orbitId(int rank) const
+   {  return orbitIds_[rank]; }
+
+   template <int D>
+   inline int MeshOrbits<D>::representative(int id) const
+   {  return representatives_[id]; }
+
+   template <int D>
+   inline int MeshOrbits<D>::orbitSize(int id) const
+   {  return orbitSizes_[id]; }
+
+   template <int D>
+   inline bool MeshOrbits<D>::isInitialized() const
+   {  return (nOrbit_ > 0); }
+
+   #ifndef PRDC_MESH_ORBITS_TPP
+   extern template class MeshOrbits<1>;
+   extern template class MeshOrbits<2>;
+   extern template class MeshOrbits<3>;
+   #endif
+
+} // namespace Pscf::Prdc
+} // namespace Pscf
+#endif
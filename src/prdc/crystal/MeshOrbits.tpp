@@ -0,0 +1,180 @@
+#ifndef PRDC_MESH_ORBITS_TPP
+#define PRDC_MESH_ORBITS_TPP
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "MeshOrbits.h"
+#include <prdc/crystal/SpaceGroup.h>
+#include <pscf/mesh/Mesh.h>
+#include <pscf/math/IntVec.h>
+#include <util/containers/GArray.h>
+
+namespace Pscf {
+namespace Prdc {
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   template <int D>
+   MeshOrbits<D>::MeshOrbits()
+    : orbitIds_(),
+      representatives_(),
+      orbitSizes_(),
+      nOrbit_(0),
+      meshSize_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   template <int D>
+   MeshOrbits<D>::~MeshOrbits()
+   {}
+
+   /*
+   * Construct orbits of all mesh nodes.
+   *
+   * The image of the node at integer position r under a symmetry 
+   * operation with rotation matrix R and translation t (both defined 
+   * in reduced coordinates) has position r' with components
+   * r'_i = sum_j R(i,j) r_j + t_i N_i (modulo N_i). This requires that
+   * dimensions N_i and N_j be equal whenever R(i,j) is nonzero for 
+   * i != j, and that t_i N_i be an integer, which are both guaranteed 
+   * by SpaceGroup::checkMeshDimensions.
+   */
+   template <int D>
+   void 
+   MeshOrbits<D>::makeOrbits(Mesh<D> const & mesh, 
+                             SpaceGroup<D> const & group)
+   {
+      UTIL_CHECK(mesh.size() > 0);
+      UTIL_CHECK(group.size() > 0);
+      group.checkMeshDimensions(mesh.dimensions());
+      IntVec<D> const & dimensions = mesh.dimensions();
+
+      // Integer translations t_i N_i of all operations
+      int nOp = group.size();
+      DArray< IntVec<D> > translations;
+      translations.allocate(nOp);
+      int i, j, k, num, den;
+      for (k = 0; k < nOp; ++k) {
+         for (i = 0; i < D; ++i) {
+            num = group[k].t(i).num();
+            den = group[k].t(i).den();
+            UTIL_CHECK((num*dimensions[i]) % den == 0);
+            translations[k][i] = (num*dimensions[i])/den;
+         }
+      }
+
+      // Initialize arrays
+      meshSize_ = mesh.size();
+      if (orbitIds_.isAllocated()) {
+         orbitIds_.deallocate();
+         representatives_.deallocate();
+         orbitSizes_.deallocate();
+      }
+      orbitIds_.allocate(meshSize_);
+      for (int rank = 0; rank < meshSize_; ++rank) {
+         orbitIds_[rank] = -1;
+      }
+
+      // Assign each node to an orbit, in order of increasing rank
+      GArray<int> representatives;
+      GArray<int> orbitSizes;
+      IntVec<D> position, image;
+      int rank, imageRank, size;
+      for (rank = 0; rank < meshSize_; ++rank) {
+         if (orbitIds_[rank] >= 0) continue;
+
+         // Node with lowest rank in a new orbit
+         orbitIds_[rank] = representatives.size();
+         size = 1;
+         position = mesh.position(rank);
+         for (k = 0; k < nOp; ++k) {
+            for (i = 0; i < D; ++i) {
+               image[i] = translations[k][i];
+               for (j = 0; j < D; ++j) {
+                  image[i] += group[k].R(i,j)*position[j];
+               }
+               image[i] = image[i] % dimensions[i];
+               if (image[i] < 0) image[i] += dimensions[i];
+            }
+            imageRank = mesh.rank(image);
+            if (orbitIds_[imageRank] < 0) {
+               orbitIds_[imageRank] = orbitIds_[rank];
+               ++size;
+            } else {
+               UTIL_CHECK(orbitIds_[imageRank] == orbitIds_[rank]);
+            }
+         }
+         representatives.append(rank);
+         orbitSizes.append(size);
+      }
+
+      // Copy representatives and orbit sizes to fixed size arrays
+      nOrbit_ = representatives.size();
+      representatives_.allocate(nOrbit_);
+      orbitSizes_.allocate(nOrbit_);
+      for (i = 0; i < nOrbit_; ++i) {
+         representatives_[i] = representatives[i];
+         orbitSizes_[i] = orbitSizes[i];
+      }
+   }
+
+   /*
+   * Copy values of a symmetric field at orbit representatives.
+   */
+   template <int D>
+   void MeshOrbits<D>::reduce(Array<double> const & full, 
+                              Array<double>& reduced) const
+   {
+      UTIL_CHECK(nOrbit_ > 0);
+      UTIL_CHECK(full.capacity() == meshSize_);
+      UTIL_CHECK(reduced.capacity() == nOrbit_);
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for
+      #endif
+      for (int i = 0; i < nOrbit_; ++i) {
+         reduced[i] = full[representatives_[i]];
+      }
+   }
+
+   /*
+   * Assign the value of each orbit to all of its nodes.
+   */
+   template <int D>
+   void MeshOrbits<D>::expand(Array<double> const & reduced,
+                              Array<double>& full) const
+   {
+      UTIL_CHECK(full.capacity() == meshSize_);
+      expand(reduced, &full[0]);
+   }
+
+   /*
+   * Assign the value of each orbit to all of its nodes (raw array).
+   */
+   template <int D>
+   void MeshOrbits<D>::expand(Array<double> const & reduced,
+                              double* full) const
+   {
+      UTIL_CHECK(nOrbit_ > 0);
+      UTIL_CHECK(full);
+      UTIL_CHECK(reduced.capacity() == nOrbit_);
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for
+      #endif
+      for (int i = 0; i < meshSize_; ++i) {
+         full[i] = reduced[orbitIds_[i]];
+      }
+   }
+
+}
+}
+#endif
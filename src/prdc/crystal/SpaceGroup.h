@@ -44,6 +44,17 @@ namespace Prdc {
       hasInversionCenter(typename SpaceSymmetry<D>::Translation& center) 
       const;
 
+      /**
+      * Determines if this group contains a mirror plane normal to each axis.
+      *
+      * Returns true if, for every axis i, the group contains a reflection
+      * x_i -> -x_i through a plane that contains the origin, i.e., an
+      * element with a diagonal rotation matrix in which only R(i,i) = -1,
+      * and zero translation. Fields that are invariant under such a 
+      * group are even functions of each reduced coordinate. 
+      */
+      bool hasMirrorPlanes() const;
+
       /**
       * Shift the origin of space used in the coordinate system.
       *
@@ -90,6 +101,16 @@ namespace Prdc {
       */
       void checkMeshDimensions(IntVec<D> const & dimensions) const;
 
+      /**
+      * Get required divisors of mesh dimensions.
+      *
+      * Element i of the return value is the smallest integer such that
+      * the translation vectors of all symmetry operations map nodes of
+      * any mesh with a multiple of this number of grid points along
+      * direction i onto other nodes, in that direction.
+      */
+      IntVec<D> meshDivisors() const;
+
       // Using declarations for some inherited functions
       using SymmetryGroup< SpaceSymmetry <D> >::size;
 
@@ -48,6 +48,40 @@ namespace Prdc {
       return false;
    }
 
+   /*
+   * Does this group contain a mirror plane normal to each axis?
+   */
+   template <int D>
+   bool SpaceGroup<D>::hasMirrorPlanes() const
+   {
+      bool isMirror;
+      int i, j, k, axis;
+      for (axis = 0; axis < D; ++axis) {
+         bool found = false;
+         for (i = 0; i < size(); ++i) {
+            isMirror = true;
+            for (j = 0; j < D; ++j) {
+               for (k = 0; k < D; ++k) {
+                  if (j != k) {
+                     if ((*this)[i].R(j,k) != 0) isMirror = false;
+                  } else if (j == axis) {
+                     if ((*this)[i].R(j,k) != -1) isMirror = false;
+                  } else {
+                     if ((*this)[i].R(j,k) != 1) isMirror = false;
+                  }
+               }
+               if ((*this)[i].t(j).num() != 0) isMirror = false;
+            }
+            if (isMirror) {
+               found = true;
+               break;
+            }
+         }
+         if (!found) return false;
+      }
+      return true;
+   }
+
    template <int D>
    void SpaceGroup<D>::shiftOrigin(
                     typename SpaceSymmetry<D>::Translation const & origin)
@@ -58,18 +92,11 @@ namespace Prdc {
    }
 
    /*
-   * Check if a mesh is compatible with this space group.
+   * Find required divisors of mesh dimensions, imposed by translations.
    */
    template <int D>
-   void SpaceGroup<D>::checkMeshDimensions(IntVec<D> const & dimensions)
-   const
+   IntVec<D> SpaceGroup<D>::meshDivisors() const
    {
-
-      // ---------------------------------------------------------------
-      // Check compatibility of mesh dimensions & translations
-      // ---------------------------------------------------------------
-
-      // Identify required divisor of mesh dimension in each direction
       int numerator, denominator;
       IntVec<D> divisors;
       for (int i = 0; i < D; ++i) {
@@ -99,6 +126,24 @@ namespace Prdc {
          }
       }
 
+      return divisors;
+   }
+
+   /*
+   * Check if a mesh is compatible with this space group.
+   */
+   template <int D>
+   void SpaceGroup<D>::checkMeshDimensions(IntVec<D> const & dimensions)
+   const
+   {
+
+      // ---------------------------------------------------------------
+      // Check compatibility of mesh dimensions & translations
+      // ---------------------------------------------------------------
+
+      // Identify required divisor of mesh dimension in each direction
+      IntVec<D> divisors = meshDivisors();
+
       // Check that mesh dimensions are multiples of required divisor
       for (int i = 1; i < D; ++i) {
          if (dimensions[i]%divisors[i] != 0) {
@@ -7,6 +7,7 @@ prdc_crystal_= \
   prdc/crystal/SymmetryGroup.cpp \
   prdc/crystal/SpaceGroup.cpp \
   prdc/crystal/Basis.cpp \
+  prdc/crystal/MeshOrbits.cpp \
   prdc/crystal/groupFile.cpp \
   prdc/crystal/BFieldComparison.cpp \
   prdc/crystal/getDimension.cpp \
@@ -753,6 +753,86 @@ namespace Prdc {
       /// \name Grid Manipulation Utilities
       ///@{
 
+      /**
+      * Resample an r-grid field onto a mesh with different dimensions.
+      *
+      * This function computes the discrete Fourier transform of the input
+      * field, copies coefficients of all wavevectors that can be
+      * represented on the output mesh (zero-padding or truncating the
+      * set of wavevectors, as needed), and computes an inverse transform
+      * on the output mesh. When the output mesh is finer than the input
+      * mesh, the result is the trigonometric interpolant of the input.
+      *
+      * The input and output fields must both be allocated on entry. The
+      * dimensions of the output mesh are given by the mesh dimensions of
+      * the output field. Neither mesh needs to be the mesh associated
+      * with this FieldIoReal, and the two meshes may have any numbers of
+      * grid points, even or odd, in each direction.
+      *
+      * The default version is unimplemented and throws an Exception. An
+      * implementation for this function must be defined in each subclass.
+      *
+      * \param in  field on the input mesh
+      * \param out  field on the output mesh
+      */
+      virtual
+      void resampleFieldRGrid(RFRT const & in, RFRT& out) const;
+
+      /**
+      * Resample an array of r-grid fields onto a different mesh.
+      *
+      * This function calls resampleFieldRGrid for each element of the
+      * in and out arrays, which must have equal capacities.
+      *
+      * \param in  array of fields on the input mesh
+      * \param out  array of fields on the output mesh
+      */
+      void resampleFieldsRGrid(DArray<RFRT> const & in,
+                               DArray<RFRT>& out) const;
+
+      /**
+      * Write r-grid fields resampled onto a different mesh to ostream.
+      *
+      * This function resamples an array of fields defined on the mesh
+      * of the input fields onto a mesh with the specified dimensions by
+      * zero-padding or truncation of Fourier coefficients, and writes
+      * the resulting fields to an output stream in r-grid file format.
+      * The unit cell is unchanged. The file header does not contain a
+      * space group name, because the space group need not be compatible
+      * with the new mesh.
+      *
+      * The default version is unimplemented and throws an Exception. An
+      * implementation for this function must be defined in each subclass.
+      *
+      * \param out  output stream (i.e., output file)
+      * \param fields  array of RField (r-space) fields to be resampled
+      * \param unitCell  associated crystallographic unit cell
+      * \param dimensions  numbers of grid points in the output mesh
+      */
+      virtual
+      void resampleRGrid(std::ostream& out,
+                         DArray<RFRT> const & fields,
+                         UnitCell<D> const & unitCell,
+                         IntVec<D> const & dimensions) const;
+
+      /**
+      * Write r-grid fields resampled onto a different mesh to file.
+      *
+      * This function opens output file filename, writes resampled fields
+      * to the file, and closes the file. See documentation of the
+      * overloaded function of the same name with a std::ostream
+      * parameter, which is called internally.
+      *
+      * \param filename  output file name
+      * \param fields  array of RField (r-space) fields to be resampled
+      * \param unitCell  associated crystallographic unit cell
+      * \param dimensions  numbers of grid points in the output mesh
+      */
+      void resampleRGrid(std::string filename,
+                         DArray<RFRT> const & fields,
+                         UnitCell<D> const & unitCell,
+                         IntVec<D> const & dimensions) const;
+
       /**
       * Write r-grid fields in a replicated unit cell to std::ostream.
       *
@@ -556,6 +556,31 @@ namespace Prdc {
       }
    }
 
+   template <int D, class RFRT, class RFKT, class FFTT>
+   void FieldIoReal<D,RFRT,RFKT,FFTT>::resampleFieldsRGrid(
+                              DArray<RFRT> const & in,
+                              DArray<RFRT>& out) const
+   {
+      int n = in.capacity();
+      UTIL_CHECK(out.capacity() == n);
+      for (int i = 0; i < n; ++i) {
+         resampleFieldRGrid(in[i], out[i]);
+      }
+   }
+
+   template <int D, class RFRT, class RFKT, class FFTT>
+   void FieldIoReal<D,RFRT,RFKT,FFTT>::resampleRGrid(
+                              std::string filename,
+                              DArray<RFRT> const & fields,
+                              UnitCell<D> const & unitCell,
+                              IntVec<D> const & dimensions) const
+   {
+      std::ofstream file;
+      fileMaster().openOutputFile(filename, file);
+      resampleRGrid(file, fields, unitCell, dimensions);
+      file.close();
+   }
+
    template <int D, class RFRT, class RFKT, class FFTT>
    void FieldIoReal<D,RFRT,RFKT,FFTT>::replicateUnitCell(
                               std::string filename,
@@ -814,6 +839,26 @@ namespace Prdc {
                               IntVec<D> const & replicas) const
    {  UTIL_THROW("Unimplemented function in FieldIoReal base class"); }
 
+   /*
+   * Resample an r-grid field onto a different mesh.
+   */
+   template <int D, class RFRT, class RFKT, class FFTT>
+   void FieldIoReal<D,RFRT,RFKT,FFTT>::resampleFieldRGrid(
+                              RFRT const & in,
+                              RFRT& out) const
+   {  UTIL_THROW("Unimplemented function in FieldIoReal base class"); }
+
+   /*
+   * Resample an array of r-grid fields, write to ostream.
+   */
+   template <int D, class RFRT, class RFKT, class FFTT>
+   void FieldIoReal<D,RFRT,RFKT,FFTT>::resampleRGrid(
+                              std::ostream &out,
+                              DArray<RFRT> const & fields,
+                              UnitCell<D> const & unitCell,
+                              IntVec<D> const & dimensions) const
+   {  UTIL_THROW("Unimplemented function in FieldIoReal base class"); }
+
    /*
    * Expand dimension of an array of r-grid fields, write to ostream.
    */
@@ -489,6 +489,40 @@ namespace Prdc {
 
    // Field manipulation utilities
 
+   /**
+   * Resample the DFT of a real field onto a k-grid for a different mesh.
+   *
+   * The input and output arrays contain discrete Fourier transforms of
+   * real periodic fields defined on meshes with dimensions inDimensions
+   * and outDimensions, normalized such that coefficients are amplitudes
+   * of plane waves (i.e., as computed by a scaled forward transform).
+   * Coefficients of wavevectors that exist on both meshes are copied,
+   * coefficients of wavevectors that exist only on the output mesh are
+   * set to zero, and those that exist only on the input mesh are
+   * discarded. An inverse transform of the output thus gives the
+   * trigonometric interpolant of the input field, truncated to the
+   * wavevectors that can be represented on the output mesh.
+   *
+   * Nyquist wavevectors of meshes with an even number of grid points
+   * are treated so as to preserve real output: When the output mesh
+   * is finer, an input Nyquist coefficient is split equally between
+   * the two output wavevectors +G and -G. When the output mesh is
+   * coarser, both input coefficients of +G and -G are added to the
+   * output Nyquist coefficient.
+   *
+   * \ingroup Prdc_Field_Module
+   *
+   * \param in  DFT of a real field on the input mesh (in)
+   * \param inDimensions  dimensions of the input real-space mesh (in)
+   * \param out  DFT of a real field on the output mesh (out)
+   * \param outDimensions  dimensions of the output real-space mesh (in)
+   */
+   template <int D, class ACT>
+   void resampleKGrid(ACT const & in,
+                      IntVec<D> const & inDimensions,
+                      ACT& out,
+                      IntVec<D> const & outDimensions);
+
    /**
    * Write r-grid fields in a replicated unit cell to std::ostream.
    *
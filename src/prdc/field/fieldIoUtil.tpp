@@ -27,6 +27,7 @@
 #include <util/format/Dbl.h>
 
 #include <string>
+#include <cstdlib>
 
 namespace Pscf {
 namespace Prdc {
@@ -1012,6 +1013,115 @@ namespace Prdc {
 
    // Field file manipulations
 
+   template <int D, class ACT>
+   void resampleKGrid(ACT const & in,
+                      IntVec<D> const & inDimensions,
+                      ACT& out,
+                      IntVec<D> const & outDimensions)
+   {
+      typedef typename ACT::Complex CT;
+      typedef typename ACT::Real    RT;
+
+      // Dimensions of the k-grids used for DFTs of real fields
+      IntVec<D> inDftDimensions;
+      IntVec<D> outDftDimensions;
+      int i;
+      for (i = 0; i < D; ++i) {
+         UTIL_CHECK(inDimensions[i] > 0);
+         UTIL_CHECK(outDimensions[i] > 0);
+         if (i < D - 1) {
+            inDftDimensions[i] = inDimensions[i];
+            outDftDimensions[i] = outDimensions[i];
+         } else {
+            inDftDimensions[i] = inDimensions[i]/2 + 1;
+            outDftDimensions[i] = outDimensions[i]/2 + 1;
+         }
+      }
+      Mesh<D> inDftMesh(inDftDimensions);
+      Mesh<D> outDftMesh(outDftDimensions);
+      UTIL_CHECK(in.capacity() == inDftMesh.size());
+      UTIL_CHECK(out.capacity() == outDftMesh.size());
+
+      // Along each direction, an output wavenumber receives contributions
+      // from at most two input wavenumbers, with weights 1 or 1/2.
+      int nTerm[D];
+      int wave[D][2];
+      double weight[D][2];
+
+      IntVec<D> position, indices;
+      std::complex<RT> sum, coeff;
+      double w;
+      int g, n, m, t, rank;
+      bool isAllowed;
+      MeshIterator<D> iter(outDftDimensions);
+      for (iter.begin(); !iter.atEnd(); ++iter) {
+         position = iter.position();
+
+         // Identify contributing input wavenumbers in each direction
+         for (i = 0; i < D; ++i) {
+            n = inDimensions[i];
+            m = outDimensions[i];
+            g = position[i];
+            if (2*g > m) g -= m;
+            nTerm[i] = 0;
+            if (2*std::abs(g) < n) {
+               wave[i][0] = g;
+               weight[i][0] = 1.0;
+               nTerm[i] = 1;
+               if (2*std::abs(g) == m) {
+                  // Output Nyquist wavenumber, coarser output mesh
+                  wave[i][1] = -g;
+                  weight[i][1] = 1.0;
+                  nTerm[i] = 2;
+               }
+            } else
+            if (2*std::abs(g) == n) {
+               // Input Nyquist wavenumber
+               wave[i][0] = g;
+               weight[i][0] = (n == m) ? 1.0 : 0.5;
+               nTerm[i] = 1;
+            }
+         }
+
+         // Sum contributions from all combinations of input wavenumbers
+         sum = std::complex<RT>(0.0, 0.0);
+         for (t = 0; t < (1 << D); ++t) {
+            isAllowed = true;
+            w = 1.0;
+            for (i = 0; i < D; ++i) {
+               int j = (t >> i) & 1;
+               if (j >= nTerm[i]) {
+                  isAllowed = false;
+                  break;
+               }
+               indices[i] = wave[i][j];
+               w *= weight[i][j];
+            }
+            if (!isAllowed) continue;
+
+            // Map wavevector onto the input k-grid, using the conjugate
+            // of the coefficient of -G if G is not stored explicitly
+            bool isConjugate = false;
+            for (i = 0; i < D; ++i) {
+               n = inDimensions[i];
+               indices[i] = ((indices[i] % n) + n) % n;
+            }
+            if (indices[D-1] >= inDftDimensions[D-1]) {
+               isConjugate = true;
+               for (i = 0; i < D; ++i) {
+                  n = inDimensions[i];
+                  indices[i] = (n - indices[i]) % n;
+               }
+            }
+            rank = inDftMesh.rank(indices);
+            assign<CT, RT>(coeff, in[rank]);
+            if (isConjugate) coeff = std::conj(coeff);
+            sum += w*coeff;
+         }
+         assign<CT, RT>(out[iter.rank()], sum);
+      }
+   }
+
    template <int D, class ART>
    void replicateUnitCell(std::ostream &out,
                           DArray<ART> const & fields,
@@ -5,6 +5,9 @@
 #include <test/UnitTestRunner.h>
 
 #include <prdc/cpu/FFT.h>
+#include <prdc/cpu/FFTBatched.h>
+#include <prdc/cpu/FFTMirror.h>
+#include <prdc/cpu/FftwSettings.h>
 #include <prdc/cpu/RField.h>
 #include <prdc/cpu/RFieldDft.h>
 #include <prdc/cpu/RFieldComparison.h>
@@ -32,6 +35,13 @@ public:
    void testTransformComplex2D();
    void testTransformComplex3D();
 
+   void testBatchedTransformReal2D();
+   void testBatchedTransformReal3D();
+
+   void testMirrorTransform2D();
+
+   void testPlannerRigor();
+
 };
 
 void CpuFftTest::testConstructor()
@@ -413,6 +423,271 @@ void CpuFftTest::testTransformComplex3D()
 
 }
 
+void CpuFftTest::testBatchedTransformReal2D() 
+{
+   printMethod(TEST_FUNC);
+
+   // Create mesh
+   IntVec<2> d;
+   d[0] = 5;
+   d[1] = 6;
+   int batchSize = 3;
+
+   // Setup single and batched FFT objects
+   Cpu::FFT<2> fft;
+   fft.setup(d);
+   Cpu::FFTBatched<2> v;
+   v.setup(d, batchSize);
+   TEST_ASSERT(v.isSetup());
+   TEST_ASSERT(v.batchSize() == batchSize);
+
+   Cpu::RField<2> in;
+   Cpu::RFieldDft<2> out;
+   in.allocate(d);
+   out.allocate(d);
+   int rSize = in.capacity();
+   int kSize = out.capacity();
+
+   // Generate test data, with different values in each field of batch
+   Cpu::FftwDArray<double> rFields;
+   Cpu::FftwDArray<fftw_complex> kFields;
+   Cpu::FftwDArray<double> rFields2;
+   rFields.allocate(batchSize*rSize);
+   kFields.allocate(batchSize*kSize);
+   rFields2.allocate(batchSize*rSize);
+   for (int i = 0; i < batchSize*rSize; i++) {
+      rFields[i] = 1.0 + double(i)/double(rSize) 
+                 + 0.3*sin(double(i));
+   }
+
+   // Forward transform
+   v.forwardTransform(rFields, kFields);
+
+   // Compare each field in batch to result of FFT<2>
+   for (int j = 0; j < batchSize; j++) {
+      for (int i = 0; i < rSize; i++) {
+         in[i] = rFields[j*rSize + i];
+      }
+      fft.forwardTransform(in, out);
+      for (int i = 0; i < kSize; i++) {
+         TEST_ASSERT(eq(out[i][0], kFields[j*kSize + i][0]));
+         TEST_ASSERT(eq(out[i][1], kFields[j*kSize + i][1]));
+      }
+   }
+
+   // Unscaled forward transform, compare to scaled
+   Cpu::FftwDArray<fftw_complex> kFields2;
+   kFields2.allocate(batchSize*kSize);
+   v.forwardTransformUnscaled(rFields, kFields2);
+   double scale = 1.0/double(rSize);
+   for (int i = 0; i < batchSize*kSize; i++) {
+      TEST_ASSERT(eq(kFields[i][0], kFields2[i][0]*scale));
+      TEST_ASSERT(eq(kFields[i][1], kFields2[i][1]*scale));
+   }
+
+   // Inverse transform (round trip)
+   v.inverseTransformUnsafe(kFields, rFields2);
+   for (int i = 0; i < batchSize*rSize; i++) {
+      TEST_ASSERT(eq(rFields[i], rFields2[i]));
+   }
+
+   // Reset batch size and repeat round trip
+   v.resetBatchSize(1);
+   TEST_ASSERT(v.batchSize() == 1);
+   Cpu::RFieldDft<2> out2;
+   out2.allocate(d);
+   v.forwardTransform(in, out2);
+   for (int i = 0; i < kSize; i++) {
+      TEST_ASSERT(eq(out[i][0], out2[i][0]));
+      TEST_ASSERT(eq(out[i][1], out2[i][1]));
+   }
+
+}
+
+void CpuFftTest::testBatchedTransformReal3D() 
+{
+   printMethod(TEST_FUNC);
+
+   // Create mesh
+   IntVec<3> d;
+   d[0] = 3;
+   d[1] = 4;
+   d[2] = 5;
+   int batchSize = 3;
+
+   // Setup single and batched FFT objects
+   Cpu::FFT<3> fft;
+   fft.setup(d);
+   Cpu::FFTBatched<3> v;
+   v.setup(d, batchSize);
+   TEST_ASSERT(v.isSetup());
+   TEST_ASSERT(v.batchSize() == batchSize);
+
+   Cpu::RField<3> in;
+   Cpu::RFieldDft<3> out;
+   in.allocate(d);
+   out.allocate(d);
+   int rSize = in.capacity();
+   int kSize = out.capacity();
+
+   // Generate test data, with different values in each field of batch
+   Cpu::FftwDArray<double> rFields;
+   Cpu::FftwDArray<fftw_complex> kFields;
+   Cpu::FftwDArray<double> rFields2;
+   rFields.allocate(batchSize*rSize);
+   kFields.allocate(batchSize*kSize);
+   rFields2.allocate(batchSize*rSize);
+   for (int i = 0; i < batchSize*rSize; i++) {
+      rFields[i] = 1.0 + double(i)/double(rSize) 
+                 + 0.3*sin(double(i));
+   }
+
+   // Forward transform
+   v.forwardTransform(rFields, kFields);
+
+   // Compare each field in batch to result of FFT<3>
+   for (int j = 0; j < batchSize; j++) {
+      for (int i = 0; i < rSize; i++) {
+         in[i] = rFields[j*rSize + i];
+      }
+      fft.forwardTransform(in, out);
+      for (int i = 0; i < kSize; i++) {
+         TEST_ASSERT(eq(out[i][0], kFields[j*kSize + i][0]));
+         TEST_ASSERT(eq(out[i][1], kFields[j*kSize + i][1]));
+      }
+   }
+
+   // Inverse transform (round trip)
+   v.inverseTransformUnsafe(kFields, rFields2);
+   for (int i = 0; i < batchSize*rSize; i++) {
+      TEST_ASSERT(eq(rFields[i], rFields2[i]));
+   }
+
+   // Reset batch size and repeat round trip
+   v.resetBatchSize(1);
+   TEST_ASSERT(v.batchSize() == 1);
+   Cpu::RFieldDft<3> out2;
+   out2.allocate(d);
+   v.forwardTransform(in, out2);
+   for (int i = 0; i < kSize; i++) {
+      TEST_ASSERT(eq(out[i][0], out2[i][0]));
+      TEST_ASSERT(eq(out[i][1], out2[i][1]));
+   }
+
+}
+
+void CpuFftTest::testMirrorTransform2D() 
+{
+   printMethod(TEST_FUNC);
+
+   // Create mesh
+   IntVec<2> d;
+   d[0] = 6;
+   d[1] = 8;
+   TEST_ASSERT(Cpu::FFTMirror<2>::isValidMesh(d));
+
+   Cpu::FFTMirror<2> v;
+   v.setup(d);
+   TEST_ASSERT(v.isSetup());
+   TEST_ASSERT(v.reducedDimensions()[0] == 4);
+   TEST_ASSERT(v.reducedDimensions()[1] == 5);
+   TEST_ASSERT(v.reducedSize() == 20);
+
+   Cpu::FFT<2> fft;
+   fft.setup(d);
+
+   // Generate arbitrary reduced grid data, expand to an even field
+   IntVec<2> dm = v.reducedDimensions();
+   Cpu::RField<2> reduced, reducedOut, reduced2;
+   reduced.allocate(dm);
+   reducedOut.allocate(dm);
+   reduced2.allocate(dm);
+   int nm = reduced.capacity();
+   for (int i = 0; i < nm; i++) {
+      reduced[i] = 1.0 + 0.3*sin(double(i));
+   }
+   Cpu::RField<2> full;
+   full.allocate(d);
+   v.scatter(reduced, full);
+   int rSize = full.capacity();
+
+   // Check mirror symmetry of full field, and gather
+   int i0, i1;
+   for (i0 = 0; i0 < d[0]; ++i0) {
+      for (i1 = 1; i1 < d[1]; ++i1) {
+         TEST_ASSERT(eq(full[i0*d[1] + i1], full[i0*d[1] + d[1] - i1]));
+      }
+   }
+   v.gather(full, reduced2);
+   for (int i = 0; i < nm; i++) {
+      TEST_ASSERT(eq(reduced[i], reduced2[i]));
+   }
+
+   // Compare to real-to-complex FFT of full field. The k-grid and the
+   // reduced grid have the same dimension along the last axis.
+   Cpu::RFieldDft<2> out;
+   out.allocate(d);
+   fft.forwardTransform(full, out);
+   v.transform(reduced, reducedOut);
+   double scale = 1.0/double(rSize);
+   int rank;
+   for (i0 = 0; i0 < dm[0]; ++i0) {
+      for (i1 = 0; i1 < dm[1]; ++i1) {
+         rank = i0*dm[1] + i1;
+         TEST_ASSERT(eq(out[rank][0], reducedOut[rank]*scale));
+         TEST_ASSERT(eq(out[rank][1], 0.0));
+      }
+   }
+
+   // Round trip multiplies by number of full grid points
+   v.transform(reducedOut, reduced2);
+   for (int i = 0; i < nm; i++) {
+      TEST_ASSERT(eq(reduced[i], reduced2[i]*scale));
+   }
+
+   // Odd mesh dimensions are rejected
+   d[1] = 7;
+   TEST_ASSERT(!Cpu::FFTMirror<2>::isValidMesh(d));
+}
+
+void CpuFftTest::testPlannerRigor() 
+{
+   printMethod(TEST_FUNC);
+
+   TEST_ASSERT(Cpu::FftwSettings::plannerRigor() == "estimate");
+   TEST_ASSERT(Cpu::FftwSettings::plannerFlags() == FFTW_ESTIMATE);
+
+   // Plan with FFTW_MEASURE, and check round trip of a 2D transform
+   Cpu::FftwSettings::setPlannerRigor("measure");
+   TEST_ASSERT(Cpu::FftwSettings::plannerRigor() == "measure");
+   TEST_ASSERT(Cpu::FftwSettings::plannerFlags() == FFTW_MEASURE);
+
+   IntVec<2> d;
+   d[0] = 4;
+   d[1] = 6;
+   Cpu::FFT<2> v;
+   v.setup(d);
+
+   Cpu::RField<2> in;
+   Cpu::RFieldDft<2> out;
+   Cpu::RField<2> in2;
+   in.allocate(d);
+   out.allocate(d);
+   in2.allocate(d);
+   for (int i = 0; i < in.capacity(); i++) {
+      in[i] = 1.0 + double(i)/double(in.capacity());
+   }
+   v.forwardTransform(in, out);
+   v.inverseTransformSafe(out, in2);
+   for (int i = 0; i < in.capacity(); i++) {
+      TEST_ASSERT(eq(in[i], in2[i]));
+   }
+
+   // Restore default, so that later tests are unaffected
+   Cpu::FftwSettings::setPlannerRigor("estimate");
+   TEST_ASSERT(Cpu::FftwSettings::plannerFlags() == FFTW_ESTIMATE);
+}
+
 TEST_BEGIN(CpuFftTest)
 TEST_ADD(CpuFftTest, testConstructor)
 TEST_ADD(CpuFftTest, testTransformReal1D)
@@ -421,6 +696,10 @@ TEST_ADD(CpuFftTest, testTransformReal3D)
 TEST_ADD(CpuFftTest, testTransformComplex1D)
 TEST_ADD(CpuFftTest, testTransformComplex2D)
 TEST_ADD(CpuFftTest, testTransformComplex3D)
+TEST_ADD(CpuFftTest, testBatchedTransformReal2D)
+TEST_ADD(CpuFftTest, testBatchedTransformReal3D)
+TEST_ADD(CpuFftTest, testMirrorTransform2D)
+TEST_ADD(CpuFftTest, testPlannerRigor)
 TEST_END(CpuFftTest)
 
 #endif
@@ -5,6 +5,7 @@
 #include <test/UnitTestRunner.h>
 
 #include <prdc/cpu/FftwDArray.h>
+#include <prdc/cpu/FieldPool.h>
 
 #include <util/archives/MemoryOArchive.h>
 #include <util/archives/MemoryIArchive.h>
@@ -32,6 +33,7 @@ public:
    void testConstructor();
    void testAllocate();
    void testSubscript();
+   void testPool();
    void testSerialize1Memory();
    void testSerialize2Memory();
    void testSerialize1File();
@@ -76,6 +78,37 @@ void CpuFftwDArrayTest::testSubscript()
    }
 } 
 
+void CpuFftwDArrayTest::testPool()
+{
+   printMethod(TEST_FUNC);
+   {
+      Cpu::FieldPool::setEnabled(true);
+      long nReuse = Cpu::FieldPool::nReuse();
+
+      // Blocks are aligned, and released blocks are reused
+      Cpu::FftwDArray<double> v;
+      v.allocate(100);
+      double* ptr = v.cArray();
+      TEST_ASSERT(((std::size_t) ptr) % Cpu::FieldPool::alignment == 0);
+      v.deallocate();
+      TEST_ASSERT(!v.isAllocated());
+      TEST_ASSERT(v.capacity() == 0);
+      TEST_ASSERT(Cpu::FieldPool::cachedBytes() >= 800);
+
+      // An array in the same size class receives the cached block
+      Cpu::FftwDArray<fftw_complex> u;
+      u.allocate(50);
+      TEST_ASSERT((void*) u.cArray() == (void*) ptr);
+      TEST_ASSERT(Cpu::FieldPool::nReuse() == nReuse + 1);
+
+      // Disabling the pool frees cached blocks
+      u.deallocate();
+      Cpu::FieldPool::setEnabled(false);
+      TEST_ASSERT(Cpu::FieldPool::cachedBytes() == 0);
+      TEST_ASSERT(!Cpu::FieldPool::isEnabled());
+   }
+}
+
 void CpuFftwDArrayTest::testSerialize1Memory()
 {
    printMethod(TEST_FUNC);
@@ -311,6 +344,7 @@ TEST_BEGIN(CpuFftwDArrayTest)
 TEST_ADD(CpuFftwDArrayTest, testConstructor)
 TEST_ADD(CpuFftwDArrayTest, testAllocate)
 TEST_ADD(CpuFftwDArrayTest, testSubscript)
+TEST_ADD(CpuFftwDArrayTest, testPool)
 TEST_ADD(CpuFftwDArrayTest, testSerialize1Memory)
 TEST_ADD(CpuFftwDArrayTest, testSerialize2Memory)
 TEST_ADD(CpuFftwDArrayTest, testSerialize1File)
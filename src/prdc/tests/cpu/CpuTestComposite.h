@@ -11,6 +11,7 @@
 #include "CpuFftTest.h"
 #include "CpuComplexTest.h"
 #include "CpuFieldBasisConverterTest.h"
+#include "CpuVecOpTest.h"
 
 TEST_COMPOSITE_BEGIN(CpuTestComposite)
 TEST_COMPOSITE_ADD_UNIT(CpuFftwDArrayTest);
@@ -21,6 +22,7 @@ TEST_COMPOSITE_ADD_UNIT(CpuFieldComparisonTest);
 TEST_COMPOSITE_ADD_UNIT(CpuFftTest);
 TEST_COMPOSITE_ADD_UNIT(CpuComplexTest);
 TEST_COMPOSITE_ADD_UNIT(CpuFieldBasisConverterTest);
+TEST_COMPOSITE_ADD_UNIT(CpuVecOpTest);
 TEST_COMPOSITE_END
 
 #endif
@@ -0,0 +1,248 @@
+#ifndef PRDC_CPU_VEC_OP_TEST_H
+#define PRDC_CPU_VEC_OP_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <prdc/cpu/VecOp.h>
+#include <prdc/cpu/Reduce.h>
+#include <prdc/cpu/FftwDArray.h>
+#include <util/containers/DArray.h>
+#include <util/math/Constants.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Util;
+using namespace Pscf;
+using namespace Pscf::Prdc;
+using namespace Pscf::Prdc::Cpu;
+
+class CpuVecOpTest : public UnitTest
+{
+
+private:
+
+   // Error tolerance for array equality
+   constexpr static double tolerance_ = 1E-10;
+
+   // Array size, large enough to be divided among threads
+   const static int n = 10007;
+
+   // Input and output arrays, real and complex
+   FftwDArray<double> inReal, inReal2, outReal;
+   FftwDArray<fftw_complex> inComplex, outComplex;
+
+   // Input scalar
+   double scalar;
+
+   // Maximum difference between outReal and reference values
+   double maxDiff(DArray<double> const & ref)
+   {
+      double diff = 0.0;
+      for (int i = 0; i < ref.capacity(); ++i) {
+         diff = std::max(diff, std::abs(outReal[i] - ref[i]));
+      }
+      return diff;
+   }
+
+public:
+
+   void setUp()
+   {
+      inReal.allocate(n);
+      inReal2.allocate(n);
+      outReal.allocate(n);
+      inComplex.allocate(n);
+      outComplex.allocate(n);
+
+      // Define "in" arrays with arbitrary data between -1 and 1
+      double twoPi = 2.0 * Constants::Pi;
+      double fourPi = 4.0 * Constants::Pi;
+      for (int i = 0; i < n; i++) {
+         double frac = (double)i / (double)n;
+         inReal[i] = sin(fourPi * frac);
+         inReal2[i] = cos(frac); // all values >0.5, for dividing
+         inComplex[i][0] = cos(twoPi * frac);
+         inComplex[i][1] = sin(twoPi * frac);
+      }
+      scalar = 0.633;
+   }
+
+   void tearDown()
+   {}
+
+   void testElementwise()
+   {
+      printMethod(TEST_FUNC);
+
+      DArray<double> ref;
+      ref.allocate(n);
+      int i;
+
+      VecOp::eqS(outReal, scalar);
+      for (i = 0; i < n; ++i) ref[i] = scalar;
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::addVV(outReal, inReal, inReal2);
+      for (i = 0; i < n; ++i) ref[i] = inReal[i] + inReal2[i];
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::subVS(outReal, inReal, scalar);
+      for (i = 0; i < n; ++i) ref[i] = inReal[i] - scalar;
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::mulVV(outReal, inReal, inReal2);
+      for (i = 0; i < n; ++i) ref[i] = inReal[i] * inReal2[i];
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::divVV(outReal, inReal, inReal2);
+      for (i = 0; i < n; ++i) ref[i] = inReal[i] / inReal2[i];
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::expV(outReal, inReal);
+      for (i = 0; i < n; ++i) ref[i] = exp(inReal[i]);
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::addEqV(outReal, inReal2);
+      for (i = 0; i < n; ++i) ref[i] += inReal2[i];
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::mulEqS(outReal, scalar);
+      for (i = 0; i < n; ++i) ref[i] *= scalar;
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      // Mixed complex-real operations
+      VecOp::mulVV(outComplex, inComplex, inReal2);
+      VecOp::mulEqS(outComplex, scalar);
+      double diff = 0.0;
+      for (i = 0; i < n; ++i) {
+         diff = std::max(diff, std::abs(outComplex[i][0]
+                         - inComplex[i][0]*inReal2[i]*scalar));
+         diff = std::max(diff, std::abs(outComplex[i][1]
+                         - inComplex[i][1]*inReal2[i]*scalar));
+      }
+      TEST_ASSERT(diff < tolerance_);
+   }
+
+   void testSlice()
+   {
+      printMethod(TEST_FUNC);
+
+      // Operate on the second half of outReal, using shifted inputs
+      int m = n/2;
+      VecOp::eqS(outReal, 0.0);
+      VecOp::mulVV(outReal, inReal, inReal2, n - m, 1, 3, m);
+      for (int i = 0; i < n - m; ++i) {
+         TEST_ASSERT(outReal[i] == 0.0);
+      }
+      for (int i = 0; i < m; ++i) {
+         TEST_ASSERT(std::abs(outReal[n - m + i]
+                              - inReal[1 + i]*inReal2[3 + i]) < tolerance_);
+      }
+
+      // Slice of a complex array
+      VecOp::eqV(outComplex, inComplex);
+      VecOp::mulEqV(outComplex, inReal2, 7, 2, m);
+      for (int i = 0; i < n; ++i) {
+         double factor = (i >= 7 && i < 7 + m) ? inReal2[i - 5] : 1.0;
+         TEST_ASSERT(std::abs(outComplex[i][0] - inComplex[i][0]*factor)
+                     < tolerance_);
+         TEST_ASSERT(std::abs(outComplex[i][1] - inComplex[i][1]*factor)
+                     < tolerance_);
+      }
+
+      // Slices that exceed array bounds must be rejected
+      bool thrown = false;
+      try {
+         VecOp::addEqV(outReal, inReal, 1, 0, n);
+      } catch (Exception&) {
+         thrown = true;
+      }
+      TEST_ASSERT(thrown);
+   }
+
+   void testMisc()
+   {
+      printMethod(TEST_FUNC);
+
+      DArray<double> ref;
+      ref.allocate(n);
+      int i;
+
+      VecOp::addVcVcVc(outReal, inReal, 0.5, inReal2, -2.0, inReal, 3.0);
+      for (i = 0; i < n; ++i) {
+         ref[i] = inReal[i]*0.5 - inReal2[i]*2.0 + inReal[i]*3.0;
+      }
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::addVcVcS(outReal, inReal, 0.5, inReal2, -2.0, scalar);
+      for (i = 0; i < n; ++i) {
+         ref[i] = inReal[i]*0.5 - inReal2[i]*2.0 + scalar;
+      }
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::addEqVVc(outReal, inReal, inReal2, 4.0);
+      for (i = 0; i < n; ++i) ref[i] += inReal[i]*inReal2[i]*4.0;
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::expVc(outReal, inReal, -0.25);
+      for (i = 0; i < n; ++i) ref[i] = exp(-0.25*inReal[i]);
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::addVVcVVc(outReal, inReal, inReal2, 4.0/3.0,
+                       inReal2, inReal2, -1.0/3.0);
+      for (i = 0; i < n; ++i) {
+         ref[i] = inReal[i]*inReal2[i]*4.0/3.0
+                - inReal2[i]*inReal2[i]/3.0;
+      }
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+
+      VecOp::addVVcVVcVVc(outReal, inReal, inReal2, 64.0/45.0,
+                          inReal2, inReal2, -20.0/45.0,
+                          inReal, inReal, 1.0/45.0);
+      for (i = 0; i < n; ++i) {
+         ref[i] = inReal[i]*inReal2[i]*64.0/45.0
+                - inReal2[i]*inReal2[i]*20.0/45.0
+                + inReal[i]*inReal[i]/45.0;
+      }
+      TEST_ASSERT(maxDiff(ref) < tolerance_);
+   }
+
+   void testReduce()
+   {
+      printMethod(TEST_FUNC);
+
+      double sum = 0.0;
+      double product = 0.0;
+      double max = inReal[0];
+      double min = inReal[0];
+      double maxAbs = std::abs(inReal[0]);
+      double minAbs = std::abs(inReal[0]);
+      for (int i = 0; i < n; ++i) {
+         sum += inReal[i];
+         product += inReal[i]*inReal2[i];
+         max = std::max(max, inReal[i]);
+         min = std::min(min, inReal[i]);
+         maxAbs = std::max(maxAbs, std::abs(inReal[i]));
+         minAbs = std::min(minAbs, std::abs(inReal[i]));
+      }
+      TEST_ASSERT(std::abs(Reduce::sum(inReal) - sum) < tolerance_);
+      TEST_ASSERT(std::abs(Reduce::innerProduct(inReal, inReal2)
+                           - product) < tolerance_);
+      TEST_ASSERT(Reduce::max(inReal) == max);
+      TEST_ASSERT(Reduce::min(inReal) == min);
+      TEST_ASSERT(Reduce::maxAbs(inReal) == maxAbs);
+      TEST_ASSERT(Reduce::minAbs(inReal) == minAbs);
+   }
+
+};
+
+TEST_BEGIN(CpuVecOpTest)
+TEST_ADD(CpuVecOpTest, testElementwise)
+TEST_ADD(CpuVecOpTest, testSlice)
+TEST_ADD(CpuVecOpTest, testMisc)
+TEST_ADD(CpuVecOpTest, testReduce)
+TEST_END(CpuVecOpTest)
+
+#endif
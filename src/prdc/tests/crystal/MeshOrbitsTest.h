@@ -0,0 +1,124 @@
+#ifndef PRDC_MESH_ORBITS_TEST_H
+#define PRDC_MESH_ORBITS_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <prdc/crystal/MeshOrbits.h>
+#include <prdc/crystal/SpaceGroup.h>
+#include <pscf/mesh/Mesh.h>
+#include <pscf/mesh/MeshIterator.h>
+
+#include <util/containers/DArray.h>
+
+#include <iostream>
+#include <fstream>
+
+using namespace Util;
+using namespace Pscf;
+using namespace Pscf::Prdc;
+
+class MeshOrbitsTest : public UnitTest 
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}
+
+   void test2DSquare()
+   {
+      printMethod(TEST_FUNC);
+
+      IntVec<2> d;
+      d[0] = 8;
+      d[1] = 8;
+      Mesh<2> mesh(d);
+
+      SpaceGroup<2> group;
+      std::ifstream in;
+      openInputFile("in/p_4_m_m", in);
+      in >> group;
+      in.close();
+
+      MeshOrbits<2> orbits;
+      orbits.makeOrbits(mesh, group);
+      TEST_ASSERT(orbits.isInitialized());
+      TEST_ASSERT(orbits.meshSize() == 64);
+
+      // Asymmetric unit of p4mm on an 8x8 mesh: 0 <= y <= x <= 4
+      TEST_ASSERT(orbits.nOrbit() == 15);
+
+      // Orbit sizes sum to the number of nodes
+      int sum = 0;
+      for (int i = 0; i < orbits.nOrbit(); ++i) {
+         sum += orbits.orbitSize(i);
+         TEST_ASSERT(orbits.orbitId(orbits.representative(i)) == i);
+      }
+      TEST_ASSERT(sum == mesh.size());
+
+      // Nodes related by mirror x -> -x belong to the same orbit
+      IntVec<2> p, q;
+      p[0] = 3;
+      p[1] = 1;
+      q[0] = 5;
+      q[1] = 1;
+      TEST_ASSERT(orbits.orbitId(mesh.rank(p)) 
+                  == orbits.orbitId(mesh.rank(q)));
+   }
+
+   void test3DGyroid()
+   {
+      printMethod(TEST_FUNC);
+
+      IntVec<3> d;
+      d[0] = 16;
+      d[1] = 16;
+      d[2] = 16;
+      Mesh<3> mesh(d);
+
+      SpaceGroup<3> group;
+      std::ifstream in;
+      openInputFile("in/I_a_-3_d", in);
+      in >> group;
+      in.close();
+
+      MeshOrbits<3> orbits;
+      orbits.makeOrbits(mesh, group);
+      TEST_ASSERT(orbits.isInitialized());
+
+      // Every orbit size divides the group order
+      int sum = 0;
+      for (int i = 0; i < orbits.nOrbit(); ++i) {
+         TEST_ASSERT(group.size() % orbits.orbitSize(i) == 0);
+         sum += orbits.orbitSize(i);
+      }
+      TEST_ASSERT(sum == mesh.size());
+      TEST_ASSERT(orbits.nOrbit() < mesh.size()/32);
+
+      // Round trip of a function that is constant on each orbit
+      DArray<double> full, full2, reduced;
+      full.allocate(mesh.size());
+      full2.allocate(mesh.size());
+      reduced.allocate(orbits.nOrbit());
+      for (int i = 0; i < mesh.size(); ++i) {
+         full[i] = 1.0 + 0.01*double(orbits.orbitId(i));
+      }
+      orbits.reduce(full, reduced);
+      orbits.expand(reduced, full2);
+      for (int i = 0; i < mesh.size(); ++i) {
+         TEST_ASSERT(eq(full[i], full2[i]));
+      }
+   }
+
+};
+
+TEST_BEGIN(MeshOrbitsTest)
+TEST_ADD(MeshOrbitsTest, test2DSquare)
+TEST_ADD(MeshOrbitsTest, test3DGyroid)
+TEST_END(MeshOrbitsTest)
+
+#endif
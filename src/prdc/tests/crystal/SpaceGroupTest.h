@@ -313,6 +313,59 @@ public:
 
    }
 
+   void test3DmeshDivisors() 
+   {
+      printMethod(TEST_FUNC);
+
+      std::ifstream in;
+      IntVec<3> divisors;
+      IntVec<3> dimensions;
+
+      // Translations of I a -3 d are multiples of 1/4
+      SpaceGroup<3> g1;
+      openInputFile("in/I_a_-3_d", in);
+      in >> g1;
+      in.close();
+      divisors = g1.meshDivisors();
+      for (int i = 0; i < 3; ++i) {
+         TEST_ASSERT(divisors[i] == 4);
+         dimensions[i] = 24;
+      }
+      g1.checkMeshDimensions(dimensions);
+
+      // Translations of F d -3 m (setting 1) are multiples of 1/4
+      SpaceGroup<3> g2;
+      openInputFile("in/F_d_-3_m:1", in);
+      in >> g2;
+      in.close();
+      divisors = g2.meshDivisors();
+      for (int i = 0; i < 3; ++i) {
+         TEST_ASSERT(divisors[i] == 4);
+      }
+      g2.checkMeshDimensions(dimensions);
+   }
+
+   void test3DmirrorPlanes() 
+   {
+      printMethod(TEST_FUNC);
+
+      std::ifstream in;
+
+      // Im-3m (BCC) contains reflections through the origin along each axis
+      SpaceGroup<3> g1;
+      openInputFile("in/I_m_-3_m", in);
+      in >> g1;
+      in.close();
+      TEST_ASSERT(g1.hasMirrorPlanes());
+
+      // Ia-3d (gyroid) is centrosymmetric but has no such mirror planes
+      SpaceGroup<3> g2;
+      openInputFile("in/I_a_-3_d", in);
+      in >> g2;
+      in.close();
+      TEST_ASSERT(!g2.hasMirrorPlanes());
+   }
+
 };
 
 TEST_BEGIN(SpaceGroupTest)
@@ -324,6 +377,8 @@ TEST_ADD(SpaceGroupTest, test3Dmake)
 TEST_ADD(SpaceGroupTest, test2Dread)
 TEST_ADD(SpaceGroupTest, test3D_I_a_3b_d) 
 TEST_ADD(SpaceGroupTest, test3D_F_d_3b_m) 
+TEST_ADD(SpaceGroupTest, test3DmeshDivisors) 
+TEST_ADD(SpaceGroupTest, test3DmirrorPlanes) 
 TEST_END(SpaceGroupTest)
 
 #endif
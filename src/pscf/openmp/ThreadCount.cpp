@@ -0,0 +1,64 @@
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "ThreadCount.h"
+#include <util/global.h>
+#include <util/misc/Log.h>
+
+#ifdef PSCF_OPENMP
+#include <omp.h>
+#endif
+
+using namespace Util;
+
+namespace Pscf {
+namespace ThreadCount {
+
+   /*
+   * Set the number of OpenMP threads.
+   */
+   void setNThread(int nThread)
+   {
+      if (nThread <= 0) {
+         UTIL_THROW("Non-positive number of threads");
+      }
+      #ifdef PSCF_OPENMP
+      omp_set_num_threads(nThread);
+      #else
+      if (nThread > 1) {
+         Log::file() << "Warning: OpenMP is not enabled, "
+                     << "thread count ignored" << std::endl;
+      }
+      #endif
+   }
+
+   /*
+   * Get the number of OpenMP threads.
+   */
+   int nThread()
+   {
+      #ifdef PSCF_OPENMP
+      return omp_get_max_threads();
+      #else
+      return 1;
+      #endif
+   }
+
+   /*
+   * Is OpenMP enabled?
+   */
+   bool isEnabled()
+   {
+      #ifdef PSCF_OPENMP
+      return true;
+      #else
+      return false;
+      #endif
+   }
+
+}
+}
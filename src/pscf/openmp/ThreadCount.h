@@ -0,0 +1,53 @@
+#ifndef PSCF_THREAD_COUNT_H
+#define PSCF_THREAD_COUNT_H
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+namespace Pscf {
+
+/**
+* Global functions to control the number of CPU (OpenMP) threads.
+*
+* These functions are compiled in all builds. If the package is compiled
+* with OpenMP disabled (i.e., if the preprocessor macro PSCF_OPENMP is
+* not defined), setNThread has no effect other than printing a warning, 
+* and nThread() always returns 1.
+*/
+namespace ThreadCount {
+
+   /**
+   * \defgroup Pscf_OpenMp_ThreadCount_Module ThreadCount
+   *
+   * Control of the number of threads used by multithreaded CPU code.
+   *
+   * \ingroup Pscf_OpenMp_Module
+   * @{
+   */
+
+   /**
+   * Set the number of threads used by subsequent parallel regions.
+   *
+   * \param nThread  requested number of threads (must be positive)
+   */
+   void setNThread(int nThread);
+
+   /**
+   * Get the number of threads that will be used by parallel regions.
+   */
+   int nThread();
+
+   /**
+   * Was the package compiled with OpenMP multithreading enabled?
+   */
+   bool isEnabled();
+
+   /** @} */
+
+}
+}
+#endif
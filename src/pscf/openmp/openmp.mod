@@ -0,0 +1,11 @@
+namespace Pscf {
+
+   /**
+   * \defgroup Pscf_OpenMp_Module OpenMP Utilities
+   *
+   * Utility functions for multithreaded CPU programs.
+   *
+   * \ingroup Pscf_Base_Module
+   */
+
+}
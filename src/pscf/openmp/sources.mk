@@ -0,0 +1,6 @@
+pscf_openmp_= \
+  pscf/openmp/ThreadCount.cpp 
+
+pscf_openmp_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(pscf_openmp_:.cpp=.o))
+
@@ -57,7 +57,7 @@ $(BLD_DIR)/%.o: $(SRC_DIR)/%.cu
 # Pattern rule to compile Test programs in src/pscf/tests
 $(BLD_DIR)/%Test: $(BLD_DIR)/%Test.o $(PSCF_LIBS)
 ifdef PSCF_CUDA
-	$(NVXX) $(LDFLAGS) -o $@ $< $(LIBS)
+	$(NVXX) $(NVXX_LDFLAGS) -o $@ $< $(LIBS)
 else
 	$(CXX) $(LDFLAGS) -o $@ $< $(LIBS)
 endif
@@ -15,8 +15,12 @@
 #include <pscf/chem/Vertex.h>           
 #include <pscf/chem/PolymerType.h>       
 #include <util/containers/Pair.h>       
+#include <util/containers/GArray.h>       
 
+#include <algorithm>
 #include <cmath>
+#include <exception>
+#include <functional>
 
 namespace Pscf
 {
@@ -98,10 +102,91 @@ namespace Pscf
       * involving a mask that excludes material from part of the unit
       * cell, as for thin film problems. 
       *
+      * If parallel solution has been enabled by setParallelSolve(true)
+      * and the program is compiled with OpenMP, propagators are instead
+      * solved concurrently by a team of threads, each of which takes the
+      * next propagator for which all sources have been solved. See the
+      * setParallelSolve function for restrictions.
+      *
+      * If sharing of identical propagators has been enabled by 
+      * setShareIdentical(true), only one propagator of each set of 
+      * identical propagators is solved, and concentrations are only
+      * computed for one block of each set of identical blocks. See
+      * the setShareIdentical function.
+      *
       * \param phiTot  fraction of unit cell volume occupied by material
       */
       virtual void solve(double phiTot = 1.0);
 
+      /**
+      * Enable or disable concurrent solution of propagators.
+      *
+      * If enabled, propagators that do not depend on one another are 
+      * solved concurrently by different OpenMP threads. The two 
+      * propagators of one block are never solved at the same time, 
+      * because they share work space owned by the Block. The Block 
+      * class must otherwise allow propagators of different blocks to
+      * be solved concurrently, and concentrations of different blocks
+      * to be computed concurrently. This is disabled by default, and 
+      * has no effect if the program is compiled without OpenMP.
+      *
+      * \param parallelSolve  true to enable, false to disable
+      */
+      void setParallelSolve(bool parallelSolve);
+
+      /**
+      * Is concurrent solution of propagators enabled?
+      */
+      bool parallelSolve() const;
+
+      /**
+      * Enable or disable sharing of identical propagators.
+      *
+      * Two propagators are identical if their blocks have the same 
+      * monomer type, length and number of contour steps, and if their
+      * sources are identical in pairs, as is the case for equivalent 
+      * arms of a star polymer or equivalent side chains of a 
+      * bottlebrush. This also detects the reversal symmetry of 
+      * symmetric linear polymers: the two end blocks of an ABA triblock
+      * have identical propagators, and the two propagators of its 
+      * middle block (or of a homopolymer) are identical to one another.
+      * Identical propagators are identified at the beginning of each 
+      * call to solve(), before the first step. The MDE is then solved 
+      * only for the first propagator of each set of identical 
+      * propagators in the order of the computation plan. Each other 
+      * member of the set is marked as solved, and is given a pointer to
+      * the one that was solved via PropagatorTmpl::setIdentical. 
+      * Concentrations are only computed for the first block of each set
+      * of blocks with pairwise identical propagators, and are copied to
+      * the others.
+      *
+      * This requires that the concrete Propagator class returns the 
+      * slices of the identical propagator if one is set, and it must 
+      * therefore only be enabled for implementations that support it.
+      * It is disabled by default.
+      *
+      * \param shareIdentical  true to enable, false to disable
+      */
+      void setShareIdentical(bool shareIdentical);
+
+      /**
+      * Is sharing of identical propagators enabled?
+      */
+      bool shareIdentical() const;
+
+      /**
+      * Get the index of the first block identical to a specified block.
+      *
+      * Returns the index of the first block with a pair of propagators
+      * that are identical to those of block blockId, as determined in 
+      * the most recent call to solve(), or blockId itself if there is 
+      * no such block or if sharing is disabled. The concentration field
+      * and stress of a block are the same as those of this block. 
+      *
+      * \param blockId  index of a block
+      */
+      int identicalBlockId(int blockId) const;
+
       /// \name Accessors (objects, by reference)
       ///@{
 
@@ -204,6 +289,33 @@ namespace Pscf
       /// Array of Block objects in this polymer.
       DArray<Block> blocks_;
 
+      /// Plan index of first identical propagator, for each propagator.
+      DArray<int> identicalIds_;
+
+      /// Index of first identical block, for each block.
+      DArray<int> identicalBlockIds_;
+
+      /// Should propagators be solved concurrently?
+      bool parallelSolve_;
+
+      /// Should identical propagators be shared?
+      bool shareIdentical_;
+
+      /**
+      * Solve all propagators concurrently, respecting dependencies.
+      */
+      void solvePropagatorsParallel();
+
+      /**
+      * Identify identical propagators and blocks, set associations.
+      */
+      void findIdenticalPropagators();
+
+      /**
+      * Clear all associations between identical propagators.
+      */
+      void clearIdenticalPropagators();
+
    };
 
    /*
@@ -266,6 +378,33 @@ namespace Pscf
       return propagator(propId[0], propId[1]);
    }
 
+   /*
+   * Is concurrent solution of propagators enabled?
+   */
+   template <class Block>
+   inline bool PolymerTmpl<Block>::parallelSolve() const
+   {  return parallelSolve_; }
+
+   /*
+   * Is sharing of identical propagators enabled?
+   */
+   template <class Block>
+   inline bool PolymerTmpl<Block>::shareIdentical() const
+   {  return shareIdentical_; }
+
+   /*
+   * Get the index of the first block identical to a specified block.
+   */
+   template <class Block>
+   inline int PolymerTmpl<Block>::identicalBlockId(int blockId) const
+   {
+      if (shareIdentical_ && identicalBlockIds_.isAllocated()) {
+         return identicalBlockIds_[blockId];
+      } else {
+         return blockId;
+      }
+   }
+
    // Non-inline functions
 
    /*
@@ -274,7 +413,11 @@ namespace Pscf
    template <class Block>
    PolymerTmpl<Block>::PolymerTmpl()
     : PolymerSpecies(),
-      blocks_() 
+      blocks_(),
+      identicalIds_(),
+      identicalBlockIds_(),
+      parallelSolve_(false),
+      shareIdentical_(false)
    {  setClassName("PolymerTmpl"); }
 
    /*
@@ -338,11 +481,27 @@ namespace Pscf
          propagator(j).setIsSolved(false);
       }
 
-      // Solve modified diffusion equation for all propagators in
-      // the order specified by function makePlan.
-      for (int j = 0; j < nPropagator(); ++j) {
-         UTIL_CHECK(propagator(j).isReady());
-         propagator(j).solve();
+      // Identify identical propagators, if enabled
+      if (shareIdentical_) {
+         findIdenticalPropagators();
+      }
+
+      if (parallelSolve_) {
+         // Solve MDE for independent propagators concurrently
+         solvePropagatorsParallel();
+      } else {
+         // Solve modified diffusion equation for all propagators in
+         // the order specified by function makePlan. Propagators with
+         // an identical predecessor are only marked as solved.
+         for (int j = 0; j < nPropagator(); ++j) {
+            UTIL_CHECK(propagator(j).isReady());
+            if (propagator(j).hasIdentical()) {
+               UTIL_CHECK(propagator(j).identical().isSolved());
+               propagator(j).setIsSolved(true);
+            } else {
+               propagator(j).solve();
+            }
+         }
       }
 
       // Compute molecular partition function q_
@@ -360,12 +519,330 @@ namespace Pscf
          phi_ = exp(mu_)*q_;
       }
 
-      // Compute block concentration fields
+      // Compute block concentration fields. An Exception thrown within
+      // the parallel loop is caught, and rethrown after the loop.
       double prefactor = phi_ / ( q_ * length() );
+      int nb = nBlock();
+      std::exception_ptr error = nullptr;
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for schedule(dynamic,1) if (parallelSolve_)
+      #endif
+      for (int i = 0; i < nb; ++i) {
+         if (identicalBlockId(i) == i) {
+            try {
+               block(i).computeConcentration(prefactor);
+            } catch (...) {
+               #ifdef PSCF_OPENMP
+               #pragma omp critical (pscf_polymer_solve)
+               #endif
+               {
+                  if (!error) error = std::current_exception();
+               }
+            }
+         }
+      }
+      if (error) {
+         std::rethrow_exception(error);
+      }
+
+      // Copy concentrations of blocks with identical propagators
+      if (shareIdentical_) {
+         int r;
+         for (int i = 0; i < nb; ++i) {
+            r = identicalBlockId(i);
+            if (r != i) {
+               block(i).cField() = block(r).cField();
+            }
+         }
+      }
+   }
+
+   /*
+   * Enable or disable concurrent solution of propagators.
+   */
+   template <class Block>
+   void PolymerTmpl<Block>::setParallelSolve(bool parallelSolve)
+   {  parallelSolve_ = parallelSolve; }
+
+   /*
+   * Enable or disable sharing of identical propagators.
+   */
+   template <class Block>
+   void PolymerTmpl<Block>::setShareIdentical(bool shareIdentical)
+   {
+      shareIdentical_ = shareIdentical;
+      if (!shareIdentical_) {
+         clearIdenticalPropagators();
+      }
+   }
+
+   /*
+   * Identify identical propagators and blocks.
+   *
+   * Propagators are visited in the order of the computation plan, in
+   * which every propagator appears after all of its sources. Each is
+   * assigned to a class labelled by the plan index of its first member.
+   * A propagator belongs to an existing class if its block has the same
+   * monomer type, length and number of contour grid points as that of 
+   * the first member, and if the sorted list of class labels of its 
+   * sources is the same.
+   */
+   template <class Block>
+   void PolymerTmpl<Block>::findIdenticalPropagators()
+   {
+      int np = nPropagator();
+      int nb = nBlock();
+      if (!identicalIds_.isAllocated()) {
+         identicalIds_.allocate(np);
+         identicalBlockIds_.allocate(nb);
+      }
+      UTIL_CHECK(identicalIds_.capacity() == np);
+      UTIL_CHECK(identicalBlockIds_.capacity() == nb);
+
+      // Map (blockId, directionId) -> index in computation plan
+      DArray<int> planId;
+      planId.allocate(2*nb);
+      Pair<int> propId;
+      int j, k, r;
+      for (j = 0; j < np; ++j) {
+         propId = propagatorId(j);
+         planId[2*propId[0] + propId[1]] = j;
+      }
+
+      // Sorted class labels of sources, and class of each propagator
+      DArray< GArray<int> > sourceIds;
+      sourceIds.allocate(np);
+      int blockId, directionId, vertexId, ns;
+      for (j = 0; j < np; ++j) {
+         propId = propagatorId(j);
+         blockId = propId[0];
+         directionId = propId[1];
+         vertexId = block(blockId).vertexId(directionId);
+         Vertex const & v = vertex(vertexId);
+         GArray<int>& sources = sourceIds[j];
+         for (k = 0; k < v.size(); ++k) {
+            Pair<int> const & inId = v.inPropagatorId(k);
+            if (inId[0] != blockId) {
+               sources.append(identicalIds_[planId[2*inId[0] + inId[1]]]);
+            }
+         }
+         ns = sources.size();
+         if (ns > 1) {
+            std::sort(&sources[0], &sources[0] + ns);
+         }
+
+         // Search for an identical predecessor
+         identicalIds_[j] = j;
+         for (r = 0; r < j; ++r) {
+            if (identicalIds_[r] != r) continue;
+            Pair<int> const & rId = propagatorId(r);
+            Block const & rBlock = block(rId[0]);
+            if (rBlock.monomerId() != block(blockId).monomerId()) continue;
+            if (rBlock.length() != block(blockId).length()) continue;
+            if (rBlock.ns() != block(blockId).ns()) continue;
+            if (sourceIds[r].size() != ns) continue;
+            bool match = true;
+            for (k = 0; k < ns; ++k) {
+               if (sourceIds[r][k] != sources[k]) {
+                  match = false;
+                  break;
+               }
+            }
+            if (match) {
+               identicalIds_[j] = r;
+               break;
+            }
+         }
+
+         // Set or clear association with identical propagator
+         r = identicalIds_[j];
+         if (r != j) {
+            propagator(j).setIdentical(&propagator(r));
+         } else {
+            propagator(j).setIdentical(0);
+         }
+      }
+
+      // Identify blocks with pairwise identical propagators
+      int a, b, ra, rb;
+      for (blockId = 0; blockId < nb; ++blockId) {
+         identicalBlockIds_[blockId] = blockId;
+         a = identicalIds_[planId[2*blockId]];
+         b = identicalIds_[planId[2*blockId + 1]];
+         for (k = 0; k < blockId; ++k) {
+            if (identicalBlockIds_[k] != k) continue;
+            ra = identicalIds_[planId[2*k]];
+            rb = identicalIds_[planId[2*k + 1]];
+            if ((a == ra && b == rb) || (a == rb && b == ra)) {
+               identicalBlockIds_[blockId] = k;
+               break;
+            }
+         }
+      }
+
+   }
+
+   /*
+   * Clear all associations between identical propagators.
+   */
+   template <class Block>
+   void PolymerTmpl<Block>::clearIdenticalPropagators()
+   {
+      if (!identicalIds_.isAllocated()) return;
+      for (int j = 0; j < nPropagator(); ++j) {
+         propagator(j).setIdentical(0);
+         identicalIds_[j] = j;
+      }
       for (int i = 0; i < nBlock(); ++i) {
-         block(i).computeConcentration(prefactor);
+         identicalBlockIds_[i] = i;
+      }
+   }
+
+   /*
+   * Solve all propagators, concurrently where dependencies allow.
+   *
+   * Each propagator is solved by an OpenMP task. A task is created for 
+   * a propagator when all of its sources have been solved and the 
+   * partner propagator (of the same block) is not being solved. Tasks 
+   * for propagators that are initially ready are created by one thread, 
+   * and each task creates tasks for propagators that become ready when 
+   * it completes. Threads with no work wait for tasks at the implicit 
+   * barrier. The status array is only read and modified within a named 
+   * critical section. An Exception thrown while solving a propagator 
+   * is caught within the parallel region, prevents creation of further 
+   * tasks, and is rethrown after the parallel region ends.
+   */
+   template <class Block>
+   void PolymerTmpl<Block>::solvePropagatorsParallel()
+   {
+      int np = nPropagator();
+      int nb = nBlock();
+
+      // Map (blockId, directionId) -> index in computation plan
+      DArray<int> planId;
+      planId.allocate(2*nb);
+      Pair<int> propId;
+      int j, k;
+      for (j = 0; j < np; ++j) {
+         propId = propagatorId(j);
+         planId[2*propId[0] + propId[1]] = j;
+      }
+
+      // Plan indices of sources of each propagator
+      DArray< GArray<int> > sourceIds;
+      sourceIds.allocate(np);
+      int blockId, directionId, vertexId;
+      for (j = 0; j < np; ++j) {
+         propId = propagatorId(j);
+         blockId = propId[0];
+         directionId = propId[1];
+         if (shareIdentical_ && identicalIds_[j] != j) {
+            // Only depends on the identical propagator
+            sourceIds[j].append(identicalIds_[j]);
+            continue;
+         }
+         vertexId = block(blockId).vertexId(directionId);
+         Vertex const & v = vertex(vertexId);
+         for (k = 0; k < v.size(); ++k) {
+            Pair<int> const & inId = v.inPropagatorId(k);
+            if (inId[0] != blockId) {
+               sourceIds[j].append(planId[2*inId[0] + inId[1]]);
+            }
+         }
       }
 
+      // Status of each propagator: 0 = waiting, 1 = running, 2 = solved
+      DArray<int> status;
+      status.allocate(np);
+      for (j = 0; j < np; ++j) {
+         status[j] = 0;
+      }
+
+      // First exception thrown by any task, if any
+      std::exception_ptr error = nullptr;
+
+      // Mark all ready propagators as running, append them to ready.
+      // Must be called within the critical section.
+      auto claimReady = [&](GArray<int>& ready) 
+      {
+         for (int i = 0; i < np; ++i) {
+            if (status[i] != 0) continue;
+            Pair<int> id = propagatorId(i);
+            if (status[planId[2*id[0] + 1 - id[1]]] == 1) continue;
+            bool isReady = true;
+            for (int m = 0; m < sourceIds[i].size(); ++m) {
+               if (status[sourceIds[i][m]] != 2) {
+                  isReady = false;
+                  break;
+               }
+            }
+            if (isReady) {
+               status[i] = 1;
+               ready.append(i);
+            }
+         }
+      };
+
+      // Solve propagator i, then create tasks for newly ready ones
+      std::function<void(int)> solveTask;
+      solveTask = [&](int i)
+      {
+         try {
+            if (propagator(i).hasIdentical()) {
+               propagator(i).setIsSolved(true);
+            } else {
+               propagator(i).solve();
+            }
+         } catch (...) {
+            #ifdef PSCF_OPENMP
+            #pragma omp critical (pscf_polymer_solve)
+            #endif
+            {
+               if (!error) error = std::current_exception();
+            }
+         }
+         GArray<int> ready;
+         #ifdef PSCF_OPENMP
+         #pragma omp critical (pscf_polymer_solve)
+         #endif
+         {
+            status[i] = 2;
+            if (!error) claimReady(ready);
+         }
+         for (int m = 0; m < ready.size(); ++m) {
+            int r = ready[m];
+            #ifdef PSCF_OPENMP
+            #pragma omp task firstprivate(r)
+            #endif
+            solveTask(r);
+         }
+      };
+
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel
+      #pragma omp single
+      #endif
+      {
+         GArray<int> ready;
+         claimReady(ready);
+         for (int m = 0; m < ready.size(); ++m) {
+            int r = ready[m];
+            #ifdef PSCF_OPENMP
+            #pragma omp task firstprivate(r)
+            #endif
+            solveTask(r);
+         }
+      }
+
+      // Rethrow any exception thrown within the parallel region
+      if (error) {
+         std::rethrow_exception(error);
+      }
+
+      // Check that all propagators have been solved
+      for (j = 0; j < np; ++j) {
+         UTIL_CHECK(propagator(j).isSolved());
+      }
    }
 
 }
@@ -133,6 +133,20 @@ namespace Pscf
       * Set the isSolved flag to true or false.
       */
       void setIsSolved(bool isSolved);
+
+      /**
+      * Set or clear an identical propagator.
+      *
+      * An identical propagator is another propagator of the same polymer
+      * that is known to have the same solution as this one. If one is
+      * set, the MDE is not solved for this propagator, and a concrete
+      * propagator class that supports this feature instead returns the
+      * slices of the identical propagator. Passing a null pointer 
+      * clears this association. 
+      *
+      * \param identicalPtr  pointer to identical propagator, or null
+      */
+      void setIdentical(TP const * identicalPtr);
  
       ///@}
       /// \name Accessors
@@ -165,6 +179,16 @@ namespace Pscf
       */
       bool hasPartner() const;
 
+      /**
+      * Has an identical propagator been set?
+      */
+      bool hasIdentical() const;
+
+      /**
+      * Get the identical propagator, if any.
+      */
+      const TP& identical() const;
+
       /**
       * Has the modified diffusion equation been solved?
       */
@@ -188,6 +212,9 @@ namespace Pscf
       /// Pointers to propagators that feed source vertex.
       GArray<TP const *> sourcePtrs_;
 
+      /// Pointer to identical propagator, if any (null otherwise).
+      TP const * identicalPtr_;
+
       /// Set true after solving modified diffusion equation.
       bool isSolved_;
   
@@ -225,6 +252,25 @@ namespace Pscf
    bool PropagatorTmpl<TP>::hasPartner() const
    {  return partnerPtr_; }
 
+   /*
+   * Has an identical propagator been set?
+   */
+   template <class TP>
+   inline
+   bool PropagatorTmpl<TP>::hasIdentical() const
+   {  return identicalPtr_; }
+
+   /*
+   * Get the identical propagator.
+   */
+   template <class TP>
+   inline 
+   const TP& PropagatorTmpl<TP>::identical() const
+   {
+      UTIL_ASSERT(identicalPtr_);
+      return *identicalPtr_;
+   }
+
    /*
    * Is the computation of this propagator completed?
    */
@@ -242,6 +288,7 @@ namespace Pscf
     : directionId_(-1),
       partnerPtr_(0),
       sourcePtrs_(),
+      identicalPtr_(0),
       isSolved_(false)
    {}
 
@@ -284,6 +331,13 @@ namespace Pscf
    void PropagatorTmpl<TP>::setIsSolved(bool isSolved)
    {  isSolved_ = isSolved; }
 
+   /*
+   * Set or clear the identical propagator.
+   */
+   template <class TP>
+   void PropagatorTmpl<TP>::setIdentical(TP const * identicalPtr)
+   {  identicalPtr_ = identicalPtr; }
+
    /*
    * Check if all source propagators are marked completed.
    */
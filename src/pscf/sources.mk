@@ -9,13 +9,14 @@ include $(SRC_DIR)/pscf/mesh/sources.mk
 include $(SRC_DIR)/pscf/homogeneous/sources.mk
 include $(SRC_DIR)/pscf/iterator/sources.mk
 include $(SRC_DIR)/pscf/sweep/sources.mk
+include $(SRC_DIR)/pscf/openmp/sources.mk
 
 # CPP source files
 
 pscf_CPP= \
   $(pscf_chem_) $(pscf_inter_) $(pscf_math_) \
   $(pscf_mesh_) $(pscf_crystal_) $(pscf_homogeneous_) \
-  $(pscf_iterator_) $(pscf_sweep_)
+  $(pscf_iterator_) $(pscf_sweep_) $(pscf_openmp_)
 
 pscf_CPP_OBJS=\
     $(addprefix $(BLD_DIR)/, $(pscf_CPP:.cpp=.o))
@@ -354,7 +354,9 @@ namespace Rpc {
       * as initial guesses.  On exit, hasCFields is set true whether or 
       * not convergence is obtained to within the desired tolerance.  
       * The Helmholtz free energy and pressure are computed only if
-      * convergence is obtained.
+      * convergence is obtained. If the mixture uses adaptive contour 
+      * steps (see Mixture::adaptContourSteps), the contour step of each
+      * block is chosen once before iteration, using the initial fields.
       *
       * \pre Function hasIterator() must return true.
       * \pre Function w().hasData() flag must return true.
@@ -367,6 +369,38 @@ namespace Rpc {
       */
       int iterate(bool isContinuation = false);
 
+      /**
+      * Iteratively solve a SCFT problem, starting on coarser meshes.
+      *
+      * This function first solves the SCFT problem on a sequence of up
+      * to nLevel coarser meshes, in order of increasing resolution, and
+      * then calls iterate() to solve the problem on the mesh of this
+      * system. The coarse mesh for level l is obtained by dividing the
+      * number of grid points in each direction by 2^l and rounding down
+      * to an even multiple of the divisor required by the space group
+      * (if any). Coarser levels are omitted if this would give fewer
+      * than 8 grid points in any direction.
+      *
+      * The problem on each coarse mesh is solved by a temporary System
+      * with the same Mixture, Interaction, Domain and Iterator parameter
+      * blocks, except for the mesh dimensions. The w fields are passed
+      * between meshes by spectral resampling (see
+      * FieldIo::resampleFieldRGrid), and the unit cell is passed along
+      * with them. Convergence failure on a coarse mesh is reported but
+      * does not stop the calculation. A mask and external fields of 
+      * this system are resampled onto each coarse mesh in the same way, 
+      * unless they are created by an ImposedFieldsGenerator, in which 
+      * case they are regenerated by the coarse system.
+      *
+      * \pre Function hasIterator() must return true.
+      * \pre Function w().hasData() flag must return true.
+      *
+      * \return returns 0 for successful convergence, 1 for failure.
+      *
+      * \param nLevel  maximum number of coarse meshes
+      */
+      int iterateCoarseToFine(int nLevel);
+
       /**
       * Sweep in parameter space, solving an SCF problem at each point.
       *
@@ -793,6 +827,42 @@ namespace Rpc {
                              const std::string & outFileName,
                              IntVec<D> const & replicas);
 
+      /**
+      * Resample fields in r-grid format onto a mesh of different size.
+      *
+      * This function reads fields in r-grid format from a file, which
+      * must be defined on the mesh of this system, resamples them onto
+      * a mesh with the specified dimensions by zero-padding or truncation
+      * of their Fourier series, and writes the result to a file in r-grid
+      * format. Numbers of grid points may be odd or even. The output
+      * file can be read as an initial guess by a system with the new
+      * mesh.
+      *
+      * \param inFileName name of input field file (r-grid format)
+      * \param outFileName name of output field file (r-grid format)
+      * \param dimensions  numbers of grid points in the output mesh
+      */
+      void resampleRGrid(const std::string & inFileName,
+                         const std::string & outFileName,
+                         IntVec<D> const & dimensions);
+
+      /**
+      * Resample fields in basis format onto a mesh of different size.
+      *
+      * This function reads fields in symmetry-adapted basis format,
+      * converts them to r-grid format on the mesh of this system, and
+      * then resamples and writes them as in resampleRGrid. The output
+      * file is thus in r-grid format. It can be read by a system with
+      * the new mesh whether or not that mesh supports the same basis.
+      *
+      * \param inFileName name of input field file (basis format)
+      * \param outFileName name of output field file (r-grid format)
+      * \param dimensions  numbers of grid points in the output mesh
+      */
+      void resampleBasis(const std::string & inFileName,
+                         const std::string & outFileName,
+                         IntVec<D> const & dimensions);
+
       ///@}
       /// \name Timers
       ///@{
@@ -23,13 +23,18 @@
 
 #include <prdc/cpu/RField.h>
 #include <prdc/cpu/RFieldComparison.h>
+#include <prdc/cpu/FftwSettings.h>
+#include <prdc/cpu/FieldPool.h>
+#include <prdc/cpu/Reduce.h>
 #include <prdc/crystal/BFieldComparison.h>
 
 #include <pscf/inter/Interaction.h>
 #include <pscf/math/IntVec.h>
 #include <pscf/homogeneous/Clump.h>
+#include <pscf/openmp/ThreadCount.h>
 
 #include <util/containers/FSArray.h>
+#include <util/containers/GArray.h>
 #include <util/param/BracketPolicy.h>
 #include <util/param/ParamComponent.h>
 #include <util/format/Str.h>
@@ -37,7 +42,9 @@
 #include <util/format/Dbl.h>
 #include <util/misc/ioUtil.h>
 
+#include <memory>
 #include <string>
+#include <sstream>
 #include <unistd.h>
 
 namespace Pscf {
@@ -119,6 +126,9 @@ namespace Rpc {
       if (simulatorFactoryPtr_) {
          delete simulatorFactoryPtr_;
       }
+
+      // Save FFTW wisdom for any plans created after initialization
+      domain_.exportFftWisdom();
    }
 
    /*
@@ -133,7 +143,7 @@ namespace Rpc {
       bool cFlag = false;  // command file
       bool iFlag = false;  // input prefix
       bool oFlag = false;  // output prefix
-      bool tFlag = false;  // nThread
+      bool tFlag = false;  // nThread (number of OpenMP threads)
       char* pArg = 0;
       char* cArg = 0;
       char* iArg = 0;
@@ -169,7 +179,7 @@ namespace Rpc {
             oFlag = true;
             oArg  = optarg;
             break;
-         case 't':
+         case 't': // number of threads
             tFlag = true;
             tArg = atoi(optarg);
             break;
@@ -215,10 +225,15 @@ namespace Rpc {
          fileMaster_.setOutputPrefix(std::string(oArg));
       }
 
+      // If option -t, set number of OpenMP threads
       if (tFlag) {
          if (tArg <= 0) {
             UTIL_THROW("Error: Non-positive thread count -t option");
          }
+         ThreadCount::setNThread(tArg);
+         FftwSettings::setNThread(tArg);
+         Log::file() << "nThread     " << ThreadCount::nThread() 
+                     << std::endl;
       }
 
    }
@@ -254,6 +269,9 @@ namespace Rpc {
       // Setup  the mixture
       mixture_.associate(domain().mesh(), domain().fft(),
                          domain().unitCell());
+      if (domain().hasGroup()) {
+         mixture_.setSpaceGroup(domain().group());
+      }
       mixture_.allocate();
       mixture_.clearUnitCellData();
 
@@ -296,6 +314,8 @@ namespace Rpc {
       homogeneous_.setNMonomer(nm);
       initHomogeneous();
 
+      // Save FFTW wisdom for plans created by the mixture and blocks
+      domain_.exportFftWisdom();
    }
 
    /*
@@ -370,6 +390,16 @@ namespace Rpc {
                readNext = false;
             }
          } else
+         if (command == "ITERATE_COARSE_TO_FINE") {
+            // Solve a SCFT problem, starting on coarser meshes
+            int nLevel;
+            in >> nLevel;
+            Log::file() << "   "  << nLevel << "\n";
+            int fail = iterateCoarseToFine(nLevel);
+            if (fail) {
+               readNext = false;
+            }
+         } else
          if (command == "SWEEP") {
             // Attempt to solve a sequence of SCFT problems along a path
             // through parameter space
@@ -650,6 +680,22 @@ namespace Rpc {
 
             replicateUnitCell(inFileName, outFileName, replicas);
          } else
+         if (command == "RESAMPLE_RGRID") {
+            readEcho(in, inFileName);
+            readEcho(in, outFileName);
+            IntVec<D> dimensions;
+            in >> dimensions;
+            Log::file() << "   " << dimensions << "\n";
+            resampleRGrid(inFileName, outFileName, dimensions);
+         } else
+         if (command == "RESAMPLE_BASIS") {
+            readEcho(in, inFileName);
+            readEcho(in, outFileName);
+            IntVec<D> dimensions;
+            in >> dimensions;
+            Log::file() << "   " << dimensions << "\n";
+            resampleBasis(inFileName, outFileName, dimensions);
+         } else
          if (command == "READ_H_BASIS") {
             readEcho(in, filename);
             if (!h_.isAllocatedBasis()) {
@@ -945,6 +991,9 @@ namespace Rpc {
       UTIL_CHECK(c_.isAllocatedRGrid());
       UTIL_CHECK(w_.hasData());
 
+      // Symmetric w fields allow reduced storage and grids in the MDE
+      mixture_.setSymmetric(w_.isSymmetric() && domain().hasGroup());
+
       // Solve the modified diffusion equation (without iteration)
       mixture_.compute(w_.rgrid(), c_.rgrid(), mask_.phiTot());
       hasCFields_ = true;
@@ -981,6 +1030,15 @@ namespace Rpc {
       Log::file() << std::endl;
       Log::file() << std::endl;
 
+      // In adaptive mode, choose contour steps for the initial w fields.
+      // The discretization is then fixed while the iterator runs.
+      if (mixture_.dsTolerance() > 0.0 && mixture_.nPolymer() > 0) {
+         mixture_.clearStepErrors();
+         compute();
+         mixture_.adaptContourSteps();
+         hasCFields_ = false;
+      }
+
       // Call iterator (return 0 for convergence, 1 for failure)
       int error = iterator().solve(isContinuation);
       hasCFields_ = true;
@@ -1000,6 +1058,201 @@ namespace Rpc {
       return error;
    }
 
+   /*
+   * Iteratively solve a SCFT problem, starting on coarser meshes.
+   */
+   template <int D>
+   int System<D>::iterateCoarseToFine(int nLevel)
+   {
+      UTIL_CHECK(iteratorPtr_);
+      UTIL_CHECK(w_.hasData());
+      UTIL_CHECK(nLevel >= 0);
+      const bool isSymmetric = iterator().isSymmetric();
+      if (isSymmetric) {
+         UTIL_CHECK(w_.isSymmetric());
+      }
+      const int nMonomer = mixture().nMonomer();
+      IntVec<D> const & dimensions = domain().mesh().dimensions();
+      int i, level;
+
+      // Required divisors of mesh dimensions (even, for FFT efficiency)
+      IntVec<D> divisors;
+      if (domain().hasGroup()) {
+         divisors = domain().group().meshDivisors();
+      } else {
+         for (i = 0; i < D; ++i) {
+            divisors[i] = 1;
+         }
+      }
+      for (i = 0; i < D; ++i) {
+         if (divisors[i] % 2 != 0) divisors[i] *= 2;
+      }
+
+      // Choose coarse meshes, finest first
+      GArray< IntVec<D> > meshes;
+      IntVec<D> coarse;
+      bool isValid;
+      for (level = 1; level <= nLevel; ++level) {
+         isValid = true;
+         for (i = 0; i < D; ++i) {
+            coarse[i] = ((dimensions[i] >> level)/divisors[i])*divisors[i];
+            if (coarse[i] < 8) isValid = false;
+         }
+         if (!isValid) break;
+         if (domain().hasGroup()) {
+            domain().group().checkMeshDimensions(coarse);
+         }
+         meshes.append(coarse);
+      }
+      if (meshes.size() == 0) {
+         return iterate();
+      }
+
+      // Parameter file blocks for systems on coarse meshes
+      std::stringstream paramStream;
+      writeParamNoSweep(paramStream);
+      const std::string paramString = paramStream.str();
+
+      // Solve on coarse meshes, coarsest first. Temporary systems are
+      // owned by sourcePtr (the most recently solved) and coarsePtr, so
+      // they are destroyed if an Exception is thrown.
+      std::unique_ptr< System<D> > sourcePtr;
+      std::unique_ptr< System<D> > coarsePtr;
+      DArray< RField<D> > rFields;
+      DArray< DArray<double> > bFields;
+      rFields.allocate(nMonomer);
+      bFields.allocate(nMonomer);
+      std::string line, label;
+      int error;
+      for (level = meshes.size() - 1; level >= 0; --level) {
+         coarse = meshes[level];
+
+         // Copy parameter file, replacing mesh dimensions
+         std::istringstream paramIn(paramString);
+         std::stringstream coarseParam;
+         bool isDomain = false;
+         bool hasMesh = false;
+         while (std::getline(paramIn, line)) {
+            std::istringstream lineIn(line);
+            label = "";
+            lineIn >> label;
+            if (label == "Domain{") isDomain = true;
+            if (isDomain && !hasMesh && label == "mesh") {
+               coarseParam << line.substr(0, line.find("mesh")) << "mesh";
+               for (i = 0; i < D; ++i) {
+                  coarseParam << "  " << coarse[i];
+               }
+               coarseParam << std::endl;
+               hasMesh = true;
+            } else {
+               coarseParam << line << std::endl;
+            }
+         }
+         UTIL_CHECK(hasMesh);
+
+         // Create and initialize a system on the coarse mesh
+         System<D> const & source = sourcePtr ? *sourcePtr : *this;
+         coarsePtr.reset(new System<D>());
+         coarsePtr->readParam(coarseParam);
+         coarsePtr->setUnitCell(source.domain().unitCell());
+
+         // Resample w fields onto the coarse mesh
+         for (i = 0; i < nMonomer; ++i) {
+            if (rFields[i].isAllocated()) {
+               rFields[i].deallocate();
+            }
+            rFields[i].allocate(coarse);
+         }
+         coarsePtr->domain().fieldIo().resampleFieldsRGrid(
+                                        source.w().rgrid(), rFields);
+         if (isSymmetric) {
+            const int nBasis = coarsePtr->domain().basis().nBasis();
+            for (i = 0; i < nMonomer; ++i) {
+               if (bFields[i].isAllocated()) {
+                  bFields[i].deallocate();
+               }
+               bFields[i].allocate(nBasis);
+            }
+            coarsePtr->domain().fieldIo().convertRGridToBasis(rFields,
+                                                              bFields);
+            coarsePtr->setWBasis(bFields);
+         } else {
+            coarsePtr->setWRGrid(rFields);
+         }
+
+         // Resample any mask and external fields of this system. Those
+         // created by an ImposedFieldsGenerator are instead regenerated
+         // by the iterator of the coarse system.
+         FieldIo<D> const & coarseIo = coarsePtr->domain().fieldIo();
+         if (hasMask()) {
+            Mask<D>& coarseMask = coarsePtr->mask();
+            RField<D> maskField;
+            maskField.allocate(coarse);
+            coarseIo.resampleFieldRGrid(mask().rgrid(), maskField);
+            if (!coarseMask.isAllocatedRGrid()) {
+               coarseMask.allocateRGrid(coarse);
+            }
+            if (mask().isSymmetric() && !coarseMask.isAllocatedBasis()) {
+               coarseMask.allocateBasis(
+                               coarsePtr->domain().basis().nBasis());
+            }
+            coarseMask.setRGrid(maskField, mask().isSymmetric());
+         }
+         if (hasExternalFields()) {
+            WFieldContainer<D>& coarseH = coarsePtr->h();
+            coarseIo.resampleFieldsRGrid(h().rgrid(), rFields);
+            if (!coarseH.isAllocatedRGrid()) {
+               coarseH.allocateRGrid(coarse);
+            }
+            if (h().isSymmetric() && !coarseH.isAllocatedBasis()) {
+               coarseH.allocateBasis(coarsePtr->domain().basis().nBasis());
+            }
+            coarseH.setRGrid(rFields, h().isSymmetric());
+         }
+         sourcePtr = std::move(coarsePtr);
+
+         // Iterate on the coarse mesh
+         Log::file() << std::endl;
+         Log::file() << "Coarse mesh:";
+         for (i = 0; i < D; ++i) {
+            Log::file() << "  " << coarse[i];
+         }
+         Log::file() << std::endl;
+         error = sourcePtr->iterate();
+         if (error) {
+            Log::file() << "Iteration on coarse mesh failed to converge"
+                        << std::endl;
+         }
+      }
+
+      // Resample w fields onto the mesh of this system
+      setUnitCell(sourcePtr->domain().unitCell());
+      for (i = 0; i < nMonomer; ++i) {
+         rFields[i].deallocate();
+         rFields[i].allocate(dimensions);
+      }
+      domain().fieldIo().resampleFieldsRGrid(sourcePtr->w().rgrid(),
+                                             rFields);
+      sourcePtr.reset();
+
+      // Free pooled memory released by the coarse systems. Blocks sized
+      // for coarse meshes would otherwise never be reused.
+      FieldPool::clear();
+      if (isSymmetric) {
+         const int nBasis = domain().basis().nBasis();
+         for (i = 0; i < nMonomer; ++i) {
+            bFields[i].deallocate();
+            bFields[i].allocate(nBasis);
+         }
+         domain().fieldIo().convertRGridToBasis(rFields, bFields);
+         setWBasis(bFields);
+      } else {
+         setWRGrid(rFields);
+      }
+
+      return iterate();
+   }
+
    /*
    * Perform sweep of SCFT calculations along a path in parameter space.
    */
@@ -1074,6 +1327,52 @@ namespace Rpc {
                                            replicas);
    }
 
+   /*
+   * Resample r-grid fields onto a mesh with different dimensions.
+   */
+   template <int D>
+   void System<D>::resampleRGrid(std::string const & inFileName,
+                                 std::string const & outFileName,
+                                 IntVec<D> const & dimensions)
+   {
+      // Read fields
+      UnitCell<D> tmpUnitCell;
+      domain().fieldIo().readFieldsRGrid(inFileName, tmpFieldsRGrid_,
+                                         tmpUnitCell);
+
+      // Resample and write fields
+      domain().fieldIo().resampleRGrid(outFileName, tmpFieldsRGrid_,
+                                       tmpUnitCell, dimensions);
+   }
+
+   /*
+   * Resample basis fields onto a mesh, write in r-grid format.
+   */
+   template <int D>
+   void System<D>::resampleBasis(std::string const & inFileName,
+                                 std::string const & outFileName,
+                                 IntVec<D> const & dimensions)
+   {
+      UTIL_CHECK(domain_.hasGroup());
+
+      // If basis fields are not allocated, peek at field file header to
+      // get unit cell parameters, initialize basis and allocate fields.
+      if (!isAllocatedBasis_) {
+         readFieldHeader(inFileName);
+         allocateFieldsBasis();
+      }
+
+      // Read and convert fields
+      UnitCell<D> tmpUnitCell;
+      FieldIo<D> const & fieldIo = domain().fieldIo();
+      fieldIo.readFieldsBasis(inFileName, tmpFieldsBasis_, tmpUnitCell);
+      fieldIo.convertBasisToRGrid(tmpFieldsBasis_, tmpFieldsRGrid_);
+
+      // Resample and write fields
+      fieldIo.resampleRGrid(outFileName, tmpFieldsRGrid_,
+                            tmpUnitCell, dimensions);
+   }
+
    // Thermodynamic Properties
 
    /*
@@ -1146,19 +1445,14 @@ namespace Rpc {
       double temp = 0.0;
       if (w_.isSymmetric()) {
          // Use expansion in symmetry-adapted orthonormal basis
-         const int nBasis = domain_.basis().nBasis();
          for (int i = 0; i < nm; ++i) {
-            for (int k = 0; k < nBasis; ++k) {
-               temp -= w_.basis(i)[k] * c_.basis(i)[k];
-            }
+            temp -= Reduce::innerProduct(w_.basis(i), c_.basis(i));
          }
       } else {
          // Use summation over grid points
          const int meshSize = domain().mesh().size();
          for (int i = 0; i < nm; ++i) {
-            for (int k = 0; k < meshSize; ++k) {
-               temp -= w_.rgrid(i)[k] * c_.rgrid(i)[k];
-            }
+            temp -= Reduce::innerProduct(w_.rgrid(i), c_.rgrid(i));
          }
          temp /= double(meshSize);
       }
@@ -1170,19 +1464,14 @@ namespace Rpc {
       if (hasExternalFields()) {
          if (w_.isSymmetric()) {
             // Use expansion in symmetry-adapted orthonormal basis
-            const int nBasis = domain_.basis().nBasis();
             for (int i = 0; i < nm; ++i) {
-               for (int k = 0; k < nBasis; ++k) {
-                  fExt_ += h_.basis(i)[k] * c_.basis(i)[k];
-               }
+               fExt_ += Reduce::innerProduct(h_.basis(i), c_.basis(i));
             }
          } else {
             // Use summation over grid points
             const int meshSize = domain().mesh().size();
             for (int i = 0; i < nm; ++i) {
-               for (int k = 0; k < meshSize; ++k) {
-                  fExt_ += h_.rgrid(i)[k] * c_.rgrid(i)[k];
-               }
+               fExt_ += Reduce::innerProduct(h_.rgrid(i), c_.rgrid(i));
             }
             fExt_ /= double(meshSize);
          }
@@ -1192,15 +1481,12 @@ namespace Rpc {
 
       // Compute excess interaction free energy [ phi^{T}*chi*phi/2 ]
       if (w_.isSymmetric()) {
-         const int nBasis = domain_.basis().nBasis();
          for (int i = 0; i < nm; ++i) {
             for (int j = i; j < nm; ++j) {
                const double chi = interaction().chi(i,j);
                if (std::abs(chi) > 1.0E-9) {
-                  double temp = 0.0;
-                  for (int k = 0; k < nBasis; ++k) {
-                     temp += c_.basis(i)[k] * c_.basis(j)[k];
-                  }
+                  double temp
+                        = Reduce::innerProduct(c_.basis(i), c_.basis(j));
                   if (i == j) {
                      fInter_ += 0.5*chi*temp;
                   } else {
@@ -1215,10 +1501,8 @@ namespace Rpc {
             for (int j = i; j < nm; ++j) {
                const double chi = interaction().chi(i,j);
                if (std::abs(chi) > 1.0E-9) {
-                  double temp = 0.0;
-                  for (int k = 0; k < meshSize; ++k) {
-                     temp += c_.rgrid(i)[k] * c_.rgrid(j)[k];
-                  }
+                  double temp
+                        = Reduce::innerProduct(c_.rgrid(i), c_.rgrid(j));
                   if (i == j) {
                      fInter_ += 0.5*chi*temp;
                   } else {
@@ -135,6 +135,16 @@ namespace Rpc
       */
       void makeBasis();
 
+      /**
+      * Write all accumulated FFTW wisdom to the wisdom file, if any.
+      *
+      * FFTW wisdom is global to the process, and so includes wisdom for
+      * plans created by other objects that share the mesh, such as the
+      * batched transforms used by each Block. This function does nothing
+      * if no fftWisdomFile parameter was read.
+      */
+      void exportFftWisdom() const;
+
       ///@}
       /// \name Accessors (return by non-const or const reference)
       ///@{
@@ -264,6 +274,21 @@ namespace Rpc
       */
       std::string groupName_;
 
+      /**
+      * Name of FFTW planner rigor level (estimate, measure, ...).
+      */
+      std::string fftPlanner_;
+
+      /**
+      * Name of FFTW wisdom file (empty string if none).
+      */
+      std::string fftWisdomFile_;
+
+      /**
+      * Should memory released by fields be pooled for reuse?
+      */
+      bool poolFields_;
+
       /**
       * Has a space group been indentified?
       */
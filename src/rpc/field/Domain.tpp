@@ -10,6 +10,8 @@
 
 #include "Domain.h"
 #include <prdc/crystal/fieldHeader.h>
+#include <prdc/cpu/FftwSettings.h>
+#include <prdc/cpu/FieldPool.h>
 
 namespace Pscf {
 namespace Rpc
@@ -32,6 +34,9 @@ namespace Rpc
       fieldIo_(),
       lattice_(UnitCell<D>::Null),
       groupName_(""),
+      fftPlanner_("estimate"),
+      fftWisdomFile_(""),
+      poolFields_(false),
       hasGroup_(false),
       hasFileMaster_(false),
       isInitialized_(false)
@@ -69,7 +74,6 @@ namespace Rpc
       // Read computational mesh dimensions (required)
       read(in, "mesh", mesh_);
       UTIL_CHECK(mesh().size() > 0);
-      fft_.setup(mesh_.dimensions());
 
       // Read lattice_ (lattice system) enumeration value (required)
       read(in, "lattice", lattice_);
@@ -90,9 +94,41 @@ namespace Rpc
          hasGroup_ = true;
       }
 
+      // Optionally read FFTW planner rigor level (estimate by default)
+      fftPlanner_ = "estimate";
+      readOptional(in, "fftPlanner", fftPlanner_);
+      FftwSettings::setPlannerRigor(fftPlanner_);
+
+      // Optionally read name of FFTW wisdom file
+      fftWisdomFile_ = "";
+      readOptional(in, "fftWisdomFile", fftWisdomFile_);
+
+      // Optionally enable reuse of memory released by fields
+      poolFields_ = false;
+      readOptional(in, "poolFields", poolFields_);
+      FieldPool::setEnabled(poolFields_);
+
+      // Make FFT plans, reusing and then saving any wisdom 
+      if (fftWisdomFile_ != "") {
+         FftwSettings::importWisdom(fftWisdomFile_);
+      }
+      fft_.setup(mesh_.dimensions());
+      exportFftWisdom();
+
       isInitialized_ = true;
    }
 
+   /*
+   * Write accumulated FFTW wisdom to file, if a file name was given.
+   */
+   template <int D>
+   void Domain<D>::exportFftWisdom() const
+   {
+      if (fftWisdomFile_ != "") {
+         FftwSettings::exportWisdom(fftWisdomFile_);
+      }
+   }
+
    /*
    * Read header of r-grid field in order to initialize the Domain.
    *
@@ -252,6 +252,32 @@ namespace Rpc {
       void scaleFieldRGrid(RField<D>& field, double factor) 
       const override;
 
+      /**
+      * Resample an r-grid field onto a mesh with different dimensions.
+      *
+      * See documentation of analogous function in Prdc::FieldIoReal.
+      *
+      * \param in  field on the input mesh
+      * \param out  field on the output mesh (dimensions set on entry)
+      */
+      void resampleFieldRGrid(RField<D> const & in, RField<D>& out)
+      const override;
+
+      /**
+      * Write r-grid fields resampled onto a different mesh to ostream.
+      *
+      * See documentation of analogous function in Prdc::FieldIoReal.
+      *
+      * \param out  output file stream
+      * \param fields  array of RField (r-space) fields to be resampled
+      * \param unitCell  associated crystallographic unit cell
+      * \param dimensions  numbers of grid points in the output mesh
+      */
+      void resampleRGrid(std::ostream& out,
+                         DArray< RField<D> > const & fields,
+                         UnitCell<D> const & unitCell,
+                         IntVec<D> const & dimensions) const override;
+
       /**
       * Expand spatial dimension of an array of r-grid fields.
       *
@@ -310,6 +336,8 @@ namespace Rpc {
       using Base::hasSymmetry;
       using Base::scaleFieldsBasis;
       using Base::scaleFieldsRGrid;
+      using Base::resampleFieldsRGrid;
+      using Base::resampleRGrid;
       using Base::replicateUnitCell;
       using Base::expandRGridDimension;
       using Base::readFieldHeader;
@@ -284,6 +284,73 @@ namespace Rpc {
       }
    }
 
+   /*
+   * Resample an r-grid field onto a mesh with different dimensions.
+   */
+   template <int D>
+   void FieldIo<D>::resampleFieldRGrid(RField<D> const & in,
+                                       RField<D>& out) const
+   {
+      UTIL_CHECK(in.isAllocated());
+      UTIL_CHECK(out.isAllocated());
+      IntVec<D> const & inDimensions = in.meshDimensions();
+      IntVec<D> const & outDimensions = out.meshDimensions();
+
+      RFieldDft<D> inK;
+      RFieldDft<D> outK;
+      inK.allocate(inDimensions);
+      outK.allocate(outDimensions);
+
+      // Forward transform on the input mesh (scaled, as amplitudes)
+      if (inDimensions == mesh().dimensions()) {
+         fft().forwardTransform(in, inK);
+      } else {
+         FFT<D> inFft;
+         inFft.setup(inDimensions);
+         inFft.forwardTransform(in, inK);
+      }
+
+      Prdc::resampleKGrid(inK, inDimensions, outK, outDimensions);
+
+      // Inverse transform on the output mesh
+      if (outDimensions == mesh().dimensions()) {
+         fft().inverseTransformUnsafe(outK, out);
+      } else {
+         FFT<D> outFft;
+         outFft.setup(outDimensions);
+         outFft.inverseTransformUnsafe(outK, out);
+      }
+   }
+
+   /*
+   * Resample an array of r-grid fields, write to ostream.
+   */
+   template <int D>
+   void FieldIo<D>::resampleRGrid(std::ostream &out,
+                                  DArray< RField<D> > const & fields,
+                                  UnitCell<D> const & unitCell,
+                                  IntVec<D> const & dimensions) const
+   {
+      // Inspect fields to obtain nMonomer
+      int nMonomer;
+      IntVec<D> meshDimensions;
+      inspectFields(fields, nMonomer, meshDimensions);
+
+      // Resample fields
+      DArray< RField<D> > newFields;
+      newFields.allocate(nMonomer);
+      for (int i = 0; i < nMonomer; ++i) {
+         newFields[i].allocate(dimensions);
+      }
+      resampleFieldsRGrid(fields, newFields);
+
+      // Write header and data, omitting the space group name
+      writeFieldHeader(out, nMonomer, unitCell, false);
+      writeMeshDimensions(out, dimensions);
+      // Rpg: Copy device -> host
+      Prdc::writeRGridData(out, newFields, nMonomer, dimensions);
+   }
+
    /*
    * Replicate the unit cell for an array of r-grid fields.
    */
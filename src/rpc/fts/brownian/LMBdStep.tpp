@@ -13,6 +13,7 @@
 #include <rpc/fts/brownian/BdSimulator.h>
 #include <rpc/fts/compressor/Compressor.h>
 #include <rpc/System.h>
+#include <prdc/cpu/VecOp.h>
 #include <pscf/math/IntVec.h>
 #include <util/random/Random.h>
 
@@ -137,8 +138,7 @@ namespace Rpc {
    {
       // Array sizes and indices
       const int nMonomer = system().mixture().nMonomer();
-      const int meshSize = system().domain().mesh().size();
-      int i, j, k;
+      int i, j;
 
       // Save current state
       simulator().saveState();
@@ -159,16 +159,11 @@ namespace Rpc {
          RField<D> const & etaN = etaNew(j);
          RField<D> const & etaO = etaOld(j);
          RField<D> const & dc = simulator().dc(j);
-         for (k = 0; k < meshSize; ++k) {
-            dwc_[k] = a*dc[k] + etaN[k] + etaO[k];
-         }
+         VecOp::addVcVcVc(dwc_, dc, a, etaN, 1.0, etaO, 1.0);
          // Loop over monomer types
          for (i = 0; i < nMonomer; ++i) {
-            RField<D> & w = w_[i];
             evec = simulator().chiEvecs(j,i);
-            for (k = 0; k < meshSize; ++k) {
-               w[k] += evec*dwc_[k];
-            }
+            VecOp::addEqVc(w_[i], dwc_, evec);
          }
       }
 
@@ -12,6 +12,7 @@
 #include <prdc/cpu/RField.h>              // member
 #include <prdc/cpu/RFieldDft.h>           // member
 #include <util/containers/DArray.h>       // member
+#include <util/containers/Matrix.h>       // function argument
 
 namespace Pscf {
 namespace Rpc
@@ -52,6 +53,22 @@ namespace Rpc
       */
       void computeIntraCorrelations(RField<D>& correlations);
 
+      /**
+      * Compute intramolecular correlations for each pair of monomer types.
+      *
+      * On return, element (i, j) of the nMonomer x nMonomer matrix
+      * correlations contains the contribution to the ideal-gas
+      * correlation function at a wavevector with square magnitude ksq
+      * from pairs of monomers of types i and j, normalized such that
+      * the sum of all elements is equal to the value computed at the
+      * same wavevector by computeIntraCorrelations(RField<D>&).
+      *
+      * \param ksq  square magnitude of wavevector
+      * \param correlations  matrix of correlations (output)
+      */
+      void computeIntraCorrelations(double ksq,
+                                    Matrix<double>& correlations);
+
    protected:
 
       /** 
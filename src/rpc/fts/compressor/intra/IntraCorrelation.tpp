@@ -46,6 +46,7 @@ namespace Rpc{
       const double vMonomer = mixture.vMonomer();
 
       // Compute Fourier space kMeshDimensions_
+      kSize_ = 1;
       for (int i = 0; i < D; ++i) {
          if (i < D - 1) {
             kMeshDimensions_[i] = dimensions[i];
@@ -187,6 +188,104 @@ namespace Rpc{
 
    }
 
+   template<int D>
+   void
+   IntraCorrelation<D>::computeIntraCorrelations(double ksq,
+                                                 Matrix<double>& correlations)
+   {
+      Mixture<D> const & mixture = system().mixture();
+      const int nMonomer = mixture.nMonomer();
+      const int nPolymer = mixture.nPolymer();
+      const int nSolvent = mixture.nSolvent();
+      const double vMonomer = mixture.vMonomer();
+      UTIL_CHECK(correlations.capacity1() == nMonomer);
+      UTIL_CHECK(correlations.capacity2() == nMonomer);
+
+      double phi, cPolymer, polymerLength, value;
+      double length, lengthA, lengthB, kuhn, kuhnA, kuhnB;
+      int monomerId, monomerIdA, monomerIdB, i, j;
+
+      // Initialize correlations to zero
+      for (i = 0; i < nMonomer; ++i) {
+         for (j = 0; j < nMonomer; ++j) {
+            correlations(i, j) = 0.0;
+         }
+      }
+
+      // Loop over polymer species
+      for (i = 0; i < nPolymer; i++){
+
+         Polymer<D> const & polymer = mixture.polymer(i);
+         const int nBlock = polymer.nBlock();
+         phi = polymer.phi();
+
+         // Compute polymer number concentration
+         polymerLength = 0.0;
+         for (j = 0; j < nBlock; j++) {
+            polymerLength += polymer.block(j).length();
+         }
+         cPolymer = phi/(polymerLength*vMonomer);
+
+         // Diagonal (intra-block) contributions
+         for (j = 0; j < nBlock; j++) {
+            monomerId = polymer.block(j).monomerId();
+            kuhn = mixture.monomer(monomerId).kuhn();
+            length = polymer.block(j).length();
+            correlations(monomerId, monomerId)
+                                 += cPolymer * Debye::d(ksq, length, kuhn);
+         }
+
+         // Off-diagonal (inter-block) contributions
+         if (nBlock > 1) {
+            EdgeIterator EdgeItr(polymer);
+            for (int ia = 1; ia < nBlock; ++ia) {
+               Block<D> const & blockA = polymer.block(ia);
+               lengthA = blockA.length();
+               monomerIdA = blockA.monomerId();
+               kuhnA = mixture.monomer(monomerIdA).kuhn();
+               for (int ib = 0; ib < ia; ++ib)  {
+                  Block<D> const & blockB = polymer.block(ib);
+                  lengthB = blockB.length();
+                  monomerIdB = blockB.monomerId();
+                  kuhnB = mixture.monomer(monomerIdB).kuhn();
+
+                  // Mean-square length of segment between blocks
+                  double d = 0.0;
+                  int edgeId;
+                  EdgeItr.begin(ia, ib);
+                  while (EdgeItr.notEnd()) {
+                     edgeId = EdgeItr.currentEdgeId();
+                     if (edgeId != ia && edgeId != ib){
+                        Block<D> const & blockK = polymer.block(edgeId);
+                        double lengthK = blockK.length();
+                        int monomerIdK = blockK.monomerId();
+                        double kuhnK = mixture.monomer(monomerIdK).kuhn();
+                        d += lengthK * kuhnK * kuhnK;
+                     }
+                     ++EdgeItr;
+                  }
+
+                  value = cPolymer * std::exp( -d * ksq / 6.0)
+                          * Debye::e(ksq, lengthA, kuhnA)
+                          * Debye::e(ksq, lengthB, kuhnB);
+                  correlations(monomerIdA, monomerIdB) += value;
+                  correlations(monomerIdB, monomerIdA) += value;
+               }
+            }
+         }
+
+      } // loop over polymer species
+
+      // Loop over solvent species (if any)
+      for (i = 0; i < nSolvent; i++){
+         Solvent<D> const & solvent = mixture.solvent(i);
+         monomerId = solvent.monomerId();
+         correlations(monomerId, monomerId)
+                                 += solvent.phi()*solvent.size()/vMonomer;
+      }
+
+   }
+
 }
 }
 #endif
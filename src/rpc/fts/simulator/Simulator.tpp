@@ -18,6 +18,9 @@
 #include <rpc/fts/ramp/Ramp.h>
 #include <rpc/fts/ramp/RampFactory.h>
 
+#include <prdc/cpu/VecOp.h>
+#include <prdc/cpu/Reduce.h>
+
 #include <util/misc/Timer.h>
 #include <util/random/Random.h>
 #include <util/global.h>
@@ -29,6 +32,7 @@ namespace Pscf {
 namespace Rpc {
 
    using namespace Util;
+   using namespace Prdc::Cpu;
 
    /*
    * Constructor.
@@ -234,10 +238,7 @@ namespace Rpc {
       }
 
       // Subtract average of pressure field wc_[nMonomer-1]
-      RField<D> const & Wc = wc_[nMonomer-1];
-      for (int i = 0; i < meshSize; ++i) {
-         lnQ += Wc[i]/double(meshSize);
-      }
+      lnQ += Reduce::sum(wc_[nMonomer-1])/double(meshSize);
       // lnQ now contains a value per monomer
 
       // Initialize field contribution HW
@@ -457,27 +458,20 @@ namespace Rpc {
 
       const int nMonomer = system().mixture().nMonomer();
       const int meshSize = system().domain().mesh().size();
-      int i, j, k;
+      int j, k;
 
       // Loop over eigenvectors (j is an eigenvector index)
       for (j = 0; j < nMonomer; ++j) {
 
-         // Loop over grid points to zero out field wc_[j]
+         // Zero out field wc_[j]
          RField<D>& Wc = wc_[j];
-         for (i = 0; i < meshSize; ++i) {
-            Wc[i] = 0.0;
-         }
+         UTIL_CHECK(Wc.capacity() == meshSize);
+         VecOp::eqS(Wc, 0.0);
 
          // Loop over monomer types (k is a monomer index)
          for (k = 0; k < nMonomer; ++k) {
             double vec = chiEvecs_(j, k)/double(nMonomer);
-
-            // Loop over grid points
-            RField<D> const & Wr = system().w().rgrid(k);
-            for (i = 0; i < meshSize; ++i) {
-               Wc[i] += vec*Wr[i];
-            }
-
+            VecOp::addEqVc(Wc, system().w().rgrid(k), vec);
          }
       }
 
@@ -498,27 +492,20 @@ namespace Rpc {
 
       const int nMonomer = system().mixture().nMonomer();
       const int meshSize = system().domain().mesh().size();
-      int i, j, k;
+      int i, j;
 
       // Loop over eigenvectors (i is an eigenvector index)
       for (i = 0; i < nMonomer; ++i) {
 
          // Set cc_[i] to zero
          RField<D>& Cc = cc_[i];
-         for (k = 0; k < meshSize; ++k) {
-            Cc[k] = 0.0;
-         }
+         UTIL_CHECK(Cc.capacity() == meshSize);
+         VecOp::eqS(Cc, 0.0);
 
          // Loop over monomer types
          for (j = 0; j < nMonomer; ++j) {
-            RField<D> const & Cr = system().c().rgrid(j);
             double vec = chiEvecs_(i, j);
-
-            // Loop over grid points
-            for (k = 0; k < meshSize; ++k) {
-               Cc[k] += vec*Cr[k];
-            }
-
+            VecOp::addEqVc(Cc, system().c().rgrid(j), vec);
          }
       }
 
@@ -542,7 +529,7 @@ namespace Rpc {
       const double vMonomer = system().mixture().vMonomer();
       const double a = 1.0/vMonomer;
       double b, s;
-      int i, k;
+      int i;
 
       // Compute derivatives for standard Hamiltonian
       // Loop over composition eigenvectors (exclude the last)
@@ -552,10 +539,9 @@ namespace Rpc {
          RField<D> const & Cc = cc_[i];
          b = -1.0*double(nMonomer)/chiEvals_[i];
          s = sc_[i];
-         // Loop over grid points
-         for (k = 0; k < meshSize; ++k) {
-            Dc[k] = a*( b*(Wc[k] - s) + Cc[k] );
-         }
+         // Dc = a*( b*(Wc - s) + Cc )
+         UTIL_CHECK(Dc.capacity() == meshSize);
+         VecOp::addVcVcS(Dc, Wc, a*b, Cc, a, -a*b*s);
       }
 
       // Add derivatives arising from a perturbation (if any).
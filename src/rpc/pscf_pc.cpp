@@ -6,6 +6,8 @@
 */
 
 #include <prdc/crystal/getDimension.h>
+#include <prdc/cpu/FftwSettings.h>
+#include <prdc/cpu/FieldPool.h>
 #include <rpc/System.h>
 
 #include <iostream>
@@ -63,5 +65,9 @@ int main(int argc, char **argv)
       std::cout << " Invalid dimension = " << D << std::endl;
    }
 
-   fftw_cleanup();
+   // Free cached field memory. This is not done by the destructor of
+   // Domain, because the pool is shared by all System objects, e.g.,
+   // by the temporary systems used by System::iterateCoarseToFine.
+   Pscf::Prdc::Cpu::FieldPool::clear();
+   Pscf::Prdc::Cpu::FftwSettings::cleanup();
 }
@@ -10,6 +10,8 @@
 
 #include "AmIteratorBasis.h"
 #include <rpc/System.h>
+#include <prdc/cpu/VecOp.h>
+#include <prdc/cpu/Reduce.h>
 #include <pscf/inter/Interaction.h>
 #include <pscf/iterator/NanException.h>
 #include <util/global.h>
@@ -19,6 +21,7 @@ namespace Pscf{
 namespace Rpc {
 
    using namespace Util;
+   using namespace Prdc::Cpu;
 
    // Constructor
    template <int D>
@@ -119,16 +122,12 @@ namespace Rpc {
    double AmIteratorBasis<D>::dotProduct(DArray<double> const & a, 
                                     DArray<double> const & b)
    {
-      const int n = a.capacity();
-      UTIL_CHECK(b.capacity() == n);
-      double product = 0.0;
-      for (int i = 0; i < n; i++) {
-         // if either value is NaN, throw NanException
-         if (std::isnan(a[i]) || std::isnan(b[i])) { 
-            throw NanException("AmIteratorBasis::dotProduct", __FILE__, 
-                               __LINE__, 0);
-         }
-         product += a[i] * b[i];
+      UTIL_CHECK(b.capacity() == a.capacity());
+      double product = Reduce::innerProduct(a, b);
+      // if either vector contains a NaN, so does the product
+      if (std::isnan(product)) { 
+         throw NanException("AmIteratorBasis::dotProduct", __FILE__, 
+                            __LINE__, 0);
       }
       return product;
    }
@@ -167,9 +166,7 @@ namespace Rpc {
       newbasis.allocate(n);
 
       // New basis vector is difference between two most recent states
-      for (int i = 0; i < n; i++) {
-         newbasis[i] = hists[0][i] - hists[1][i]; 
-      }
+      VecOp::subVV(newbasis, hists[0], hists[1]);
       basis.append(newbasis);
    }
 
@@ -181,12 +178,9 @@ namespace Rpc {
                                     DArray<double> coeffs,
                                     int nHist)
    {
-      int n = trial.capacity();
       for (int i = 0; i < nHist; i++) {
-         for (int j = 0; j < n; j++) {
-            // Not clear on the origin of the -1 factor
-            trial[j] += coeffs[i] * -1 * basis[i][j];
-         }
+         // Not clear on the origin of the -1 factor
+         VecOp::addEqVc(trial, basis[i], coeffs[i] * -1);
       }
    }
 
@@ -196,10 +190,7 @@ namespace Rpc {
                                               DArray<double> const & resTrial,
                                               double lambda)
    {
-      int n = fieldTrial.capacity();
-      for (int i = 0; i < n; i++) {
-         fieldTrial[i] += lambda * resTrial[i];
-      }
+      VecOp::addEqVc(fieldTrial, resTrial, lambda);
    }
 
    // Private virtual functions to exchange data with parent system
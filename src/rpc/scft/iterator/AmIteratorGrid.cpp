@@ -0,0 +1,18 @@
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "AmIteratorGrid.tpp"
+
+namespace Pscf {
+namespace Rpc {
+
+   template class AmIteratorGrid<1>;
+   template class AmIteratorGrid<2>;
+   template class AmIteratorGrid<3>;
+
+}
+}
@@ -0,0 +1,465 @@
+#ifndef RPC_AM_ITERATOR_GRID_TPP
+#define RPC_AM_ITERATOR_GRID_TPP
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "AmIteratorGrid.h"
+#include <rpc/System.h>
+#include <prdc/cpu/VecOp.h>
+#include <prdc/cpu/Reduce.h>
+#include <pscf/inter/Interaction.h>
+#include <pscf/iterator/NanException.h>
+#include <util/global.h>
+#include <cmath>
+
+namespace Pscf{
+namespace Rpc {
+
+   using namespace Util;
+   using namespace Prdc::Cpu;
+
+   // Constructor
+   template <int D>
+   AmIteratorGrid<D>::AmIteratorGrid(System<D>& system)
+    : Iterator<D>(system),
+      imposedFields_(system)
+   {
+      isSymmetric_ = false;
+      setClassName("AmIteratorGrid");
+   }
+
+   // Destructor
+   template <int D>
+   AmIteratorGrid<D>::~AmIteratorGrid()
+   {  }
+
+   // Read parameters from file
+   template <int D>
+   void AmIteratorGrid<D>::readParameters(std::istream& in)
+   {
+      // Call parent class readParameters
+      AmIteratorTmpl<Iterator<D>, DArray<double> >::readParameters(in);
+      AmIteratorTmpl<Iterator<D>, DArray<double> >::readErrorType(in);
+
+      // Allocate local modified copy of Interaction class
+      interaction_.setNMonomer(system().mixture().nMonomer());
+
+      // Default parameter values
+      isFlexible_ = 1;
+      scaleStress_ = 10.0;
+
+      int np = system().domain().unitCell().nParameter();
+      UTIL_CHECK(np > 0);
+      UTIL_CHECK(np <= 6);
+      UTIL_CHECK(system().domain().unitCell().lattice() != UnitCell<D>::Null);
+
+      // Read optional isFlexible boolean (true by default)
+      readOptional(in, "isFlexible", isFlexible_);
+
+      // Populate flexibleParams_ based on isFlexible_ (all 0s or all 1s),
+      // then optionally overwrite with user input from param file
+      if (isFlexible_) {
+         flexibleParams_.clear();
+         for (int i = 0; i < np; i++) {
+            flexibleParams_.append(true); // Set all values to true
+         }
+         // Read optional flexibleParams_ array to overwrite current array
+         readOptionalFSArray(in, "flexibleParams", flexibleParams_, np);
+         if (nFlexibleParams() == 0) isFlexible_ = false;
+      } else { // isFlexible_ = false
+         flexibleParams_.clear();
+         for (int i = 0; i < np; i++) {
+            flexibleParams_.append(false); // Set all values to false
+         }
+      }
+
+      // Read optional scaleStress value
+      readOptional(in, "scaleStress", scaleStress_);
+
+      // Read optional ImposedFieldsGenerator object
+      readParamCompositeOptional(in, imposedFields_);
+   }
+
+   // Output timing results to log file.
+   template<int D>
+   void AmIteratorGrid<D>::outputTimers(std::ostream& out)
+   {
+      // Output timing results, if requested.
+      out << "\n";
+      out << "Iterator times contributions:\n";
+      AmIteratorTmpl<Iterator<D>, DArray<double> >::outputTimers(out);
+   }
+
+   // Protected virtual function
+
+   // Setup before entering iteration loop
+   template <int D>
+   void AmIteratorGrid<D>::setup(bool isContinuation)
+   {
+      if (imposedFields_.isActive()) {
+         imposedFields_.setup();
+      }
+
+      // Allocate work space, if necessary
+      const int nMonomer = system().mixture().nMonomer();
+      IntVec<D> const & meshDimensions = system().domain().mesh().dimensions();
+      if (!residField_.isAllocated()) {
+         residField_.allocate(meshDimensions);
+      }
+      if (!wFields_.isAllocated()) {
+         wFields_.allocate(nMonomer);
+         for (int i = 0; i < nMonomer; ++i) {
+            wFields_[i].allocate(meshDimensions);
+         }
+      }
+
+      AmIteratorTmpl<Iterator<D>, DArray<double> >::setup(isContinuation);
+      interaction_.update(system().interaction());
+   }
+
+   // Private virtual functions used to implement AM algorithm
+
+   // Assign one array to another
+   template <int D>
+   void AmIteratorGrid<D>::setEqual(DArray<double>& a,
+                                    DArray<double> const & b)
+   {
+      if (!a.isAllocated()) {
+         a.allocate(b.capacity());
+      }
+      UTIL_CHECK(a.capacity() == b.capacity());
+      VecOp::eqV(a, b);
+   }
+
+   // Compute and return inner product of two vectors.
+   template <int D>
+   double AmIteratorGrid<D>::dotProduct(DArray<double> const & a,
+                                        DArray<double> const & b)
+   {
+      UTIL_CHECK(b.capacity() == a.capacity());
+      double product = Reduce::innerProduct(a, b);
+      // if either vector contains a NaN, so does the product
+      if (std::isnan(product)) {
+         throw NanException("AmIteratorGrid::dotProduct", __FILE__,
+                            __LINE__, 0);
+      }
+      return product;
+   }
+
+   // Compute and return maximum element of a vector.
+   template <int D>
+   double AmIteratorGrid<D>::maxAbs(DArray<double> const & a)
+   {
+      double max = Reduce::maxAbs(a);
+      if (std::isnan(max)) { // if value is NaN, throw NanException
+         throw NanException("AmIteratorGrid::maxAbs", __FILE__,
+                            __LINE__, 0);
+      }
+      return max;
+   }
+
+   // Update basis
+   template <int D>
+   void
+   AmIteratorGrid<D>::updateBasis(RingBuffer< DArray<double> > & basis,
+                                  RingBuffer< DArray<double> > const & hists)
+   {
+      // Make sure at least two histories are stored
+      UTIL_CHECK(hists.size() >= 2);
+
+      // Reuse the array of the oldest basis vector, if any
+      basis.advance();
+      if (basis[0].isAllocated()) {
+         UTIL_CHECK(basis[0].capacity() == hists[0].capacity());
+      } else {
+         basis[0].allocate(hists[0].capacity());
+      }
+
+      // New basis vector is difference between two most recent states
+      VecOp::subVV(basis[0], hists[0], hists[1]);
+   }
+
+   // Add linear combination of basis vectors to trial field.
+   template <int D>
+   void
+   AmIteratorGrid<D>::addHistories(DArray<double>& trial,
+                                   RingBuffer<DArray<double> > const & basis,
+                                   DArray<double> coeffs,
+                                   int nHist)
+   {
+      for (int i = 0; i < nHist; i++) {
+         VecOp::addEqVc(trial, basis[i], -1.0 * coeffs[i]);
+      }
+   }
+
+   // Add predicted error to field trial.
+   template <int D>
+   void AmIteratorGrid<D>::addPredictedError(DArray<double>& fieldTrial,
+                                             DArray<double> const & resTrial,
+                                             double lambda)
+   {
+      VecOp::addEqVc(fieldTrial, resTrial, lambda);
+   }
+
+   // Private virtual functions to exchange data with parent system
+
+   // Does the system have an initial field guess?
+   template <int D>
+   bool AmIteratorGrid<D>::hasInitialGuess()
+   {  return system().w().hasData(); }
+
+   // Compute and return number of elements in a residual vector
+   template <int D>
+   int AmIteratorGrid<D>::nElements()
+   {
+      const int nMonomer = system().mixture().nMonomer();
+      const int nMesh = system().domain().mesh().size();
+
+      int nEle = nMonomer*nMesh;
+      if (isFlexible()) {
+         nEle += nFlexibleParams();
+      }
+
+      return nEle;
+   }
+
+   // Get the current w fields and lattice parameters
+   template <int D>
+   void AmIteratorGrid<D>::getCurrent(DArray<double>& curr)
+   {
+      const int nMonomer = system().mixture().nMonomer();
+      const int nMesh = system().domain().mesh().size();
+
+      // Straighten out fields into a linear array
+      for (int i = 0; i < nMonomer; i++) {
+         VecOp::eqV(curr, system().w().rgrid(i), i*nMesh, 0, nMesh);
+      }
+
+      // Add elements associated with unit cell parameters (if any)
+      if (isFlexible()) {
+         const int nParam = system().domain().unitCell().nParameter();
+         const FSArray<double,6> currParam
+                                  = system().domain().unitCell().parameters();
+         int counter = 0;
+         for (int i = 0; i < nParam; i++) {
+            if (flexibleParams_[i]) {
+               curr[nMonomer*nMesh + counter] = scaleStress_*currParam[i];
+               counter++;
+            }
+         }
+         UTIL_CHECK(counter == nFlexibleParams());
+      }
+
+   }
+
+   // Perform the main system computation (solve the MDE)
+   template <int D>
+   void AmIteratorGrid<D>::evaluate()
+   {
+      // Solve MDEs for current omega field
+      // (computes stress if isFlexible_ == true)
+      system().compute(isFlexible_);
+   }
+
+   // Compute the residual for the current system state
+   template <int D>
+   void AmIteratorGrid<D>::getResidual(DArray<double>& resid)
+   {
+      const int nMonomer = system().mixture().nMonomer();
+      const int nMesh = system().domain().mesh().size();
+
+      // Compute SCF residual for each monomer type in residField_,
+      // then copy it to the corresponding slice of resid
+      for (int i = 0; i < nMonomer; ++i) {
+         VecOp::eqS(residField_, 0.0);
+         for (int j = 0; j < nMonomer; ++j) {
+            VecOp::addVcVcVc(residField_, residField_, 1.0,
+                             system().c().rgrid(j), interaction_.chi(i,j),
+                             system().w().rgrid(j), -interaction_.p(i,j));
+         }
+
+         // If iterator has mask, account for it in residual values
+         if (system().hasMask()) {
+            double coeff = -1.0 / interaction_.sumChiInverse();
+            VecOp::addEqVc(residField_, system().mask().rgrid(), coeff);
+         }
+
+         // If iterator has external fields, account for them in the
+         // values of the residuals
+         if (system().hasExternalFields()) {
+            for (int j = 0; j < nMonomer; ++j) {
+               double p = interaction_.p(i,j);
+               VecOp::addEqVc(residField_, system().h().rgrid(j), p);
+            }
+         }
+
+         // If not canonical, account for incompressibility. Otherwise,
+         // subtract the spatial average of the residual
+         if (!system().mixture().isCanonical()) {
+            if (!system().hasMask()) {
+               VecOp::subEqS(residField_, 1.0/interaction_.sumChiInverse());
+            }
+         } else {
+            VecOp::subEqS(residField_, findAverage(residField_));
+         }
+
+         VecOp::eqV(resid, residField_, i*nMesh, 0, nMesh);
+      }
+
+      // If variable unit cell, compute stress residuals
+      if (isFlexible()) {
+         const int nParam = system().domain().unitCell().nParameter();
+
+         // Combined -1 factor and stress scaling here, as in the
+         // AmIteratorBasis class.
+         int counter = 0;
+         for (int i = 0; i < nParam ; i++) {
+            if (flexibleParams_[i]) {
+               double stress = system().mixture().stress(i);
+
+               // Correct stress to account for effect of imposed fields
+               if (imposedFields_.isActive()) {
+                  stress = imposedFields_.correctedStress(i,stress);
+               }
+
+               resid[nMonomer*nMesh + counter] = -1 * scaleStress_ * stress;
+               counter++;
+            }
+         }
+         UTIL_CHECK(counter == nFlexibleParams());
+      }
+
+   }
+
+   // Update the current system field coordinates
+   template <int D>
+   void AmIteratorGrid<D>::update(DArray<double>& newGuess)
+   {
+      const int nMonomer = system().mixture().nMonomer();
+      const int nMesh = system().domain().mesh().size();
+
+      // Restructure in format of monomers, grid points
+      for (int i = 0; i < nMonomer; i++) {
+         VecOp::eqV(wFields_[i], newGuess, 0, i*nMesh, nMesh);
+      }
+
+      // If canonical, explicitly set homogeneous field components
+      if (system().mixture().isCanonical()) {
+         double wAverage;
+         for (int i = 0; i < nMonomer; ++i) {
+            wAverage = 0.0;
+            for (int j = 0; j < nMonomer; ++j) {
+               wAverage += interaction_.chi(i,j)
+                           * findAverage(system().c().rgrid(j));
+            }
+            // If iterator has external fields, include them in average
+            if (system().hasExternalFields()) {
+               wAverage += findAverage(system().h().rgrid(i));
+            }
+            // Shift field so that its average is equal to wAverage
+            VecOp::addEqS(wFields_[i], wAverage - findAverage(wFields_[i]));
+         }
+      }
+      system().setWRGrid(wFields_);
+
+      if (isFlexible()) {
+         const int nParam = system().domain().unitCell().nParameter();
+         const int begin = nMonomer*nMesh;
+
+         FSArray<double,6> parameters;
+         parameters = system().domain().unitCell().parameters();
+
+         double coeff = 1.0 / scaleStress_;
+         int counter = 0;
+         for (int i = 0; i < nParam; i++) {
+            if (flexibleParams_[i]) {
+               parameters[i] = coeff * newGuess[begin + counter];
+               counter++;
+            }
+         }
+         UTIL_CHECK(counter == nFlexibleParams());
+
+         system().setUnitCell(parameters);
+      }
+
+      // Update imposed fields if needed
+      if (imposedFields_.isActive()) {
+         imposedFields_.update();
+      }
+   }
+
+   // Output relevant system details to the iteration log.
+   template<int D>
+   void AmIteratorGrid<D>::outputToLog()
+   {
+      if (isFlexible() && verbose() > 1) {
+         const int nParam = system().domain().unitCell().nParameter();
+         const int nMonomer = system().mixture().nMonomer();
+         const int nMesh = system().domain().mesh().size();
+         int counter = 0;
+         for (int i = 0; i < nParam; i++) {
+            if (flexibleParams_[i]) {
+               double stress = residual()[nMonomer*nMesh + counter] /
+                               (-1.0 * scaleStress_);
+               Log::file()
+                      << " Cell Param  " << i << " = "
+                      << Dbl(system().domain().unitCell().parameters()[i], 15)
+                      << " , stress = "
+                      << Dbl(stress, 15)
+                      << "\n";
+               counter++;
+            }
+         }
+      }
+   }
+
+   // Return specialized sweep parameter types to add to the Sweep object
+   template<int D>
+   GArray<ParameterType> AmIteratorGrid<D>::getParameterTypes()
+   {
+      GArray<ParameterType> arr;
+      if (imposedFields_.isActive()) {
+         arr = imposedFields_.getParameterTypes();
+      }
+      return arr;
+   }
+
+   // Set the value of a specialized sweep parameter
+   template<int D>
+   void AmIteratorGrid<D>::setParameter(std::string name, DArray<int> ids,
+                                        double value, bool& success)
+   {
+      if (imposedFields_.isActive()) {
+         imposedFields_.setParameter(name, ids, value, success);
+      } else {
+         success = false;
+      }
+   }
+
+   // Get the value of a specialized sweep parameter
+   template<int D>
+   double AmIteratorGrid<D>::getParameter(std::string name,
+                                          DArray<int> ids, bool& success)
+   const
+   {
+      if (imposedFields_.isActive()) {
+         return imposedFields_.getParameter(name, ids, success);
+      } else {
+         success = false;
+         return 0.0;
+      }
+   }
+
+   // Compute the spatial average of a field on the grid
+   template<int D>
+   double AmIteratorGrid<D>::findAverage(RField<D> const & field)
+   {  return Reduce::sum(field) / field.capacity(); }
+
+}
+}
+#endif
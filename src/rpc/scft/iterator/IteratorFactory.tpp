@@ -5,6 +5,9 @@
 
 // Subclasses of Iterator 
 #include "AmIteratorBasis.h"
+#include "AmIteratorGrid.h"
+#include "JfnkIteratorGrid.h"
+#include "LrAmIteratorBasis.h"
 
 namespace Pscf {
 namespace Rpc {
@@ -35,6 +38,15 @@ namespace Rpc {
       if (className == "Iterator" || className == "AmIteratorBasis" 
                                   || className == "AmIterator" ) {
          ptr = new AmIteratorBasis<D>(*sysPtr_);
+      } else
+      if (className == "AmIteratorGrid") {
+         ptr = new AmIteratorGrid<D>(*sysPtr_);
+      } else
+      if (className == "JfnkIteratorGrid") {
+         ptr = new JfnkIteratorGrid<D>(*sysPtr_);
+      } else
+      if (className == "LrAmIteratorBasis") {
+         ptr = new LrAmIteratorBasis<D>(*sysPtr_);
       }
 
       return ptr;
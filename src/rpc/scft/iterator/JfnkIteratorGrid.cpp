@@ -0,0 +1,18 @@
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "JfnkIteratorGrid.tpp"
+
+namespace Pscf {
+namespace Rpc {
+
+   template class JfnkIteratorGrid<1>;
+   template class JfnkIteratorGrid<2>;
+   template class JfnkIteratorGrid<3>;
+
+}
+}
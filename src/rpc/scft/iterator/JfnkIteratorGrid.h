@@ -0,0 +1,357 @@
+#ifndef RPC_JFNK_ITERATOR_GRID_H
+#define RPC_JFNK_ITERATOR_GRID_H
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "Iterator.h"                                 // base class
+#include <rpc/fts/compressor/intra/IntraCorrelation.h> // member
+#include <prdc/cpu/RField.h>                          // member
+#include <prdc/cpu/RFieldDft.h>                       // member
+#include <pscf/iterator/AmbdInteraction.h>            // member
+#include <util/containers/DArray.h>                   // member
+#include <util/containers/DMatrix.h>                  // member
+#include <util/misc/Timer.h>                          // member
+
+#include <string>
+
+namespace Pscf {
+namespace Rpc
+{
+
+   template <int D> class System;
+
+   using namespace Util;
+   using namespace Pscf::Prdc::Cpu;
+
+   /**
+   * Jacobian-free Newton-Krylov iterator for SCFT, on a real grid.
+   *
+   * Each iteration of this algorithm computes a Newton step for the SCF
+   * residual by approximately solving the linear system J s = -F, in
+   * which F is the residual vector and J its Jacobian, by a restarted
+   * GMRES algorithm. Products of J with vectors are approximated by
+   * finite differences of residuals, each of which requires one call
+   * to System::compute, so J is never formed. The step is then accepted
+   * or shortened by a backtracking line search on the residual norm.
+   *
+   * The field and residual vectors are defined as in AmIteratorGrid,
+   * i.e., as values of w fields and of SCF residuals on the nodes of the
+   * computational mesh, followed by scaled lattice parameters and stress
+   * components for a flexible unit cell. No space group symmetry is
+   * imposed.
+   *
+   * GMRES may optionally be right-preconditioned by an approximate
+   * inverse Jacobian obtained from the random phase approximation, in
+   * which the response of the total monomer concentration to a field
+   * that acts equally on all monomer types is given by the Debye
+   * functions for ideal chains, as computed by IntraCorrelation.
+   *
+   * \see \ref rpc_JfnkIteratorGrid_page "Manual Page"
+   *
+   * \ingroup Rpc_Scft_Iterator_Module
+   */
+   template <int D>
+   class JfnkIteratorGrid : public Iterator<D>
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param system System object associated with this iterator.
+      */
+      JfnkIteratorGrid(System<D>& system);
+
+      /**
+      * Destructor.
+      */
+      ~JfnkIteratorGrid();
+
+      /**
+      * Read all parameters and initialize.
+      *
+      * \param in input filestream
+      */
+      void readParameters(std::istream& in);
+
+      /**
+      * Iterate to a solution.
+      *
+      * \param isContinuation true iff a continuation within a sweep
+      * \return error code: 0 for success, 1 for failure.
+      */
+      int solve(bool isContinuation = false);
+
+      /**
+      * Output timing results to log file.
+      *
+      * \param out  output stream for timer report
+      */
+      void outputTimers(std::ostream& out);
+
+      /**
+      * Clear timers and counters.
+      */
+      void clearTimers();
+
+      /**
+      * Get the total number of Newton iterations since timers were cleared.
+      */
+      int totalItr() const;
+
+      /**
+      * Get the total number of calls to System::compute.
+      */
+      int totalEvaluate() const;
+
+      // Inherited public member functions
+      using Iterator<D>::isFlexible;
+      using Iterator<D>::flexibleParams;
+      using Iterator<D>::setFlexibleParams;
+      using Iterator<D>::nFlexibleParams;
+
+   protected:
+
+      // Inherited protected members
+      using ParamComposite::read;
+      using ParamComposite::readOptional;
+      using ParamComposite::readOptionalFSArray;
+      using ParamComposite::setClassName;
+      using Iterator<D>::system;
+      using Iterator<D>::isSymmetric_;
+      using Iterator<D>::isFlexible_;
+      using Iterator<D>::flexibleParams_;
+
+   private:
+
+      /// Local copy of interaction, adapted for use AMBD residual definition
+      AmbdInteraction interaction_;
+
+      /// Intramolecular correlation calculator, used by preconditioner.
+      IntraCorrelation<D> intra_;
+
+      /// Total ideal-chain correlation function S(k) on the k-space grid.
+      RField<D> intraCorrelationK_;
+
+      /// Work space for the preconditioner (real space).
+      RField<D> xiField_;
+
+      /// Work space for the preconditioner (k-space).
+      RFieldDft<D> xiFieldK_;
+
+      /// Work space for the SCF residual of one monomer type.
+      RField<D> residField_;
+
+      /// Work space for new w fields, used by update.
+      DArray< RField<D> > wFields_;
+
+      /// Current field vector.
+      DArray<double> x_;
+
+      /// Residual at current field vector.
+      DArray<double> f_;
+
+      /// Newton step.
+      DArray<double> step_;
+
+      /// Trial field vector (line search and Jacobian products).
+      DArray<double> xTrial_;
+
+      /// Residual at trial field vector.
+      DArray<double> fTrial_;
+
+      /// Right-hand side of the Newton equation (-f_).
+      DArray<double> rhs_;
+
+      /// Temporary vectors used by GMRES.
+      DArray<double> temp_;
+      DArray<double> temp2_;
+
+      /// Orthonormal basis of the Krylov subspace.
+      DArray< DArray<double> > krylov_;
+
+      /// Upper Hessenberg matrix of the Arnoldi process.
+      DMatrix<double> hessenberg_;
+
+      /// Givens rotation cosines, sines, and rotated rhs vector.
+      DArray<double> givensC_;
+      DArray<double> givensS_;
+      DArray<double> givensG_;
+
+      /// Solution of the GMRES least squares problem.
+      DArray<double> y_;
+
+      /// Error tolerance.
+      double epsilon_;
+
+      /// Maximum forcing term of the inexact Newton method.
+      double eta_;
+
+      /// Relative finite difference step for Jacobian-vector products.
+      double fdStep_;
+
+      /// How are stress residuals scaled in error calculation?
+      double scaleStress_;
+
+      /// Maximum number of Newton iterations.
+      int maxItr_;
+
+      /// Maximum dimension of the Krylov subspace before a restart.
+      int maxKrylov_;
+
+      /// Maximum number of GMRES cycles per Newton iteration.
+      int maxRestart_;
+
+      /// Maximum number of step halvings in the line search.
+      int maxBacktrack_;
+
+      /// Verbosity level.
+      int verbose_;
+
+      /// Number of elements in field and residual vectors.
+      int nElem_;
+
+      /// Total number of Newton iterations since timers were cleared.
+      int totalItr_;
+
+      /// Total number of MDE solutions since timers were cleared.
+      int totalEvaluate_;
+
+      /// Type of error criterion (normResid, rmsResid, ...).
+      std::string errorType_;
+
+      /// Is GMRES preconditioned by the RPA approximate inverse Jacobian?
+      bool usePreconditioner_;
+
+      /// Has work space been allocated?
+      bool isAllocated_;
+
+      // Timers for analyzing performance
+      Timer timerMDE_;
+      Timer timerLinear_;
+      Timer timerTotal_;
+
+      /**
+      * Allocate memory and prepare the preconditioner.
+      */
+      void setup();
+
+      /**
+      * Compute and return the number of elements in field vectors.
+      */
+      int nElements();
+
+      /**
+      * Get the current w fields and lattice parameters.
+      *
+      * \param curr current field vector (output)
+      */
+      void getCurrent(DArray<double>& curr);
+
+      /**
+      * Solve the MDEs for the current state of the system.
+      */
+      void evaluate();
+
+      /**
+      * Compute the residual vector for the current state of the system.
+      *
+      * \param resid residual vector (output)
+      */
+      void getResidual(DArray<double>& resid);
+
+      /**
+      * Update the system w fields and unit cell.
+      *
+      * \param newGuess new field vector
+      */
+      void update(DArray<double> const & newGuess);
+
+      /**
+      * Update the system, solve the MDEs and compute the residual.
+      *
+      * \param x field vector (input)
+      * \param resid residual vector at x (output)
+      */
+      void computeResidual(DArray<double> const & x,
+                           DArray<double>& resid);
+
+      /**
+      * Approximate the product of the Jacobian with a vector.
+      *
+      * \param v  input vector
+      * \param jv  product J v (output)
+      */
+      void multiplyJacobian(DArray<double> const & v, DArray<double>& jv);
+
+      /**
+      * Apply the approximate inverse Jacobian (preconditioner).
+      *
+      * If the preconditioner is disabled, copies in to out.
+      *
+      * \param in  input vector, in residual space
+      * \param out  output vector, in field space
+      */
+      void precondition(DArray<double> const & in, DArray<double>& out);
+
+      /**
+      * Solve J step = rhs approximately by restarted GMRES.
+      *
+      * \param tolerance  required norm of the linear residual
+      * \return total number of Krylov iterations
+      */
+      int solveNewtonEquation(double tolerance);
+
+      /**
+      * Compute the Euclidean norm of a vector.
+      *
+      * \param a  input vector
+      */
+      double norm(DArray<double> const & a);
+
+      /**
+      * Compute the scalar error used to test convergence.
+      *
+      * \param resid  residual vector
+      * \param field  field vector
+      */
+      double computeError(DArray<double> const & resid,
+                          DArray<double> const & field);
+
+      /**
+      * Compute the spatial average of a field on the grid.
+      *
+      * \param field  field on the grid
+      */
+      double findAverage(RField<D> const & field);
+
+   };
+
+   // Inline member functions
+
+   // Get the total number of Newton iterations.
+   template <int D>
+   inline int JfnkIteratorGrid<D>::totalItr() const
+   {  return totalItr_; }
+
+   // Get the total number of MDE solutions.
+   template <int D>
+   inline int JfnkIteratorGrid<D>::totalEvaluate() const
+   {  return totalEvaluate_; }
+
+   #ifndef RPC_JFNK_ITERATOR_GRID_TPP
+   // Suppress implicit instantiation
+   extern template class JfnkIteratorGrid<1>;
+   extern template class JfnkIteratorGrid<2>;
+   extern template class JfnkIteratorGrid<3>;
+   #endif
+
+} // namespace Rpc
+} // namespace Pscf
+#endif
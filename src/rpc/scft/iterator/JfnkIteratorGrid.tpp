@@ -0,0 +1,707 @@
+#ifndef RPC_JFNK_ITERATOR_GRID_TPP
+#define RPC_JFNK_ITERATOR_GRID_TPP
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "JfnkIteratorGrid.h"
+#include <rpc/System.h>
+#include <prdc/cpu/VecOp.h>
+#include <prdc/cpu/Reduce.h>
+#include <pscf/inter/Interaction.h>
+#include <util/format/Int.h>
+#include <util/format/Dbl.h>
+#include <util/global.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Pscf{
+namespace Rpc {
+
+   using namespace Util;
+   using namespace Prdc::Cpu;
+
+   // Constructor
+   template <int D>
+   JfnkIteratorGrid<D>::JfnkIteratorGrid(System<D>& system)
+    : Iterator<D>(system),
+      intra_(system),
+      epsilon_(0.0),
+      eta_(0.1),
+      fdStep_(1.0E-7),
+      scaleStress_(10.0),
+      maxItr_(50),
+      maxKrylov_(30),
+      maxRestart_(4),
+      maxBacktrack_(10),
+      verbose_(0),
+      nElem_(0),
+      totalItr_(0),
+      totalEvaluate_(0),
+      errorType_("relNormResid"),
+      usePreconditioner_(false),
+      isAllocated_(false)
+   {
+      isSymmetric_ = false;
+      setClassName("JfnkIteratorGrid");
+   }
+
+   // Destructor
+   template <int D>
+   JfnkIteratorGrid<D>::~JfnkIteratorGrid()
+   {}
+
+   // Read parameters from file
+   template <int D>
+   void JfnkIteratorGrid<D>::readParameters(std::istream& in)
+   {
+      // Convergence criterion and limits of the Newton iteration
+      read(in, "epsilon", epsilon_);
+      readOptional(in, "maxItr", maxItr_);
+      UTIL_CHECK(maxItr_ > 0);
+
+      // Parameters of the GMRES solver for the Newton equation
+      readOptional(in, "maxKrylov", maxKrylov_);
+      readOptional(in, "maxRestart", maxRestart_);
+      readOptional(in, "eta", eta_);
+      readOptional(in, "fdStep", fdStep_);
+      readOptional(in, "maxBacktrack", maxBacktrack_);
+      readOptional(in, "usePreconditioner", usePreconditioner_);
+      UTIL_CHECK(maxKrylov_ > 0);
+      UTIL_CHECK(maxRestart_ > 0);
+      UTIL_CHECK(eta_ > 0.0 && eta_ < 1.0);
+      UTIL_CHECK(fdStep_ > 0.0);
+      UTIL_CHECK(maxBacktrack_ >= 0);
+
+      readOptional(in, "verbose", verbose_);
+
+      // Read and normalize the error type string
+      readOptional(in, "errorType", errorType_);
+      if (errorType_ == "norm") errorType_ = "normResid";
+      if (errorType_ == "rms") errorType_ = "rmsResid";
+      if (errorType_ == "max") errorType_ = "maxResid";
+      if (errorType_ == "relNorm") errorType_ = "relNormResid";
+      if (errorType_ != "normResid" && errorType_ != "rmsResid"
+          && errorType_ != "maxResid" && errorType_ != "relNormResid") {
+         std::string msg = "Invalid iterator error type [";
+         msg += errorType_;
+         msg += "] in parameter file";
+         UTIL_THROW(msg.c_str());
+      }
+
+      // Allocate local modified copy of Interaction class
+      interaction_.setNMonomer(system().mixture().nMonomer());
+
+      // Default flexibility
+      isFlexible_ = 1;
+
+      int np = system().domain().unitCell().nParameter();
+      UTIL_CHECK(np > 0);
+      UTIL_CHECK(np <= 6);
+      UTIL_CHECK(system().domain().unitCell().lattice() != UnitCell<D>::Null);
+
+      // Read optional isFlexible boolean (true by default)
+      readOptional(in, "isFlexible", isFlexible_);
+
+      // Populate flexibleParams_ based on isFlexible_ (all 0s or all 1s),
+      // then optionally overwrite with user input from param file
+      if (isFlexible_) {
+         flexibleParams_.clear();
+         for (int i = 0; i < np; i++) {
+            flexibleParams_.append(true); // Set all values to true
+         }
+         // Read optional flexibleParams_ array to overwrite current array
+         readOptionalFSArray(in, "flexibleParams", flexibleParams_, np);
+         if (nFlexibleParams() == 0) isFlexible_ = false;
+      } else { // isFlexible_ = false
+         flexibleParams_.clear();
+         for (int i = 0; i < np; i++) {
+            flexibleParams_.append(false); // Set all values to false
+         }
+      }
+
+      // Read optional scaleStress value
+      readOptional(in, "scaleStress", scaleStress_);
+   }
+
+   // Iterate to a solution
+   template <int D>
+   int JfnkIteratorGrid<D>::solve(bool isContinuation)
+   {
+      UTIL_CHECK(system().w().hasData());
+      setup();
+
+      timerTotal_.start();
+
+      // Compute residual for the initial guess
+      getCurrent(x_);
+      evaluate();
+      getResidual(f_);
+      double fNorm = norm(f_);
+
+      // The loop runs to itr == maxItr_ so that the error of the state
+      // reached by the last accepted step is also tested
+      double error, lambda;
+      int itr, nLinear;
+      bool accepted;
+      bool lineSearchFailed = false;
+      for (itr = 0; itr <= maxItr_; ++itr) {
+
+         if (verbose_ > 0) {
+            Log::file() << " Iteration " << Int(itr, 5);
+         }
+
+         // Test for divergence and convergence
+         if (std::isnan(fNorm)) {
+            if (verbose_ > 0) {
+               Log::file() << ",  error  =             NaN" << std::endl;
+            }
+            break;
+         }
+         error = computeError(f_, x_);
+         if (verbose_ > 0) {
+            Log::file() << ",  error  = " << Dbl(error, 15) << std::endl;
+         }
+         if (error < epsilon_) {
+            timerTotal_.stop();
+            totalItr_ += itr;
+            if (verbose_ > 0) {
+               Log::file() << " Converged\n";
+            }
+            return 0;
+         }
+         if (itr == maxItr_) {
+            break;
+         }
+
+         // Approximately solve the Newton equation J step = -f, with a
+         // forcing term that decreases with the residual norm
+         timerLinear_.start();
+         VecOp::mulVS(rhs_, f_, -1.0);
+         nLinear = solveNewtonEquation(std::min(eta_, fNorm)*fNorm);
+         timerLinear_.stop();
+
+         // Backtracking line search on the residual norm
+         lambda = 1.0;
+         accepted = false;
+         for (int k = 0; k <= maxBacktrack_; ++k) {
+            VecOp::addVcVc(xTrial_, x_, 1.0, step_, lambda);
+            computeResidual(xTrial_, fTrial_);
+            double fTrialNorm = norm(fTrial_);
+            if (!std::isnan(fTrialNorm)
+                && fTrialNorm <= (1.0 - 1.0E-4*lambda)*fNorm) {
+               fNorm = fTrialNorm;
+               accepted = true;
+               break;
+            }
+            lambda *= 0.5;
+         }
+         if (verbose_ > 1) {
+            Log::file() << " Krylov iterations = " << nLinear
+                        << ",  step length = " << lambda << std::endl;
+         }
+         if (!accepted) {
+            Log::file() << " Line search failed" << std::endl;
+            lineSearchFailed = true;
+            break;
+         }
+
+         // Accept step. Values of field components fixed by update
+         // (e.g., spatial averages in the canonical ensemble) are read
+         // back from the system.
+         getCurrent(x_);
+         VecOp::eqV(f_, fTrial_);
+      }
+
+      // Failure: If the line search failed, the system holds the last
+      // rejected trial state, so restore the last accepted state
+      if (lineSearchFailed) {
+         computeResidual(x_, f_);
+      }
+      timerTotal_.stop();
+      totalItr_ += itr;
+      return 1;
+   }
+
+   // Output timing results to log file.
+   template<int D>
+   void JfnkIteratorGrid<D>::outputTimers(std::ostream& out)
+   {
+      double total = timerTotal_.time();
+      out << "\n";
+      out << "Iterator times contributions:\n";
+      out << "\n";
+      out << "MDE solution:             "
+          << Dbl(timerMDE_.time(), 9, 3)  << " s,  "
+          << Dbl(timerMDE_.time()/total, 9, 3) << "\n";
+      out << "Newton equation (GMRES):  "
+          << Dbl(timerLinear_.time(), 9, 3)  << " s,  "
+          << Dbl(timerLinear_.time()/total, 9, 3) << "\n";
+      out << "total time:               "
+          << Dbl(total, 9, 3) <<  " s  \n";
+      out << "Newton iterations:        " << totalItr_ << "\n";
+      out << "MDE solutions:            " << totalEvaluate_ << "\n";
+      out << "\n";
+   }
+
+   // Clear timers and counters
+   template<int D>
+   void JfnkIteratorGrid<D>::clearTimers()
+   {
+      timerMDE_.clear();
+      timerLinear_.clear();
+      timerTotal_.clear();
+      totalItr_ = 0;
+      totalEvaluate_ = 0;
+   }
+
+   // Private member functions
+
+   // Allocate memory and prepare the preconditioner
+   template <int D>
+   void JfnkIteratorGrid<D>::setup()
+   {
+      const int nMonomer = system().mixture().nMonomer();
+      IntVec<D> const & meshDimensions = system().domain().mesh().dimensions();
+
+      interaction_.update(system().interaction());
+      nElem_ = nElements();
+
+      if (!isAllocated_) {
+         x_.allocate(nElem_);
+         f_.allocate(nElem_);
+         step_.allocate(nElem_);
+         xTrial_.allocate(nElem_);
+         fTrial_.allocate(nElem_);
+         rhs_.allocate(nElem_);
+         temp_.allocate(nElem_);
+         temp2_.allocate(nElem_);
+         krylov_.allocate(maxKrylov_ + 1);
+         for (int i = 0; i <= maxKrylov_; ++i) {
+            krylov_[i].allocate(nElem_);
+         }
+         hessenberg_.allocate(maxKrylov_ + 1, maxKrylov_);
+         givensC_.allocate(maxKrylov_ + 1);
+         givensS_.allocate(maxKrylov_ + 1);
+         givensG_.allocate(maxKrylov_ + 1);
+         y_.allocate(maxKrylov_);
+         residField_.allocate(meshDimensions);
+         wFields_.allocate(nMonomer);
+         for (int i = 0; i < nMonomer; ++i) {
+            wFields_[i].allocate(meshDimensions);
+         }
+         if (usePreconditioner_) {
+            IntVec<D> kMeshDimensions;
+            for (int i = 0; i < D; ++i) {
+               if (i < D - 1) {
+                  kMeshDimensions[i] = meshDimensions[i];
+               } else {
+                  kMeshDimensions[i] = meshDimensions[i]/2 + 1;
+               }
+            }
+            intraCorrelationK_.allocate(kMeshDimensions);
+            xiField_.allocate(meshDimensions);
+            xiFieldK_.allocate(meshDimensions);
+         }
+         isAllocated_ = true;
+      }
+      UTIL_CHECK(x_.capacity() == nElem_);
+
+      // Compute the total ideal-chain correlation function S(k), for
+      // the current unit cell, normalized as the linear response of the
+      // total volume fraction to a field acting on all monomers
+      if (usePreconditioner_) {
+         intra_.computeIntraCorrelations(intraCorrelationK_);
+         VecOp::mulEqS(intraCorrelationK_, system().mixture().vMonomer());
+      }
+   }
+
+   // Compute and return number of elements in a field vector
+   template <int D>
+   int JfnkIteratorGrid<D>::nElements()
+   {
+      const int nMonomer = system().mixture().nMonomer();
+      const int nMesh = system().domain().mesh().size();
+
+      int nEle = nMonomer*nMesh;
+      if (isFlexible()) {
+         nEle += nFlexibleParams();
+      }
+
+      return nEle;
+   }
+
+   // Get the current w fields and lattice parameters
+   template <int D>
+   void JfnkIteratorGrid<D>::getCurrent(DArray<double>& curr)
+   {
+      const int nMonomer = system().mixture().nMonomer();
+      const int nMesh = system().domain().mesh().size();
+
+      for (int i = 0; i < nMonomer; i++) {
+         VecOp::eqV(curr, system().w().rgrid(i), i*nMesh, 0, nMesh);
+      }
+
+      if (isFlexible()) {
+         const int nParam = system().domain().unitCell().nParameter();
+         const FSArray<double,6> currParam
+                                  = system().domain().unitCell().parameters();
+         int counter = 0;
+         for (int i = 0; i < nParam; i++) {
+            if (flexibleParams_[i]) {
+               curr[nMonomer*nMesh + counter] = scaleStress_*currParam[i];
+               counter++;
+            }
+         }
+         UTIL_CHECK(counter == nFlexibleParams());
+      }
+   }
+
+   // Solve the MDEs for the current state of the system
+   template <int D>
+   void JfnkIteratorGrid<D>::evaluate()
+   {
+      timerMDE_.start();
+      system().compute(isFlexible_);
+      ++totalEvaluate_;
+      timerMDE_.stop();
+   }
+
+   // Compute the residual for the current system state
+   template <int D>
+   void JfnkIteratorGrid<D>::getResidual(DArray<double>& resid)
+   {
+      const int nMonomer = system().mixture().nMonomer();
+      const int nMesh = system().domain().mesh().size();
+
+      // SCF residuals, defined as in AmIteratorGrid
+      for (int i = 0; i < nMonomer; ++i) {
+         VecOp::eqS(residField_, 0.0);
+         for (int j = 0; j < nMonomer; ++j) {
+            VecOp::addVcVcVc(residField_, residField_, 1.0,
+                             system().c().rgrid(j), interaction_.chi(i,j),
+                             system().w().rgrid(j), -interaction_.p(i,j));
+         }
+         if (system().hasMask()) {
+            double coeff = -1.0 / interaction_.sumChiInverse();
+            VecOp::addEqVc(residField_, system().mask().rgrid(), coeff);
+         }
+         if (system().hasExternalFields()) {
+            for (int j = 0; j < nMonomer; ++j) {
+               double p = interaction_.p(i,j);
+               VecOp::addEqVc(residField_, system().h().rgrid(j), p);
+            }
+         }
+         if (!system().mixture().isCanonical()) {
+            if (!system().hasMask()) {
+               VecOp::subEqS(residField_, 1.0/interaction_.sumChiInverse());
+            }
+         } else {
+            VecOp::subEqS(residField_, findAverage(residField_));
+         }
+         VecOp::eqV(resid, residField_, i*nMesh, 0, nMesh);
+      }
+
+      // Stress residuals
+      if (isFlexible()) {
+         const int nParam = system().domain().unitCell().nParameter();
+         int counter = 0;
+         for (int i = 0; i < nParam ; i++) {
+            if (flexibleParams_[i]) {
+               double stress = system().mixture().stress(i);
+               resid[nMonomer*nMesh + counter] = -1 * scaleStress_ * stress;
+               counter++;
+            }
+         }
+         UTIL_CHECK(counter == nFlexibleParams());
+      }
+   }
+
+   // Update the system w fields and unit cell
+   template <int D>
+   void JfnkIteratorGrid<D>::update(DArray<double> const & newGuess)
+   {
+      const int nMonomer = system().mixture().nMonomer();
+      const int nMesh = system().domain().mesh().size();
+
+      for (int i = 0; i < nMonomer; i++) {
+         VecOp::eqV(wFields_[i], newGuess, 0, i*nMesh, nMesh);
+      }
+
+      // If canonical, explicitly set homogeneous field components
+      if (system().mixture().isCanonical()) {
+         double wAverage;
+         for (int i = 0; i < nMonomer; ++i) {
+            wAverage = 0.0;
+            for (int j = 0; j < nMonomer; ++j) {
+               wAverage += interaction_.chi(i,j)
+                           * findAverage(system().c().rgrid(j));
+            }
+            if (system().hasExternalFields()) {
+               wAverage += findAverage(system().h().rgrid(i));
+            }
+            VecOp::addEqS(wFields_[i], wAverage - findAverage(wFields_[i]));
+         }
+      }
+      system().setWRGrid(wFields_);
+
+      if (isFlexible()) {
+         const int nParam = system().domain().unitCell().nParameter();
+         const int begin = nMonomer*nMesh;
+
+         FSArray<double,6> parameters;
+         parameters = system().domain().unitCell().parameters();
+
+         double coeff = 1.0 / scaleStress_;
+         int counter = 0;
+         for (int i = 0; i < nParam; i++) {
+            if (flexibleParams_[i]) {
+               parameters[i] = coeff * newGuess[begin + counter];
+               counter++;
+            }
+         }
+         UTIL_CHECK(counter == nFlexibleParams());
+
+         system().setUnitCell(parameters);
+      }
+   }
+
+   // Update the system, solve the MDEs and compute the residual
+   template <int D>
+   void JfnkIteratorGrid<D>::computeResidual(DArray<double> const & x,
+                                             DArray<double>& resid)
+   {
+      update(x);
+      evaluate();
+      getResidual(resid);
+   }
+
+   // Approximate a Jacobian-vector product by a finite difference
+   template <int D>
+   void JfnkIteratorGrid<D>::multiplyJacobian(DArray<double> const & v,
+                                              DArray<double>& jv)
+   {
+      double vNorm = norm(v);
+      if (vNorm == 0.0) {
+         VecOp::eqS(jv, 0.0);
+         return;
+      }
+      double h = fdStep_*(1.0 + norm(x_))/vNorm;
+      VecOp::addVcVc(xTrial_, x_, 1.0, v, h);
+      computeResidual(xTrial_, jv);
+      VecOp::addVcVc(jv, jv, 1.0/h, f_, -1.0/h);
+   }
+
+   /*
+   * Apply the RPA approximate inverse Jacobian.
+   *
+   * The model Jacobian neglects the response of the monomer
+   * concentrations to fields, except for the response of the total
+   * concentration to a field xi that acts equally on all monomer types,
+   * which is -S(k) xi(k). Given a vector z in residual space, the
+   * solution s of J s = z for this model is
+   *
+   *    s_i = -z_i + q/S - xi,   with  xi(k) = q(k)/S(k),
+   *
+   * where q = sum_{ij} chiInverse(j,i) z_i and S = sumChiInverse.
+   */
+   template <int D>
+   void JfnkIteratorGrid<D>::precondition(DArray<double> const & in,
+                                          DArray<double>& out)
+   {
+      if (!usePreconditioner_) {
+         VecOp::eqV(out, in);
+         return;
+      }
+
+      const int nMonomer = system().mixture().nMonomer();
+      const int nMesh = system().domain().mesh().size();
+      const double sumChiInv = interaction_.sumChiInverse();
+      int i, j, r;
+
+      // Compute q in xiField_
+      VecOp::eqS(xiField_, 0.0);
+      for (i = 0; i < nMonomer; ++i) {
+         double a = 0.0;
+         for (j = 0; j < nMonomer; ++j) {
+            a += interaction_.chiInverse(j,i);
+         }
+         for (r = 0; r < nMesh; ++r) {
+            xiField_[r] += a*in[i*nMesh + r];
+         }
+      }
+
+      // Local part of the approximate inverse
+      for (i = 0; i < nMonomer; ++i) {
+         for (r = 0; r < nMesh; ++r) {
+            out[i*nMesh + r] = -in[i*nMesh + r] + xiField_[r]/sumChiInv;
+         }
+      }
+
+      // Compute xi(k) = q(k)/S(k), and subtract xi(r) from each field
+      FFT<D> const & fft = system().domain().fft();
+      fft.forwardTransform(xiField_, xiFieldK_);
+      const int kSize = xiFieldK_.capacity();
+      for (int k = 0; k < kSize; ++k) {
+         xiFieldK_[k][0] /= intraCorrelationK_[k];
+         xiFieldK_[k][1] /= intraCorrelationK_[k];
+      }
+      fft.inverseTransformUnsafe(xiFieldK_, xiField_);
+      for (i = 0; i < nMonomer; ++i) {
+         for (r = 0; r < nMesh; ++r) {
+            out[i*nMesh + r] -= xiField_[r];
+         }
+      }
+
+      // Lattice parameters: Stress decreases as parameters increase
+      // toward a stress-free state.
+      for (i = nMonomer*nMesh; i < nElem_; ++i) {
+         out[i] = -in[i];
+      }
+   }
+
+   /*
+   * Solve the Newton equation J step_ = rhs_ by right-preconditioned
+   * GMRES, restarted after every maxKrylov_ iterations.
+   */
+   template <int D>
+   int JfnkIteratorGrid<D>::solveNewtonEquation(double tolerance)
+   {
+      const int m = maxKrylov_;
+      int i, j, k;
+      int nItr = 0;
+      double a, b, rho, c, s, h;
+
+      // Initial guess step_ = 0, so initial linear residual is rhs_
+      VecOp::eqS(step_, 0.0);
+      VecOp::eqV(temp_, rhs_);
+      double beta = norm(temp_);
+      double resid = beta;
+
+      for (int cycle = 0; cycle < maxRestart_; ++cycle) {
+         if (beta <= tolerance) break;
+
+         // First Krylov basis vector, and rhs of least squares problem
+         VecOp::mulVS(krylov_[0], temp_, 1.0/beta);
+         for (i = 0; i <= m; ++i) {
+            givensG_[i] = 0.0;
+         }
+         givensG_[0] = beta;
+
+         // Arnoldi process
+         k = 0;
+         for (j = 0; j < m; ++j) {
+            precondition(krylov_[j], temp_);
+            multiplyJacobian(temp_, krylov_[j+1]);
+            ++nItr;
+
+            // Modified Gram-Schmidt orthogonalization
+            for (i = 0; i <= j; ++i) {
+               h = Reduce::innerProduct(krylov_[j+1], krylov_[i]);
+               hessenberg_(i, j) = h;
+               VecOp::addEqVc(krylov_[j+1], krylov_[i], -h);
+            }
+            h = norm(krylov_[j+1]);
+            hessenberg_(j+1, j) = h;
+            if (h > 0.0) {
+               VecOp::mulEqS(krylov_[j+1], 1.0/h);
+            }
+
+            // Apply previous Givens rotations to column j
+            for (i = 0; i < j; ++i) {
+               a = hessenberg_(i, j);
+               b = hessenberg_(i+1, j);
+               hessenberg_(i, j) = givensC_[i]*a + givensS_[i]*b;
+               hessenberg_(i+1, j) = -givensS_[i]*a + givensC_[i]*b;
+            }
+
+            // Compute and apply a new rotation to eliminate H(j+1, j)
+            a = hessenberg_(j, j);
+            b = hessenberg_(j+1, j);
+            rho = std::sqrt(a*a + b*b);
+            if (rho > 0.0) {
+               c = a/rho;
+               s = b/rho;
+            } else {
+               c = 1.0;
+               s = 0.0;
+            }
+            givensC_[j] = c;
+            givensS_[j] = s;
+            hessenberg_(j, j) = rho;
+            hessenberg_(j+1, j) = 0.0;
+            givensG_[j+1] = -s*givensG_[j];
+            givensG_[j] = c*givensG_[j];
+            resid = std::fabs(givensG_[j+1]);
+
+            k = j + 1;
+            if (resid <= tolerance || h == 0.0) break;
+         }
+
+         // Solve the triangular system H y = g by back substitution
+         for (i = k - 1; i >= 0; --i) {
+            double sum = givensG_[i];
+            for (j = i + 1; j < k; ++j) {
+               sum -= hessenberg_(i, j)*y_[j];
+            }
+            y_[i] = (hessenberg_(i, i) != 0.0) ? sum/hessenberg_(i, i) : 0.0;
+         }
+
+         // Add preconditioned linear combination of basis vectors to step
+         VecOp::eqS(temp2_, 0.0);
+         for (i = 0; i < k; ++i) {
+            VecOp::addEqVc(temp2_, krylov_[i], y_[i]);
+         }
+         precondition(temp2_, temp_);
+         VecOp::addEqV(step_, temp_);
+
+         if (resid <= tolerance || cycle == maxRestart_ - 1) break;
+
+         // Recompute the linear residual before restarting
+         multiplyJacobian(step_, temp2_);
+         VecOp::subVV(temp_, rhs_, temp2_);
+         beta = norm(temp_);
+      }
+
+      return nItr;
+   }
+
+   // Compute the Euclidean norm of a vector
+   template <int D>
+   double JfnkIteratorGrid<D>::norm(DArray<double> const & a)
+   {  return std::sqrt(Reduce::innerProduct(a, a)); }
+
+   // Compute the scalar error used to test convergence
+   template <int D>
+   double JfnkIteratorGrid<D>::computeError(DArray<double> const & resid,
+                                            DArray<double> const & field)
+   {
+      double normRes = norm(resid);
+      double error = 0.0;
+      if (errorType_ == "maxResid") {
+         error = Reduce::maxAbs(resid);
+      } else if (errorType_ == "normResid") {
+         error = normRes;
+      } else if (errorType_ == "rmsResid") {
+         error = normRes/std::sqrt(double(nElem_));
+      } else if (errorType_ == "relNormResid") {
+         error = normRes/norm(field);
+      } else {
+         UTIL_THROW("Invalid iterator error type in parameter file.");
+      }
+      return error;
+   }
+
+   // Compute the spatial average of a field on the grid
+   template<int D>
+   double JfnkIteratorGrid<D>::findAverage(RField<D> const & field)
+   {  return Reduce::sum(field) / field.capacity(); }
+
+}
+}
+#endif
@@ -0,0 +1,126 @@
+#ifndef RPC_LR_AM_ITERATOR_BASIS_H
+#define RPC_LR_AM_ITERATOR_BASIS_H
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "AmIteratorBasis.h"                           // base class
+#include <rpc/fts/compressor/intra/IntraCorrelation.h> // member
+#include <pscf/iterator/AmbdInteraction.h>             // member
+#include <pscf/math/LuSolver.h>                        // member
+#include <util/containers/DArray.h>                    // member
+#include <util/containers/DMatrix.h>                   // member
+
+namespace Pscf {
+namespace Rpc
+{
+
+   template <int D> class System;
+
+   using namespace Util;
+
+   /**
+   * Anderson mixing iterator with a linear-response correction step.
+   *
+   * This iterator is identical to AmIteratorBasis except for the
+   * correction step of each Anderson mixing iteration, in which the
+   * predicted residual is multiplied by an approximate inverse Jacobian
+   * rather than by a scalar mixing parameter. The approximate Jacobian
+   * for each symmetry-adapted basis function is computed within the
+   * random phase approximation, using the intramolecular correlation
+   * functions of ideal chains for each pair of monomer types and the
+   * full chi matrix. The correction step is thus a quasi-Newton step
+   * that is exact for small deviations from a homogeneous state.
+   *
+   * The parameter file format is identical to that of AmIteratorBasis.
+   *
+   * \see \ref rpc_LrAmIteratorBasis_page "Manual Page"
+   *
+   * \ingroup Rpc_Scft_Iterator_Module
+   */
+   template <int D>
+   class LrAmIteratorBasis : public AmIteratorBasis<D>
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param system System object associated with this iterator.
+      */
+      LrAmIteratorBasis(System<D>& system);
+
+      /**
+      * Destructor.
+      */
+      ~LrAmIteratorBasis();
+
+   protected:
+
+      using AmIteratorBasis<D>::system;
+      using AmIteratorBasis<D>::setClassName;
+
+      /**
+      * Setup iterator just before entering iteration loop.
+      *
+      * Computes the approximate inverse Jacobian for the current
+      * unit cell.
+      *
+      * \param isContinuation Is this a continuation within a sweep?
+      */
+      void setup(bool isContinuation);
+
+   private:
+
+      /// Intramolecular correlation calculator.
+      IntraCorrelation<D> intra_;
+
+      /// Local copy of interaction, adapted for use AMBD residual definition
+      AmbdInteraction interaction_;
+
+      /// Inverse Jacobian blocks, nMonomer x nMonomer per basis function.
+      DArray<double> inverseJacobian_;
+
+      /// Intramolecular correlation matrix for one basis function.
+      DMatrix<double> correlations_;
+
+      /// Approximate Jacobian for one basis function.
+      DMatrix<double> jacobian_;
+
+      /// Inverse of jacobian_.
+      DMatrix<double> inverse_;
+
+      /// LU solver used to invert jacobian_.
+      LuSolver solver_;
+
+      /// Has work space been allocated?
+      bool isAllocated_;
+
+      /**
+      * Add the quasi-Newton correction step to field trial.
+      *
+      * \param fieldTrial trial field (in-out)
+      * \param resTrial predicted error for current trial
+      * \param lambda Anderson-Mixing mixing parameter
+      */
+      void addPredictedError(DArray<double>& fieldTrial,
+                             DArray<double> const & resTrial,
+                             double lambda);
+
+   };
+
+   #ifndef RPC_LR_AM_ITERATOR_BASIS_TPP
+   // Suppress implicit instantiation
+   extern template class LrAmIteratorBasis<1>;
+   extern template class LrAmIteratorBasis<2>;
+   extern template class LrAmIteratorBasis<3>;
+   #endif
+
+} // namespace Rpc
+} // namespace Pscf
+#endif
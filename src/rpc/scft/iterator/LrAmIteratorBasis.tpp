@@ -0,0 +1,149 @@
+#ifndef RPC_LR_AM_ITERATOR_BASIS_TPP
+#define RPC_LR_AM_ITERATOR_BASIS_TPP
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "LrAmIteratorBasis.h"
+#include <rpc/System.h>
+#include <prdc/crystal/Basis.h>
+#include <prdc/crystal/UnitCell.h>
+#include <pscf/inter/Interaction.h>
+#include <util/global.h>
+
+namespace Pscf{
+namespace Rpc {
+
+   using namespace Util;
+
+   // Constructor
+   template <int D>
+   LrAmIteratorBasis<D>::LrAmIteratorBasis(System<D>& system)
+    : AmIteratorBasis<D>(system),
+      intra_(system),
+      isAllocated_(false)
+   {  setClassName("LrAmIteratorBasis"); }
+
+   // Destructor
+   template <int D>
+   LrAmIteratorBasis<D>::~LrAmIteratorBasis()
+   {}
+
+   /*
+   * Setup before entering iteration loop.
+   *
+   * Linearizing the SCF residual r_i = sum_j [chi_ij c_j - p_ij w_j]
+   * about a homogeneous state, with c_j = - v sum_k S_jk w_k for the
+   * coefficient of a basis function with wavenumber k, gives a Jacobian
+   * -J, where J = v chi S + P. The correction step for that basis
+   * function is then J^{-1} r. Because S is evaluated for the current
+   * unit cell, J^{-1} is recomputed here before each solve.
+   */
+   template <int D>
+   void LrAmIteratorBasis<D>::setup(bool isContinuation)
+   {
+      AmIteratorBasis<D>::setup(isContinuation);
+
+      const int nMonomer = system().mixture().nMonomer();
+      const int nBasis = system().domain().basis().nBasis();
+      const int nBlock = nMonomer*nMonomer;
+      const double vMonomer = system().mixture().vMonomer();
+
+      // Allocate memory, if not done previously
+      if (!isAllocated_) {
+         interaction_.setNMonomer(nMonomer);
+         correlations_.allocate(nMonomer, nMonomer);
+         jacobian_.allocate(nMonomer, nMonomer);
+         inverse_.allocate(nMonomer, nMonomer);
+         solver_.allocate(nMonomer);
+         isAllocated_ = true;
+      }
+      if (inverseJacobian_.capacity() != nBasis*nBlock) {
+         if (inverseJacobian_.isAllocated()) {
+            inverseJacobian_.deallocate();
+         }
+         inverseJacobian_.allocate(nBasis*nBlock);
+      }
+      interaction_.update(system().interaction());
+
+      // Compute inverse Jacobian for each inhomogeneous basis function
+      Basis<D> const & basis = system().domain().basis();
+      UnitCell<D> const & unitCell = system().domain().unitCell();
+      double ksq;
+      int b, i, j, k;
+      for (b = 1; b < nBasis; ++b) {
+         ksq = unitCell.ksq(basis.basisFunction(b).waveBz);
+         intra_.computeIntraCorrelations(ksq, correlations_);
+         for (i = 0; i < nMonomer; ++i) {
+            for (j = 0; j < nMonomer; ++j) {
+               jacobian_(i, j) = interaction_.p(i, j);
+               for (k = 0; k < nMonomer; ++k) {
+                  jacobian_(i, j) += vMonomer * interaction_.chi(i, k)
+                                     * correlations_(k, j);
+               }
+            }
+         }
+         solver_.computeLU(jacobian_);
+         solver_.inverse(inverse_);
+         for (i = 0; i < nMonomer; ++i) {
+            for (j = 0; j < nMonomer; ++j) {
+               inverseJacobian_[b*nBlock + i*nMonomer + j] = inverse_(i, j);
+            }
+         }
+      }
+   }
+
+   /*
+   * Correction step (second step of Anderson mixing).
+   *
+   * Applies the linear-response approximate inverse Jacobian to the
+   * components of each inhomogeneous basis function. Homogeneous and
+   * unit cell parameter components use simple mixing, as in the parent
+   * AmIteratorBasis.
+   */
+   template <int D>
+   void
+   LrAmIteratorBasis<D>::addPredictedError(DArray<double>& fieldTrial,
+                                           DArray<double> const & resTrial,
+                                           double lambda)
+   {
+      const int nMonomer = system().mixture().nMonomer();
+      const int nBasis = system().domain().basis().nBasis();
+      const int nBlock = nMonomer*nMonomer;
+      const int nField = nMonomer*nBasis;
+      UTIL_CHECK(inverseJacobian_.capacity() == nBasis*nBlock);
+
+      double dw;
+      int b, i, j;
+
+      // Homogeneous components
+      for (i = 0; i < nMonomer; ++i) {
+         fieldTrial[i*nBasis] += lambda * resTrial[i*nBasis];
+      }
+
+      // Inhomogeneous components
+      for (b = 1; b < nBasis; ++b) {
+         double const * inv = &inverseJacobian_[b*nBlock];
+         for (i = 0; i < nMonomer; ++i) {
+            dw = 0.0;
+            for (j = 0; j < nMonomer; ++j) {
+               dw += inv[i*nMonomer + j] * resTrial[j*nBasis + b];
+            }
+            fieldTrial[i*nBasis + b] += lambda * dw;
+         }
+      }
+
+      // Unit cell parameters
+      const int n = fieldTrial.capacity();
+      for (i = nField; i < n; ++i) {
+         fieldTrial[i] += lambda * resTrial[i];
+      }
+   }
+
+}
+}
+#endif
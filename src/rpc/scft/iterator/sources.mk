@@ -1,8 +1,11 @@
 rpc_scft_iterator_= \
   rpc/scft/iterator/AmIteratorBasis.cpp \
+  rpc/scft/iterator/AmIteratorGrid.cpp \
   rpc/scft/iterator/ExtGenFilm.cpp \
   rpc/scft/iterator/ImposedFieldsGenerator.cpp \
   rpc/scft/iterator/IteratorFactory.cpp \
+  rpc/scft/iterator/JfnkIteratorGrid.cpp \
+  rpc/scft/iterator/LrAmIteratorBasis.cpp \
   rpc/scft/iterator/MaskGenFilm.cpp
 
 rpc_scft_iterator_OBJS=\
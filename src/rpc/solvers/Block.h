@@ -9,14 +9,19 @@
 */
 
 #include "Propagator.h"                   // base class argument
+#include "StepAlgorithm.h"                // member
+#include <rpc/solvers/ExpCache.h>         // function argument
+#include <rpc/solvers/WaveList.h>         // member
 #include <prdc/cpu/FFT.h>                 // member
+#include <prdc/cpu/FFTBatched.h>          // member
+#include <prdc/cpu/FFTMirror.h>           // member
+#include <prdc/cpu/FftwDArray.h>          // member
 #include <prdc/cpu/RField.h>              // member
 #include <prdc/cpu/RFieldDft.h>           // member
 #include <prdc/crystal/UnitCell.h>        // member
 #include <pscf/solvers/BlockTmpl.h>       // base class template
 #include <pscf/mesh/Mesh.h>               // member
 #include <util/containers/FArray.h>       // member template
-#include <util/containers/DMatrix.h>      // member template
 
 namespace Pscf {
    template <int D> class Mesh;
@@ -61,15 +66,18 @@ namespace Rpc {
       * Initialize discretization and allocate required memory.
       *
       * This function creates associations of this block with the mesh, 
-      * fft, and unit cell objects.
+      * fft, unit cell and wavelist objects. The WaveList<D> is usually
+      * shared by all blocks of a Mixture.
       *
       * \param mesh  spatial discretization mesh
       * \param fft  Fast Fourier Transform object
       * \param cell  unit cell object
+      * \param wavelist  WaveList<D> object - properties of wavevectors
       */
       void associate(Mesh<D> const& mesh, 
                      FFT<D> const& fft, 
-                     UnitCell<D> const& cell);
+                     UnitCell<D> const& cell,
+                     WaveList<D>& wavelist);
 
       /**
       * Allocate memory and set contour step size.
@@ -87,9 +95,112 @@ namespace Rpc {
       * rule for integration with respect to the contour variable s to
       * compute monomer concentration fields and stress contributions.
       *
+      * If useCheckpoints is true, the associated propagators store only
+      * checkpoint slices. If useFloat is true, the propagators store 
+      * interior slices in single precision (see Propagator<D>::allocate).
+      *
       * \param ds desired (optimal) value for contour length step
+      * \param useCheckpoints  if true, propagators store checkpoints only
+      * \param useFloat  if true, propagators store float slices
+      */
+      void allocate(double ds, bool useCheckpoints = false, 
+                    bool useFloat = false);
+
+      /**
+      * Enable or disable fused computation of the block concentration.
+      *
+      * If fuse is true, the Simpson integral for the block concentration
+      * is accumulated while the second of the two propagators of this
+      * block is solved (i.e., whichever propagator is solved after its
+      * partner), by calls to accumulateConcentration. The separate pass
+      * over all slices of both propagators in computeConcentration is 
+      * then replaced by a single normalization pass.
+      *
+      * The parameter secondId is the direction id (0 or 1) of the
+      * propagator that is expected to be solved second. Unless slices 
+      * are stored in single precision, that propagator stores only 
+      * checkpoint slices, because its interior slices are not needed to 
+      * compute the concentration. Slices that are needed later (e.g., 
+      * to compute stress) are then recomputed on demand. If secondId is
+      * -1, the storage mode passed to allocate is used for both. This
+      * function must be called before allocate.
+      *
+      * \param fuse  if true, compute the concentration during solution
+      * \param secondId  direction id of propagator solved second, or -1
+      */
+      void setFuseConcentration(bool fuse, int secondId = -1);
+
+      /**
+      * Store interior propagator slices on the asymmetric unit.
+      *
+      * If orbits is not null, both propagators store interior slices 
+      * with one value per orbit of mesh nodes (see 
+      * Propagator::setMeshOrbits), and the contour integral for the 
+      * block concentration is evaluated on the asymmetric unit. This is
+      * valid only if the w field is invariant under the space group 
+      * used to construct the orbits. The orbits object must not be 
+      * destroyed or modified while this block exists. This function 
+      * must be called before allocate, and may not be combined with 
+      * checkpoint or float storage. In fused mode, the propagator that
+      * is solved second then stores all slices on the asymmetric unit,
+      * rather than only checkpoints.
+      *
+      * \param orbits  orbits of mesh nodes, or null for full storage
+      */
+      void setMeshOrbits(MeshOrbits<D> const * orbits);
+
+      /**
+      * Set the algorithm used to take one contour step.
+      *
+      * The default is StepAlgorithm::RQM4. The function setupSolver must
+      * be called after any change in the step algorithm, before solving
+      * the MDE.
+      *
+      * \param algorithm  contour step algorithm
+      */
+      void setStepAlgorithm(StepAlgorithm::Enum algorithm);
+
+      /**
+      * Enable or disable estimation of the contour step error.
+      *
+      * If enabled, every call to step() computes the maximum absolute
+      * difference between the results of one Strang splitting step of
+      * length ds and of two steps of length ds/2, divided by the 
+      * maximum of the new slice. This is an estimate of the local error
+      * of a single Strang step of length ds, which scales as ds^3, and 
+      * an upper bound for the error of the extrapolated step. The 
+      * maximum over all steps since the last call to clearStepError is
+      * returned by stepError().
+      *
+      * \param estimate  if true, estimate the step error
+      */
+      void setEstimateStepError(bool estimate);
+
+      /**
+      * Reset the maximum contour step error estimate to zero.
+      */
+      void clearStepError();
+
+      /**
+      * Set or clear a mirror-symmetric transform used by step().
+      *
+      * If fftMirror is not null, the next call to either setupSolver
+      * function prepares step() to solve the MDE on the reduced grid of
+      * the FFTMirror<D>, using real-to-real (cosine) transforms rather 
+      * than real-to-complex FFTs of the full field. This is valid only 
+      * if the w field and all propagator slices are even functions of
+      * every reduced coordinate, i.e., if the field is invariant under
+      * a space group that contains a mirror plane through the origin 
+      * normal to each axis (see SpaceGroup::hasMirrorPlanes). Reduced 
+      * grid solution is only used with the RQM4 step algorithm and a 
+      * unit cell with mutually orthogonal Bravais basis vectors, for 
+      * which exp(-k^2 b^2 ds/6) is also even in each wavevector index. 
+      * Otherwise, step() uses the full grid. Propagator slices are 
+      * stored on the full grid in either case.
+      *
+      * \param fftMirror  mirror transform for the mesh, or null to clear
       */
-      void allocate(double ds);
+      void setMirrorFFT(FFTMirror<D> const * fftMirror);
 
       /**
       * Clear all internal data that depends on the unit cell parameters
@@ -108,6 +219,18 @@ namespace Rpc {
       */
       void setLength(double newLength);
 
+      /**
+      * Set or reset the desired contour length step size.
+      *
+      * This function may be called after allocate to change the value
+      * of the desired step size ds that was passed to allocate. It 
+      * recomputes ns() and the actual step size ds() by the rules used
+      * by allocate, and reallocates propagators if ns() changes.
+      *
+      * \param ds  new desired (optimal) value for contour length step
+      */
+      void setDs(double ds);
+
       /**
       * Set or reset monomer statistical segment length.
       *
@@ -121,12 +244,34 @@ namespace Rpc {
       * This should be called once after every change in w fields, the
       * unit cell parameters, block length or kuhn length, before
       * entering the loop used to solve the MDE for either propagator.
-      * This function is called by Polymer<D>::compute.
+      * This function is called by Polymer<D>::compute. It computes 
+      * arrays that are owned by this block, and allocates them on the
+      * first call.
       *
       * \param w chemical potential field for this monomer type
       */
       void setupSolver(RField<D> const & w);
 
+      /**
+      * Set solver for this block, using externally computed arrays.
+      *
+      * This is an alternative to setupSolver(RField<D> const&) in which
+      * the block uses arrays computed and owned by an ExpCache<D>, 
+      * usually owned by the parent Mixture and shared by all blocks with
+      * the same monomer type, statistical segment length and contour 
+      * step. The cache entries must have been computed using the values
+      * of ds() and kuhn() of this block, and the step algorithm of the 
+      * cache must match that of this block. The arrays must not be 
+      * modified or destroyed before the MDE is solved. Like 
+      * setupSolver(w), this function must be called again after any 
+      * change in block length, kuhn length or unit cell parameters.
+      *
+      * \param cache  cache of exponential arrays
+      * \param wId  index of expW entry of the cache (see expWId)
+      * \param kId  index of expKsq entry of the cache (see expKsqId)
+      */
+      void setupSolver(ExpCache<D> const & cache, int wId, int kId);
+
       /**
       * Compute one step of solution of MDE, from step i to i+1.
       *
@@ -135,6 +280,10 @@ namespace Rpc {
       * Block class because the same private data structures are needed
       * for the two propagators associated with a Block.
       *
+      * The algorithm is chosen by setStepAlgorithm: RQM4 combines 
+      * Strang splitting steps of length ds and ds/2 by Richardson 
+      * extrapolation, and RQM6 adds four steps of length ds/4.
+      *
       * \param q  input slic of q, from step i
       * \param qNew  ouput slice of q, from step i+1
       */
@@ -162,6 +311,23 @@ namespace Rpc {
       */
       void computeConcentration(double prefactor);
 
+      /**
+      * Add the contribution of one slice to a fused concentration integral.
+      *
+      * This function is called by Propagator<D>::solve for every slice
+      * i of a propagator of this block, in order of increasing i, if
+      * fuseConcentration() is true and the partner propagator has 
+      * already been solved. The call with i = 0 initializes cField(), 
+      * and the call with i = ns() - 1 completes the unnormalized integral,
+      * which is normalized by the next call to computeConcentration.
+      *
+      * \param i  index of slice of the propagator being solved
+      * \param q  slice i of the propagator being solved
+      * \param partner  partner of the propagator being solved
+      */
+      void accumulateConcentration(int i, RField<D> const & q, 
+                                   Propagator<D> const & partner);
+
       /**
       * Compute stress contribution for this block.
       *
@@ -193,6 +359,26 @@ namespace Rpc {
       */
       int ns() const;
 
+      /**
+      * Is the block concentration computed during the second solve?
+      */
+      bool fuseConcentration() const;
+
+      /**
+      * Get the contour step algorithm.
+      */
+      StepAlgorithm::Enum stepAlgorithm() const;
+
+      /**
+      * Get the desired contour step size (as passed to allocate or setDs).
+      */
+      double dsTarget() const;
+
+      /**
+      * Get the maximum contour step error estimate (see stepError).
+      */
+      double stepError() const;
+
       /**
       * Get derivative of free energy w/ respect to unit cell parameter n.
       *
@@ -223,39 +409,90 @@ namespace Rpc {
 
    private:
 
-      // Matrix to store derivatives of plane waves
-      DMatrix<double> dGsq_;
-
       // Stress arising from this block
       FSArray<double, 6> stress_;
 
       // Fourier transform plan
       // FFT<D> fft_;
 
-      // Array of elements containing exp(-K^2 b^2 ds/6)
+      // Array of elements containing exp(-K^2 b^2 ds/6)/N
+      // (includes the 1/N normalization of an unscaled forward FFT)
       RField<D> expKsq_;
 
       // Array of elements containing exp(-W[i] ds/2)
       RField<D> expW_;
 
-      // Array of elements containing exp(-K^2 b^2 ds/(6*2))
+      // Array of elements containing exp(-K^2 b^2 ds/(6*2))/N
       RField<D> expKsq2_;
 
       // Array of elements containing exp(-W[i] (ds/2)*0.5)
       RField<D> expW2_;
 
-      // Work array for real-space field (step size ds)
-      RField<D> qr_;
+      // Array of elements containing exp(-K^2 b^2 ds/(6*4))/N (RQM6)
+      RField<D> expKsq4_;
+
+      // Array of elements containing exp(-W[i] (ds/2)*0.25) (RQM6)
+      RField<D> expW4_;
+
+      // Pointers to arrays used by step(). These point either to the
+      // arrays expKsq_, expW_, etc. owned by this block, or to arrays 
+      // owned by an ExpCache<D>. Pointers expKsq4Ptr_ and expW4Ptr_ 
+      // are used only by the RQM6 algorithm.
+      RField<D> const * expKsqPtr_;
+      RField<D> const * expWPtr_;
+      RField<D> const * expKsq2Ptr_;
+      RField<D> const * expW2Ptr_;
+      RField<D> const * expKsq4Ptr_;
+      RField<D> const * expW4Ptr_;
+
+      // Batched FFT used to transform two fields at once
+      FFTBatched<D> fftBatchedPair_;
+
+      // Pair of contiguous real-space work fields (step sizes ds, ds/2)
+      FftwDArray<double> qrPair_;
+
+      // Pair of contiguous wavevector space work fields (ds, ds/2)
+      FftwDArray<fftw_complex> qkPair_;
 
       // Work array for real-space field (step size ds/2)
       RField<D> qr2_;
 
-      // Work array for wavevector space field (step size ds)
-      RFieldDft<D> qk_;
-
       // Work array for wavevector space field (step size ds/2)
       RFieldDft<D> qk2_;
 
+      // Work array for real-space field (step size ds/4, RQM6 only)
+      RField<D> qr4_;
+
+      // Simpson-weighted sum of Re[q0(k,s) q1*(k,L-s)] (stress only)
+      RField<D> qqk_;
+
+      // Concentration integral on the asymmetric unit (orbits only)
+      DArray<double> cOrbit_;
+
+      // Pointer to orbits of mesh nodes (null unless using orbits)
+      MeshOrbits<D> const* orbitsPtr_;
+
+      // Arrays on the reduced grid of fftMirrorPtr_, used by stepMirror.
+      // Arrays expKsqMirror_ and expKsq2Mirror_ contain exp(-K^2 b^2 
+      // ds/6)/N and exp(-K^2 b^2 ds/(6*2))/N, respectively. Arrays 
+      // expWMirror_ and expW2Mirror_ contain reduced grid values of the
+      // arrays pointed to by expWPtr_ and expW2Ptr_.
+      RField<D> expKsqMirror_;
+      RField<D> expKsq2Mirror_;
+      RField<D> expWMirror_;
+      RField<D> expW2Mirror_;
+
+      // Work arrays on the reduced grid (step sizes ds and ds/2, input)
+      RField<D> qMirror_;
+      RField<D> qMirror2_;
+      RField<D> qMirrorIn_;
+
+      // Work array for reduced grid cosine transforms
+      RField<D> qkMirror_;
+
+      // Pointer to mirror transform, or null if not used
+      FFTMirror<D> const* fftMirrorPtr_;
+
       // Pointer to associated Mesh<D> object
       Mesh<D> const* meshPtr_;
 
@@ -265,6 +502,9 @@ namespace Rpc {
       // Pointer to associated UnitCell<D> object
       UnitCell<D> const* unitCellPtr_;
 
+      // Pointer to associated WaveList<D> object
+      WaveList<D>* waveListPtr_;
+
       // Dimensions of wavevector mesh in real-to-complex transform
       IntVec<D> kMeshDimensions_;
 
@@ -280,12 +520,36 @@ namespace Rpc {
       // Number of contour grid points = # of contour steps + 1
       int ns_;
 
+      // Direction id of propagator solved second in fused mode (or -1)
+      int fusedSecondId_;
+
+      // Contour step algorithm
+      StepAlgorithm::Enum stepAlgorithm_;
+
+      // Maximum relative step error estimate since clearStepError()
+      double stepError_;
+
       // Have arrays been allocated ?
       bool isAllocated_;
 
+      // Is the concentration integral accumulated during solution?
+      bool fuseConcentration_;
+
+      // Does cField() hold a completed, unnormalized fused integral?
+      bool hasFusedConcentration_;
+
       // Are expKsq_ arrays up to date ? (initialize false)
       bool hasExpKsq_;
 
+      // Should step() estimate the step error?
+      bool estimateStepError_;
+
+      // Are expKsqMirror_ arrays up to date ? (initialize false)
+      bool hasExpKsqMirror_;
+
+      // Does step() use the reduced grid of fftMirrorPtr_ ?
+      bool useMirror_;
+
       /**
       * Access associated UnitCell<D> as reference.
       */
@@ -293,15 +557,46 @@ namespace Rpc {
       {  return *unitCellPtr_; }
 
       /**
-      * Compute dGsq_ matrix.
+      * Access associated WaveList<D> as reference.
       */
-      void computedGsq();
+      WaveList<D> const & wavelist() const
+      {  return *waveListPtr_; }
 
       /**
       * Compute expKSq_ arrays.
       */
       void computeExpKsq();
 
+      /**
+      * Invalidate pointers to arrays used by step().
+      */
+      void clearExpPtrs();
+
+      /**
+      * Prepare reduced grid arrays used by stepMirror, if possible.
+      *
+      * Called at the end of each setupSolver function. Sets useMirror_.
+      */
+      void setupMirror();
+
+      /**
+      * Compute expKsqMirror_ and expKsq2Mirror_ arrays.
+      */
+      void computeExpKsqMirror();
+
+      /**
+      * Compute one RQM4 step on the reduced grid of fftMirrorPtr_.
+      *
+      * \param q  input slice of q, from step i
+      * \param qNew  ouput slice of q, from step i+1
+      */
+      void stepMirror(RField<D> const & q, RField<D>& qNew);
+
+      /**
+      * Set ns_ and ds_ from length() and dsTarget_, reallocate if needed.
+      */
+      void setNs();
+
    };
 
    // Inline member functions
@@ -316,6 +611,26 @@ namespace Rpc {
    inline double Block<D>::ds() const
    {  return ds_; }
 
+   /// Is the block concentration computed during the second solve?
+   template <int D>
+   inline bool Block<D>::fuseConcentration() const
+   {  return fuseConcentration_; }
+
+   /// Get the contour step algorithm.
+   template <int D>
+   inline StepAlgorithm::Enum Block<D>::stepAlgorithm() const
+   {  return stepAlgorithm_; }
+
+   /// Get the desired contour step size.
+   template <int D>
+   inline double Block<D>::dsTarget() const
+   {  return dsTarget_; }
+
+   /// Get the maximum contour step error estimate.
+   template <int D>
+   inline double Block<D>::stepError() const
+   {  return stepError_; }
+
    /// Stress with respect to unit cell parameter n.
    template <int D>
    inline double Block<D>::stress(int n) const
@@ -10,15 +10,17 @@
 
 #include "Block.h"
 #include <prdc/crystal/UnitCell.h>
-#include <prdc/crystal/shiftToMinimum.h>
+#include <prdc/cpu/VecOp.h>
 #include <pscf/mesh/Mesh.h>
 #include <pscf/mesh/MeshIterator.h>
 #include <pscf/math/IntVec.h>
-#include <util/containers/DMatrix.h>
 #include <util/containers/DArray.h>
 #include <util/containers/FArray.h>
 #include <util/containers/FSArray.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace Pscf {
 namespace Rpc {
 
@@ -31,15 +33,33 @@ namespace Rpc {
    */
    template <int D>
    Block<D>::Block()
-    : meshPtr_(0),
+    : expKsqPtr_(0),
+      expWPtr_(0),
+      expKsq2Ptr_(0),
+      expW2Ptr_(0),
+      expKsq4Ptr_(0),
+      expW4Ptr_(0),
+      fftMirrorPtr_(0),
+      orbitsPtr_(0),
+      meshPtr_(0),
       fftPtr_(0),
+      unitCellPtr_(0),
+      waveListPtr_(0),
       kMeshDimensions_(0),
       kSize_(0),
       ds_(0.0),
       dsTarget_(0.0),
       ns_(0),
+      fusedSecondId_(-1),
+      stepAlgorithm_(StepAlgorithm::RQM4),
+      stepError_(0.0),
       isAllocated_(false),
-      hasExpKsq_(false)
+      fuseConcentration_(false),
+      hasFusedConcentration_(false),
+      hasExpKsq_(false),
+      estimateStepError_(false),
+      hasExpKsqMirror_(false),
+      useMirror_(false)
    {
       propagator(0).setBlock(*this);
       propagator(1).setBlock(*this);
@@ -53,20 +73,22 @@ namespace Rpc {
    {}
 
    /*
-   * Store addresses of mesh, FFT and unit cell.
+   * Store addresses of mesh, FFT, unit cell and wavelist.
    */
    template <int D>
    void Block<D>::associate(Mesh<D> const & mesh,
                             FFT<D> const& fft,
-                            UnitCell<D> const& cell)
+                            UnitCell<D> const& cell,
+                            WaveList<D>& wavelist)
    {
       // Preconditions
       UTIL_CHECK(!isAllocated_);
 
-      // Set pointers to mesh and fft
+      // Set pointers to mesh, fft, unit cell and wavelist
       meshPtr_ = &mesh;
       fftPtr_ = &fft;
       unitCellPtr_ = &cell;
+      waveListPtr_ = &wavelist;
 
       hasExpKsq_ = false;
    }
@@ -75,12 +97,13 @@ namespace Rpc {
    * Compute number of contour steps and allocate all memory.
    */
    template <int D>
-   void Block<D>::allocate(double ds)
+   void Block<D>::allocate(double ds, bool useCheckpoints, bool useFloat)
    {
       UTIL_CHECK(ds > 0.0);
       UTIL_CHECK(meshPtr_);
       UTIL_CHECK(fftPtr_);
       UTIL_CHECK(unitCellPtr_);
+      UTIL_CHECK(waveListPtr_);
       UTIL_CHECK(mesh().size() > 1);
       UTIL_CHECK(mesh().dimensions() == fft().meshDimensions());
       UTIL_CHECK(!isAllocated_);
@@ -88,13 +111,7 @@ namespace Rpc {
 
       // Set contour length discretization for this block
       dsTarget_ = ds;
-      int tempNs;
-      tempNs = floor( length()/(2.0 *ds) + 0.5 );
-      if (tempNs == 0) {
-         tempNs = 1;
-      }
-      ns_ = 2*tempNs + 1;
-      ds_ = length()/double(ns_-1);
+      setNs();
 
       // Compute Fourier space kMeshDimensions_ and kSize_
       kSize_ = 1;
@@ -107,28 +124,110 @@ namespace Rpc {
          kSize_ *= kMeshDimensions_[i];
       }
 
-      // Allocate work arrays for MDE solution
-      expKsq_.allocate(kMeshDimensions_);
-      expKsq2_.allocate(kMeshDimensions_);
-      expW_.allocate(mesh().dimensions());
-      expW2_.allocate(mesh().dimensions());
-      qr_.allocate(mesh().dimensions());
-      qk_.allocate(mesh().dimensions());
+      // Allocate work arrays for MDE solution. Arrays expKsq_, expW_, 
+      // expKsq2_ and expW2_ are allocated by setupSolver(w) if needed.
+      qrPair_.allocate(2*mesh().size());
+      qkPair_.allocate(2*kSize_);
       qr2_.allocate(mesh().dimensions());
       qk2_.allocate(mesh().dimensions());
+      qqk_.allocate(kMeshDimensions_);
+      if (orbitsPtr_) {
+         UTIL_CHECK(orbitsPtr_->meshSize() == mesh().size());
+         cOrbit_.allocate(orbitsPtr_->nOrbit());
+      }
 
-      // Allocate work array for stress calculation
-      dGsq_.allocate(kSize_, 6);
+      // Setup batched FFT for pairs of fields
+      UTIL_CHECK(!fftBatchedPair_.isSetup());
+      fftBatchedPair_.setup(mesh().dimensions(), 2);
 
       // Allocate block concentration field
       cField().allocate(mesh().dimensions());
 
-      // Allocate memory for solutions to MDE (requires ns_)
-      propagator(0).allocate(ns_, mesh());
-      propagator(1).allocate(ns_, mesh());
+      // Allocate memory for solutions to MDE (requires ns_). In fused
+      // mode, the propagator solved second stores only checkpoints,
+      // unless slices are stored in single precision or on orbits.
+      bool useCheckpoints0 = useCheckpoints;
+      bool useCheckpoints1 = useCheckpoints;
+      if (fuseConcentration_ && !useFloat && !orbitsPtr_) {
+         if (fusedSecondId_ == 0) useCheckpoints0 = true;
+         if (fusedSecondId_ == 1) useCheckpoints1 = true;
+      }
+      propagator(0).setMeshOrbits(orbitsPtr_);
+      propagator(1).setMeshOrbits(orbitsPtr_);
+      propagator(0).allocate(ns_, mesh(), useCheckpoints0, useFloat);
+      propagator(1).allocate(ns_, mesh(), useCheckpoints1, useFloat);
 
       isAllocated_ = true;
       hasExpKsq_ = false;
+      clearExpPtrs();
+   }
+
+   /*
+   * Enable or disable fused computation of the block concentration.
+   */
+   template <int D>
+   void Block<D>::setFuseConcentration(bool fuse, int secondId)
+   {
+      UTIL_CHECK(!isAllocated_);
+      UTIL_CHECK(secondId >= -1 && secondId <= 1);
+      fuseConcentration_ = fuse;
+      fusedSecondId_ = fuse ? secondId : -1;
+      hasFusedConcentration_ = false;
+   }
+
+   /*
+   * Set orbits used to store slices on the asymmetric unit.
+   */
+   template <int D>
+   void Block<D>::setMeshOrbits(MeshOrbits<D> const * orbits)
+   {
+      UTIL_CHECK(!isAllocated_);
+      orbitsPtr_ = orbits;
+   }
+
+   /*
+   * Set the contour step algorithm.
+   */
+   template <int D>
+   void Block<D>::setStepAlgorithm(StepAlgorithm::Enum algorithm)
+   {
+      stepAlgorithm_ = algorithm;
+      hasExpKsq_ = false;
+      clearExpPtrs();
+   }
+
+   /*
+   * Enable or disable estimation of the contour step error.
+   */
+   template <int D>
+   void Block<D>::setEstimateStepError(bool estimate)
+   {
+      estimateStepError_ = estimate;
+      stepError_ = 0.0;
+   }
+
+   /*
+   * Reset the maximum contour step error estimate.
+   */
+   template <int D>
+   void Block<D>::clearStepError()
+   {  stepError_ = 0.0; }
+
+   /*
+   * Set or clear the mirror-symmetric transform used by step().
+   */
+   template <int D>
+   void Block<D>::setMirrorFFT(FFTMirror<D> const * fftMirror)
+   {
+      if (fftMirror) {
+         UTIL_CHECK(fftMirror->isSetup());
+         UTIL_CHECK(fftMirror->meshDimensions() == mesh().dimensions());
+      }
+      if (fftMirror != fftMirrorPtr_) {
+         hasExpKsqMirror_ = false;
+      }
+      fftMirrorPtr_ = fftMirror;
+      useMirror_ = false;
    }
 
    /*
@@ -142,24 +241,48 @@ namespace Rpc {
       if (isAllocated_) { 
          // Reset contour length discretization
          UTIL_CHECK(dsTarget_ > 0);
-         int oldNs = ns_;
-         int tempNs;
-         tempNs = floor( length()/(2.0 *dsTarget_) + 0.5 );
-         if (tempNs == 0) {
-            tempNs = 1;
-         }
-         ns_ = 2*tempNs + 1;
-         ds_ = length()/double(ns_-1);
-
-         if (oldNs != ns_) {
-            // If propagators are already allocated and ns_ has changed,
-            // reallocate memory for solutions to MDE
-            propagator(0).reallocate(ns_);
-            propagator(1).reallocate(ns_);
-         }
+         setNs();
       }
 
       hasExpKsq_ = false;
+      clearExpPtrs();
+   }
+
+   /*
+   * Set or reset the desired contour length step size.
+   */
+   template <int D>
+   void Block<D>::setDs(double ds)
+   {
+      UTIL_CHECK(isAllocated_);
+      UTIL_CHECK(ds > 0.0);
+      dsTarget_ = ds;
+      setNs();
+      hasExpKsq_ = false;
+      clearExpPtrs();
+   }
+
+   /*
+   * Choose odd ns_ so that ds_ = length()/(ns_ - 1) is near dsTarget_.
+   */
+   template <int D>
+   void Block<D>::setNs()
+   {
+      int oldNs = ns_;
+      int tempNs;
+      tempNs = floor( length()/(2.0 *dsTarget_) + 0.5 );
+      if (tempNs == 0) {
+         tempNs = 1;
+      }
+      ns_ = 2*tempNs + 1;
+      ds_ = length()/double(ns_-1);
+
+      if (isAllocated_ && oldNs != ns_) {
+         // If propagators are already allocated and ns_ has changed,
+         // reallocate memory for solutions to MDE
+         propagator(0).reallocate(ns_);
+         propagator(1).reallocate(ns_);
+      }
    }
 
    /*
@@ -170,6 +293,7 @@ namespace Rpc {
    {
       BlockTmpl< Propagator<D> >::setKuhn(kuhn);
       hasExpKsq_ = false;
+      clearExpPtrs();
    }
 
    /*
@@ -177,10 +301,34 @@ namespace Rpc {
    */
    template <int D>
    void Block<D>::clearUnitCellData()
-   {  hasExpKsq_ = false; }
+   {
+      hasExpKsq_ = false;
+      clearExpPtrs();
+   }
+
+   /*
+   * Invalidate pointers and reduced grid arrays used by step().
+   */
+   template <int D>
+   void Block<D>::clearExpPtrs()
+   {
+      expKsqPtr_ = 0;
+      expWPtr_ = 0;
+      expKsq2Ptr_ = 0;
+      expW2Ptr_ = 0;
+      expKsq4Ptr_ = 0;
+      expW4Ptr_ = 0;
+      hasExpKsqMirror_ = false;
+      useMirror_ = false;
+   }
 
    /*
-   * Compute all elements of expKsq_ and expKsq2_ arrays
+   * Compute all elements of expKsq_ and expKsq2_ arrays.
+   *
+   * Both arrays include a factor 1/N, where N is the number of r-grid
+   * points, which normalizes the unscaled forward FFTs used in step().
+   * Values of |k|^2 are taken from the associated WaveList, which is
+   * computed only once after each change in unit cell parameters.
    */
    template <int D>
    void Block<D>::computeExpKsq()
@@ -188,20 +336,31 @@ namespace Rpc {
       UTIL_CHECK(isAllocated_);
       UTIL_CHECK(unitCellPtr_);
       UTIL_CHECK(unitCellPtr_->isInitialized());
+      UTIL_CHECK(waveListPtr_);
+
+      // Compute kSq in the wavelist, if necessary
+      if (!waveListPtr_->hasKSq()) {
+         waveListPtr_->computeKSq();
+      }
+      RField<D> const & kSq = wavelist().kSq();
+      UTIL_CHECK(kSq.capacity() == kSize_);
 
-      MeshIterator<D> iter;
-      iter.setDimensions(kMeshDimensions_);
-      IntVec<D> G, Gmin;
-      double Gsq;
       double factor = -1.0*kuhn()*kuhn()*ds_/6.0;
-      int i;
-      for (iter.begin(); !iter.atEnd(); ++iter) {
-         i = iter.rank();
-         G = iter.position();
-         Gmin = shiftToMinimum(G, mesh().dimensions(), unitCell());
-         Gsq = unitCell().ksq(Gmin);
-         expKsq_[i] = exp(Gsq*factor);
-         expKsq2_[i] = exp(Gsq*factor*0.5);
+      double scale = 1.0/double(mesh().size());
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for
+      #endif
+      for (int i = 0; i < kSize_; ++i) {
+         expKsq_[i] = exp(kSq[i]*factor)*scale;
+         expKsq2_[i] = exp(kSq[i]*factor*0.5)*scale;
+      }
+      if (stepAlgorithm_ == StepAlgorithm::RQM6) {
+         #ifdef PSCF_OPENMP
+         #pragma omp parallel for
+         #endif
+         for (int i = 0; i < kSize_; ++i) {
+            expKsq4_[i] = exp(kSq[i]*factor*0.25)*scale;
+         }
       }
 
       hasExpKsq_ = true;
@@ -219,17 +378,30 @@ namespace Rpc {
       UTIL_CHECK(nx > 0);
       UTIL_CHECK(isAllocated_);
 
-      // Compute expW arrays
-      for (int i = 0; i < nx; ++i) {
-
-         // First, check that w[i]*ds_ is not unreasonably large:
-         // (if this condition is not met, solution will have large
-         // error, and user should consider using a smaller ds_)
-         //UTIL_CHECK(std::abs(w[i]*ds_) < 1.0);
+      // Allocate arrays owned by this block, if necessary
+      if (!expW_.isAllocated()) {
+         expKsq_.allocate(kMeshDimensions_);
+         expKsq2_.allocate(kMeshDimensions_);
+         expW_.allocate(mesh().dimensions());
+         expW2_.allocate(mesh().dimensions());
+         hasExpKsq_ = false;
+      }
+      if (stepAlgorithm_ == StepAlgorithm::RQM6) {
+         if (!expW4_.isAllocated()) {
+            expKsq4_.allocate(kMeshDimensions_);
+            expW4_.allocate(mesh().dimensions());
+            hasExpKsq_ = false;
+         }
+         if (!qr4_.isAllocated()) {
+            qr4_.allocate(mesh().dimensions());
+         }
+      }
 
-         // Calculate values
-         expW_[i] = exp(-0.5*w[i]*ds_);
-         expW2_[i] = exp(-0.5*0.5*w[i]*ds_);
+      // Compute expW arrays
+      VecOp::expVc(expW_, w, -0.5*ds_);
+      VecOp::expVc(expW2_, w, -0.5*0.5*ds_);
+      if (stepAlgorithm_ == StepAlgorithm::RQM6) {
+         VecOp::expVc(expW4_, w, -0.5*0.25*ds_);
       }
 
       // Compute expKsq arrays if necessary
@@ -237,6 +409,137 @@ namespace Rpc {
          computeExpKsq();
       }
 
+      // Use arrays owned by this block in step()
+      expKsqPtr_ = &expKsq_;
+      expWPtr_ = &expW_;
+      expKsq2Ptr_ = &expKsq2_;
+      expW2Ptr_ = &expW2_;
+      if (stepAlgorithm_ == StepAlgorithm::RQM6) {
+         expKsq4Ptr_ = &expKsq4_;
+         expW4Ptr_ = &expW4_;
+      }
+
+      setupMirror();
+   }
+
+   /*
+   * Setup the contour length step algorithm, using external arrays.
+   */
+   template <int D>
+   void
+   Block<D>::setupSolver(ExpCache<D> const & cache, int wId, int kId)
+   {
+      // Preconditions
+      UTIL_CHECK(isAllocated_);
+      int nx = mesh().size();
+      UTIL_CHECK(nx > 0);
+      UTIL_CHECK(cache.stepAlgorithm() == stepAlgorithm_);
+      UTIL_CHECK(wId >= 0 && wId < cache.nExpW());
+      UTIL_CHECK(kId >= 0 && kId < cache.nExpKsq());
+      UTIL_CHECK(cache.expW(wId).capacity() == nx);
+      UTIL_CHECK(cache.expKsq(kId).capacity() == kSize_);
+
+      expKsqPtr_ = &cache.expKsq(kId);
+      expWPtr_ = &cache.expW(wId);
+      expKsq2Ptr_ = &cache.expKsq2(kId);
+      expW2Ptr_ = &cache.expW2(wId);
+      if (stepAlgorithm_ == StepAlgorithm::RQM6) {
+         expKsq4Ptr_ = &cache.expKsq4(kId);
+         expW4Ptr_ = &cache.expW4(wId);
+         if (!qr4_.isAllocated()) {
+            qr4_.allocate(mesh().dimensions());
+         }
+      }
+
+      setupMirror();
+   }
+
+   /*
+   * Prepare reduced grid arrays for stepMirror, if possible.
+   *
+   * The reduced grid algorithm requires RQM4 and a unit cell with 
+   * orthogonal Bravais basis vectors, for which |k|^2 is unchanged by
+   * reversing the sign of any wavevector index. Values of expW and 
+   * expW2 are copied from the full grid arrays used by step().
+   */
+   template <int D>
+   void Block<D>::setupMirror()
+   {
+      useMirror_ = false;
+      if (!fftMirrorPtr_) return;
+      if (stepAlgorithm_ != StepAlgorithm::RQM4) return;
+      UTIL_CHECK(expWPtr_);
+      UTIL_CHECK(expW2Ptr_);
+
+      // Check that Bravais basis vectors are mutually orthogonal
+      int i, j, k;
+      double dot, normI, normJ;
+      for (i = 1; i < D; ++i) {
+         for (j = 0; j < i; ++j) {
+            dot = 0.0;
+            normI = 0.0;
+            normJ = 0.0;
+            for (k = 0; k < D; ++k) {
+               dot += unitCell().rBasis(i)[k]*unitCell().rBasis(j)[k];
+               normI += unitCell().rBasis(i)[k]*unitCell().rBasis(i)[k];
+               normJ += unitCell().rBasis(j)[k]*unitCell().rBasis(j)[k];
+            }
+            if (std::abs(dot) > 1.0E-10*std::sqrt(normI*normJ)) return;
+         }
+      }
+
+      // Allocate reduced grid arrays, if necessary
+      FFTMirror<D> const & fftMirror = *fftMirrorPtr_;
+      IntVec<D> const & dimensions = fftMirror.reducedDimensions();
+      if (!expWMirror_.isAllocated()) {
+         expKsqMirror_.allocate(dimensions);
+         expKsq2Mirror_.allocate(dimensions);
+         expWMirror_.allocate(dimensions);
+         expW2Mirror_.allocate(dimensions);
+         qMirror_.allocate(dimensions);
+         qMirror2_.allocate(dimensions);
+         qMirrorIn_.allocate(dimensions);
+         qkMirror_.allocate(dimensions);
+         hasExpKsqMirror_ = false;
+      }
+      UTIL_CHECK(expWMirror_.capacity() == fftMirror.reducedSize());
+
+      fftMirror.gather(*expWPtr_, expWMirror_);
+      fftMirror.gather(*expW2Ptr_, expW2Mirror_);
+      if (!hasExpKsqMirror_) {
+         computeExpKsqMirror();
+      }
+      useMirror_ = true;
+   }
+
+   /*
+   * Compute expKsqMirror_ and expKsq2Mirror_ on the reduced grid.
+   *
+   * Element m of the reduced grid corresponds to a wavevector with
+   * non-negative indices equal to the reduced grid position of m. Both
+   * arrays include a factor 1/N, where N is the number of points in 
+   * the full mesh, which normalizes a forward and inverse pair of 
+   * unscaled cosine transforms.
+   */
+   template <int D>
+   void Block<D>::computeExpKsqMirror()
+   {
+      UTIL_CHECK(fftMirrorPtr_);
+      UTIL_CHECK(unitCellPtr_);
+      UTIL_CHECK(unitCellPtr_->isInitialized());
+
+      double factor = -1.0*kuhn()*kuhn()*ds_/6.0;
+      double scale = 1.0/double(mesh().size());
+      double kSq;
+      MeshIterator<D> iter;
+      iter.setDimensions(fftMirrorPtr_->reducedDimensions());
+      for (iter.begin(); !iter.atEnd(); ++iter) {
+         kSq = unitCell().ksq(iter.position());
+         expKsqMirror_[iter.rank()] = exp(kSq*factor)*scale;
+         expKsq2Mirror_[iter.rank()] = exp(kSq*factor*0.5)*scale;
+      }
+
+      hasExpKsqMirror_ = true;
    }
 
    /*
@@ -255,48 +558,129 @@ namespace Rpc {
       UTIL_CHECK(propagator(1).isAllocated());
       UTIL_CHECK(cField().capacity() == nx);
 
-      // Initialize cField to zero at all points
+      RField<D>& c = cField();
+      Propagator<D> const & p0 = propagator(0);
+      Propagator<D> const & p1 = propagator(1);
+
+      // Evaluate unnormalized integral, unless it was accumulated by
+      // accumulateConcentration during solution of the second propagator
       int i;
-      for (i = 0; i < nx; ++i) {
-         cField()[i] = 0.0;
+      if (!hasFusedConcentration_) {
+
+         // Endpoint contributions (also initializes cField)
+         {
+            RField<D> const & q0h = p0.q(0);
+            RField<D> const & q0t = p0.q(ns_ - 1);
+            RField<D> const & q1h = p1.q(0);
+            RField<D> const & q1t = p1.q(ns_ - 1);
+            VecOp::addVVcVVc(c, q0h, q1t, 1.0, q0t, q1h, 1.0);
+         }
+
+         // Interior points, with Simpson weights 4 (odd j) and 2 (even 
+         // j). Slices are visited in a single monotonic pass, so that 
+         // slices of propagators that store only checkpoints are 
+         // recomputed only once. If interior slices are stored in single
+         // precision, the float arrays are read directly, and products 
+         // are accumulated in double precision. If slices are stored on
+         // the asymmetric unit, the integral is evaluated there and then
+         // expanded to the full mesh.
+         double weight;
+         if (p0.useOrbits() && p1.useOrbits()) {
+            UTIL_CHECK(cOrbit_.capacity() == orbitsPtr_->nOrbit());
+            orbitsPtr_->reduce(c, cOrbit_);
+            for (int j = 1; j < (ns_ -1); ++j) {
+               weight = (j % 2 == 1) ? 4.0 : 2.0;
+               VecOp::addEqVVc(cOrbit_, p0.qOrbit(j), 
+                               p1.qOrbit(ns_ - 1 - j), weight);
+            }
+            orbitsPtr_->expand(cOrbit_, c);
+         } else {
+            for (int j = 1; j < (ns_ -1); ++j) {
+               weight = (j % 2 == 1) ? 4.0 : 2.0;
+               if (p0.useFloat()) {
+                  DArray<float> const & q0 = p0.qFloat(j);
+                  DArray<float> const & q1 = p1.qFloat(ns_ - 1 - j);
+                  #ifdef PSCF_OPENMP
+                  #pragma omp parallel for
+                  #endif
+                  for (i = 0; i < nx; ++i) {
+                     c[i] += double(q0[i]) * double(q1[i]) * weight;
+                  }
+               } else {
+                  RField<D> const & q0 = p0.q(j);
+                  RField<D> const & q1 = p1.q(ns_ - 1 - j);
+                  VecOp::addEqVVc(c, q0, q1, weight);
+               }
+            }
+         }
       }
+      hasFusedConcentration_ = false;
 
-      Propagator<D> const & p0 = propagator(0);
-      Propagator<D> const & p1 = propagator(1);
+      // Normalize the integral
+      prefactor *= ds_ / 3.0;
+      VecOp::mulEqS(c, prefactor);
+
+   }
+
+   /*
+   * Add the contribution of one slice to a fused concentration integral.
+   */
+   template <int D>
+   void Block<D>::accumulateConcentration(int i, RField<D> const & q,
+                                          Propagator<D> const & partner)
+   {
+      // Preconditions
+      UTIL_CHECK(fuseConcentration_);
+      UTIL_CHECK(i >= 0 && i < ns_);
+      int nx = mesh().size();
+      UTIL_CHECK(q.capacity() == nx);
+      UTIL_CHECK(cField().capacity() == nx);
+      UTIL_CHECK(partner.isSolved());
 
-      // Evaluate unnormalized integral
+      RField<D>& c = cField();
+      int ip = ns_ - 1 - i;  // index of matching slice of partner
+      int k;
 
-      // Endpoint contributions
-      for (i = 0; i < nx; ++i) {
-         cField()[i] += p0.q(0)[i]*p1.q(ns_ - 1)[i];
-         cField()[i] += p0.q(ns_ -1)[i]*p1.q(0)[i];
+      if (i == 0) {
+         // Initialize cField with the endpoint contribution
+         hasFusedConcentration_ = false;
+         VecOp::mulVV(c, q, partner.q(ip));
+         return;
       }
 
-      // Odd indices
-      int j;
-      for (j = 1; j < (ns_ -1); j += 2) {
-         for (i = 0; i < nx; ++i) {
-            cField()[i] += p0.q(j)[i] * p1.q(ns_ - 1 - j)[i] * 4.0;
-         }
+      // Simpson weights: 1 (endpoint), 4 (odd i) and 2 (even i)
+      double weight;
+      if (i == ns_ - 1) {
+         weight = 1.0;
+      } else {
+         weight = (i % 2 == 1) ? 4.0 : 2.0;
       }
 
-      // Even indices
-      for (j = 2; j < (ns_ -2); j += 2) {
-         for (i = 0; i < nx; ++i) {
-            cField()[i] += p0.q(j)[i] * p1.q(ns_ - 1 - j)[i] * 2.0;
+      if (partner.useFloat() && ip > 0) {
+         DArray<float> const & qp = partner.qFloat(ip);
+         #ifdef PSCF_OPENMP
+         #pragma omp parallel for
+         #endif
+         for (k = 0; k < nx; ++k) {
+            c[k] += q[k] * double(qp[k]) * weight;
          }
+      } else {
+         VecOp::addEqVVc(c, q, partner.q(ip), weight);
       }
 
-      // Normalize the integral
-      prefactor *= ds_ / 3.0;
-      for (i = 0; i < nx; ++i) {
-         cField()[i] *= prefactor;
+      if (i == ns_ - 1) {
+         hasFusedConcentration_ = true;
       }
-
    }
 
    /*
    * Integrate to Stress exerted by the chain for this block
+   *
+   * For each pair of matching slices q0(s) and q1(L-s), the product of
+   * Fourier components Re[q0(k) q1*(k)] is accumulated with Simpson
+   * weights in the k-grid array qqk_, in a single sweep over wavevectors
+   * per slice. The derivatives of |k|^2 with respect to all unit cell
+   * parameters are then applied only once, in a final sweep over qqk_.
    */
    template <int D>
    void Block<D>::computeStress(double prefactor)
@@ -310,100 +694,104 @@ namespace Rpc {
       UTIL_CHECK(ds_ > 0);
       UTIL_CHECK(propagator(0).isAllocated());
       UTIL_CHECK(propagator(1).isAllocated());
+      UTIL_CHECK(qqk_.capacity() == kSize_);
 
-      stress_.clear();
-
-      double dels, normal, increment;
-      int nParam, c, m;
-
-      normal = 3.0*6.0;
-
-      nParam = unitCell().nParameter();
-      c = kSize_;
+      int nParam = unitCell().nParameter();
+      int nk = kSize_;
+      int i, m;
 
-      FSArray<double, 6> dQ;
-
-      // Initialize work array and stress_ to zero at all points
-      int i;
-      for (i = 0; i < nParam; ++i) {
-         dQ.append(0.0);
-         stress_.append(0.0);
+      // Compute derivatives of |k|^2 in the wavelist, if necessary
+      if (!waveListPtr_->hasdKSq()) {
+         waveListPtr_->computedKSq();
       }
 
-      computedGsq();
-
       Propagator<D> const & p0 = propagator(0);
       Propagator<D> const & p1 = propagator(1);
 
-      // Evaluate unnormalized integral
+      // Accumulate Simpson-weighted products of Fourier components
+      double weight;
       for (int j = 0; j < ns_ ; ++j) {
 
-         qr_ = p0.q(j);
-         fft().forwardTransform(qr_, qk_);
-
-         qr2_ = p1.q(ns_ - 1 - j);
-         fft().forwardTransform(qr2_, qk2_);
-
-         dels = ds_;
-
-         if (j != 0 && j != ns_ - 1) {
-            if (j % 2 == 0) {
-               dels = dels*2.0;
-            } else {
-               dels = dels*4.0;
+         // Copy slices q0(j) and q1(ns-1-j) into qrPair_, transform both
+         if (p0.useFloat() && j != 0 && j != ns_ - 1) {
+            DArray<float> const & q0 = p0.qFloat(j);
+            DArray<float> const & q1 = p1.qFloat(ns_ - 1 - j);
+            #ifdef PSCF_OPENMP
+            #pragma omp parallel for
+            #endif
+            for (i = 0; i < nx; ++i) {
+               qrPair_[i] = q0[i];
+               qrPair_[nx + i] = q1[i];
+            }
+         } else
+         if (p0.useOrbits() && p1.useOrbits() 
+             && j != 0 && j != ns_ - 1) {
+            // Expand orbit slices directly into qrPair_. Propagator::q 
+            // would expand both into one shared buffer if p1 is 
+            // identical to p0, or to a propagator of another block.
+            UTIL_CHECK(orbitsPtr_);
+            orbitsPtr_->expand(p0.qOrbit(j), &qrPair_[0]);
+            orbitsPtr_->expand(p1.qOrbit(ns_ - 1 - j), &qrPair_[nx]);
+         } else {
+            RField<D> const & q0 = p0.q(j);
+            RField<D> const & q1 = p1.q(ns_ - 1 - j);
+            #ifdef PSCF_OPENMP
+            #pragma omp parallel for
+            #endif
+            for (i = 0; i < nx; ++i) {
+               qrPair_[i] = q0[i];
+               qrPair_[nx + i] = q1[i];
             }
          }
+         fftBatchedPair_.forwardTransformUnscaled(qrPair_, qkPair_);
+         fftw_complex const * qk = &qkPair_[0];
+         fftw_complex const * qk2 = &qkPair_[nk];
 
-         for (int n = 0; n < nParam ; ++n) {
-            increment = 0.0;
+         // Simpson weights: 1 (endpoints), 4 (odd j) and 2 (even j)
+         if (j == 0 || j == ns_ - 1) {
+            weight = 1.0;
+         } else {
+            weight = (j % 2 == 1) ? 4.0 : 2.0;
+         }
 
-            for (m = 0; m < c ; ++m) {
-               double prod = 0;
-               prod = (qk2_[m][0] * qk_[m][0]) + (qk2_[m][1] * qk_[m][1]);
-               prod *= dGsq_(m,n);
-               increment += prod;
+         if (j == 0) {
+            #ifdef PSCF_OPENMP
+            #pragma omp parallel for
+            #endif
+            for (m = 0; m < nk; ++m) {
+               qqk_[m] = (qk2[m][0] * qk[m][0]) + (qk2[m][1] * qk[m][1]);
+            }
+         } else {
+            #ifdef PSCF_OPENMP
+            #pragma omp parallel for
+            #endif
+            for (m = 0; m < nk; ++m) {
+               qqk_[m] += weight * ((qk2[m][0] * qk[m][0]) 
+                                    + (qk2[m][1] * qk[m][1]));
             }
-            increment = (increment * kuhn() * kuhn() * dels)/normal;
-            dQ[n] = dQ[n] - increment;
          }
       }
 
-      // Normalize
-      for (i = 0; i < nParam; ++i) {
-         stress_[i] = stress_[i] - (dQ[i] * prefactor);
-      }
-
-   }
+      // Normalization, including Simpson factor ds/3 and factor 1/N^2
+      // for the two unscaled forward transforms
+      double scale = prefactor * kuhn() * kuhn() * ds_ / (3.0 * 6.0);
+      scale /= double(nx) * double(nx);
 
-   /*
-   * Compute dGsq_ array (derivatives of Gsq for all wavevectors)
-   */
-   template <int D>
-   void Block<D>::computedGsq()
-   {
-      IntVec<D> temp;
-      IntVec<D> vec;
-      IntVec<D> Partner;
-      MeshIterator<D> iter;
-      iter.setDimensions(kMeshDimensions_);
-
-      for (int n = 0; n < unitCell().nParameter() ; ++n) {
-         for (iter.begin(); !iter.atEnd(); ++iter) {
-            temp = iter.position();
-            vec = shiftToMinimum(temp, mesh().dimensions(), unitCell());
-            dGsq_(iter.rank(), n) = unitCell().dksq(vec, n);
-            for (int p = 0; p < D; ++p) {
-               if (temp [p] != 0) {
-                  Partner[p] = mesh().dimensions()[p] - temp[p];
-               } else {
-                  Partner[p] = 0;
-               }
-            }
-            if (Partner[D-1] > kMeshDimensions_[D-1]) {
-               dGsq_(iter.rank(), n) *= 2;
-            }
+      // Contract with d|k|^2/d(parameter) for each unit cell parameter
+      stress_.clear();
+      double sum;
+      for (int n = 0; n < nParam ; ++n) {
+         RField<D> const & dKSq = wavelist().dKSq(n);
+         sum = 0.0;
+         #ifdef PSCF_OPENMP
+         #pragma omp parallel for reduction(+:sum)
+         #endif
+         for (m = 0; m < nk; ++m) {
+            sum += qqk_[m] * dKSq[m];
          }
+         stress_.append(sum * scale);
       }
+
    }
 
    /*
@@ -412,6 +800,11 @@ namespace Rpc {
    template <int D>
    void Block<D>::step(RField<D> const & q, RField<D>& qNew)
    {
+      if (useMirror_) {
+         stepMirror(q, qNew);
+         return;
+      }
+
       // Prereconditions on mesh and fft
       int nx = mesh().size();
       UTIL_CHECK(nx > 0);
@@ -420,12 +813,17 @@ namespace Rpc {
 
       // Internal preconditions
       UTIL_CHECK(isAllocated_);
-      int nk = qk_.capacity();
+      int nk = kSize_;
       UTIL_CHECK(nk > 0);
-      UTIL_CHECK(qr_.capacity() == nx);
-      UTIL_CHECK(expW_.capacity() == nx);
-      UTIL_CHECK(expKsq_.capacity() == nk);
-      UTIL_CHECK(hasExpKsq_);
+      UTIL_CHECK(qrPair_.capacity() == 2*nx);
+      UTIL_CHECK(qkPair_.capacity() == 2*nk);
+      UTIL_CHECK(fftBatchedPair_.isSetup());
+      UTIL_CHECK(expWPtr_);
+      UTIL_CHECK(expKsqPtr_);
+      RField<D> const & expW = *expWPtr_;
+      RField<D> const & expW2 = *expW2Ptr_;
+      RField<D> const & expKsq = *expKsqPtr_;
+      RField<D> const & expKsq2 = *expKsq2Ptr_;
 
       // Preconditions on parameters
       UTIL_CHECK(q.isAllocated());
@@ -434,43 +832,154 @@ namespace Rpc {
       UTIL_CHECK(qNew.capacity() == nx);
 
       // Apply pseudo-spectral algorithm
-
-      // Full step for ds, half-step for ds/2
-      int i;
-      for (i = 0; i < nx; ++i) {
-         qr_[i] = q[i]*expW_[i];
-         qr2_[i] = q[i]*expW2_[i];
-      }
-      fft().forwardTransform(qr_, qk_);
-      fft().forwardTransform(qr2_, qk2_);
-      for (i = 0; i < nk; ++i) {
-         qk_[i][0] *= expKsq_[i];
-         qk_[i][1] *= expKsq_[i];
-         qk2_[i][0] *= expKsq2_[i];
-         qk2_[i][1] *= expKsq2_[i];
-      }
-      fft().inverseTransformUnsafe(qk_, qr_); // destroys qk_
+      //
+      // Forward transforms are unscaled: The factor 1/N is included in
+      // the expKsq and expKsq2 arrays. Multiplication by expW at the
+      // end of the full step and expW2 at the end of the second half
+      // step are deferred to the final Richardson extrapolation loop.
+
+      // Full step for ds and first half-step for ds/2, as one batch.
+      // Elements [0, nx) of qrPair_ hold the full step field, elements
+      // [nx, 2*nx) hold the half-step field (similarly for qkPair_).
+      VecOp::mulVV(qrPair_, q, expW, 0, 0, 0, nx);
+      VecOp::mulVV(qrPair_, q, expW2, nx, 0, 0, nx);
+      fftBatchedPair_.forwardTransformUnscaled(qrPair_, qkPair_);
+      VecOp::mulEqV(qkPair_, expKsq, 0, 0, nk);
+      VecOp::mulEqV(qkPair_, expKsq2, nk, 0, nk);
+      // Inverse transform of both fields (destroys qkPair_)
+      fftBatchedPair_.inverseTransformUnsafe(qkPair_, qrPair_);
+
+      // Second half-step for ds/2. Factor expW = expW2*expW2 
+      // combines the end of the first and start of the second half-step.
+      VecOp::mulVV(qr2_, qrPair_, expW, 0, nx, 0, nx);
+      fft().forwardTransformUnscaled(qr2_, qk2_);
+      VecOp::mulEqV(qk2_, expKsq2);
       fft().inverseTransformUnsafe(qk2_, qr2_); // destroys qk2_
-      for (i = 0; i < nx; ++i) {
-         qr_[i] = qr_[i]*expW_[i];
-         qr2_[i] = qr2_[i]*expW_[i];
-      }
 
-      // Finish second half-step for ds/2
-      fft().forwardTransform(qr2_, qk2_);
-      for (i = 0; i < nk; ++i) {
-         qk2_[i][0] *= expKsq2_[i];
-         qk2_[i][1] *= expKsq2_[i];
+      // Estimate local error from difference of ds and ds/2 results
+      if (estimateStepError_) {
+         double diffMax = 0.0;
+         double qMax = 0.0;
+         double full, half;
+         int i;
+         #ifdef PSCF_OPENMP
+         #pragma omp parallel for private(full, half) \
+                                  reduction(max:diffMax, qMax)
+         #endif
+         for (i = 0; i < nx; ++i) {
+            full = qrPair_[i]*expW[i];
+            half = qr2_[i]*expW2[i];
+            diffMax = std::max(diffMax, std::abs(half - full));
+            qMax = std::max(qMax, std::abs(half));
+         }
+         if (qMax > 0.0 && diffMax > stepError_*qMax) {
+            stepError_ = diffMax/qMax;
+         }
       }
-      fft().inverseTransformUnsafe(qk2_, qr2_); // destroys qk2_
-      for (i = 0; i < nx; ++i) {
-         qr2_[i] = qr2_[i]*expW2_[i];
+
+      if (stepAlgorithm_ == StepAlgorithm::RQM4) {
+
+         // Final expW multiplications and Richardson extrapolation
+         const double c1 = 4.0/3.0;
+         const double c2 = 1.0/3.0;
+         VecOp::addVVcVVc(qNew, qr2_, expW2, c1, qrPair_, expW, -c2);
+
+      } else {
+         UTIL_CHECK(stepAlgorithm_ == StepAlgorithm::RQM6);
+         UTIL_CHECK(expW4Ptr_);
+         UTIL_CHECK(expKsq4Ptr_);
+         UTIL_CHECK(qr4_.capacity() == nx);
+         RField<D> const & expW4 = *expW4Ptr_;
+         RField<D> const & expKsq4 = *expKsq4Ptr_;
+
+         // Four quarter-steps of length ds/4. Factor expW2 = expW4*expW4
+         // combines the end of one quarter-step and start of the next.
+         VecOp::mulVV(qr4_, q, expW4);
+         for (int j = 0; j < 4; ++j) {
+            if (j > 0) {
+               VecOp::mulEqV(qr4_, expW2);
+            }
+            fft().forwardTransformUnscaled(qr4_, qk2_);
+            VecOp::mulEqV(qk2_, expKsq4);
+            fft().inverseTransformUnsafe(qk2_, qr4_); // destroys qk2_
+         }
+
+         // Final expW multiplications and Richardson extrapolation,
+         // q = (64 q(ds/4) - 20 q(ds/2) + q(ds))/45
+         const double c1 = 64.0/45.0;
+         const double c2 = 20.0/45.0;
+         const double c3 = 1.0/45.0;
+         VecOp::addVVcVVcVVc(qNew, qr4_, expW4, c1, qr2_, expW2, -c2,
+                             qrPair_, expW, c3);
+
       }
+   }
 
-      // Richardson extrapolation
-      for (i = 0; i < nx; ++i) {
-         qNew[i] = (4.0*qr2_[i] - qr_[i])/3.0;
+   /*
+   * Propagate a mirror-symmetric solution by one RQM4 step.
+   *
+   * Identical to the RQM4 branch of step(), except that all operations
+   * act on the reduced grid, and each pair of forward and inverse FFTs
+   * is replaced by a pair of unscaled cosine transforms.
+   */
+   template <int D>
+   void Block<D>::stepMirror(RField<D> const & q, RField<D>& qNew)
+   {
+      // Preconditions
+      UTIL_CHECK(useMirror_);
+      UTIL_CHECK(fftMirrorPtr_);
+      UTIL_CHECK(stepAlgorithm_ == StepAlgorithm::RQM4);
+      FFTMirror<D> const & fftMirror = *fftMirrorPtr_;
+      int nx = mesh().size();
+      int nm = fftMirror.reducedSize();
+      UTIL_CHECK(q.capacity() == nx);
+      UTIL_CHECK(qNew.capacity() == nx);
+      UTIL_CHECK(qMirror_.capacity() == nm);
+
+      // Copy input slice to the reduced grid
+      fftMirror.gather(q, qMirrorIn_);
+
+      // Full step for ds
+      VecOp::mulVV(qMirror_, qMirrorIn_, expWMirror_);
+      fftMirror.transform(qMirror_, qkMirror_);
+      VecOp::mulEqV(qkMirror_, expKsqMirror_);
+      fftMirror.transform(qkMirror_, qMirror_);
+
+      // Two half steps for ds/2
+      VecOp::mulVV(qMirror2_, qMirrorIn_, expW2Mirror_);
+      fftMirror.transform(qMirror2_, qkMirror_);
+      VecOp::mulEqV(qkMirror_, expKsq2Mirror_);
+      fftMirror.transform(qkMirror_, qMirror2_);
+      VecOp::mulEqV(qMirror2_, expWMirror_);
+      fftMirror.transform(qMirror2_, qkMirror_);
+      VecOp::mulEqV(qkMirror_, expKsq2Mirror_);
+      fftMirror.transform(qkMirror_, qMirror2_);
+
+      // Estimate local error from difference of ds and ds/2 results.
+      // Maxima over the reduced grid equal maxima over the full grid.
+      if (estimateStepError_) {
+         double diffMax = 0.0;
+         double qMax = 0.0;
+         double full, half;
+         for (int i = 0; i < nm; ++i) {
+            full = qMirror_[i]*expWMirror_[i];
+            half = qMirror2_[i]*expW2Mirror_[i];
+            diffMax = std::max(diffMax, std::abs(half - full));
+            qMax = std::max(qMax, std::abs(half));
+         }
+         if (qMax > 0.0 && diffMax > stepError_*qMax) {
+            stepError_ = diffMax/qMax;
+         }
       }
+
+      // Final expW multiplications and Richardson extrapolation
+      const double c1 = 4.0/3.0;
+      const double c2 = 1.0/3.0;
+      VecOp::addVVcVVc(qMirrorIn_, qMirror2_, expW2Mirror_, c1, 
+                       qMirror_, expWMirror_, -c2);
+
+      // Expand result to the full grid
+      fftMirror.scatter(qMirrorIn_, qNew);
    }
 
 }
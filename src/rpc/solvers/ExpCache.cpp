@@ -0,0 +1,19 @@
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "ExpCache.tpp"
+
+namespace Pscf {
+namespace Rpc
+{
+
+   template class ExpCache<1>;
+   template class ExpCache<2>;
+   template class ExpCache<3>;
+
+}
+}
@@ -0,0 +1,323 @@
+#ifndef RPC_EXP_CACHE_H
+#define RPC_EXP_CACHE_H
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "WaveList.h"                 // member
+#include "StepAlgorithm.h"            // member
+#include <prdc/cpu/RField.h>          // member
+#include <pscf/mesh/Mesh.h>           // member
+#include <util/containers/DArray.h>   // member
+
+namespace Pscf {
+namespace Rpc {
+
+   using namespace Util;
+   using namespace Pscf::Prdc;
+   using namespace Pscf::Prdc::Cpu;
+
+   /**
+   * Cache of exponential arrays used by the MDE step algorithm.
+   *
+   * The pseudo-spectral step algorithm used by Block<D>::step requires
+   * the r-grid arrays exp(-w ds/2) and exp(-w ds/4), which depend only
+   * on the monomer type and the contour step ds of a block, and the
+   * k-grid arrays exp(-k^2 b^2 ds/6) and exp(-k^2 b^2 ds/12), which
+   * depend only on the statistical segment length b and ds. An ExpCache
+   * stores one copy of each such pair of arrays for each distinct key,
+   * i.e., each distinct (monomerId, ds) pair for the expW arrays and
+   * each distinct (kuhn, ds) pair for the expKsq arrays. A single
+   * ExpCache is owned by a Mixture and shared by all matching blocks.
+   *
+   * Usage: Before each solution of the MDE, clearKeys() is called, and
+   * then expWId() and expKsqId() are called for every block to obtain
+   * indices for the entries it should use (adding entries as needed).
+   * The functions computeExpW() and computeExpKsq() then compute all
+   * arrays that are needed. Arrays exp(-w ds/2) are recomputed on every
+   * call of computeExpW, while arrays exp(-k^2 b^2 ds/6) are retained
+   * and only recomputed after clearUnitCellData() is called or after
+   * a change in the key associated with an entry.
+   *
+   * If the RQM6 step algorithm is used, each entry also stores arrays
+   * exp(-w ds/8) and exp(-k^2 b^2 ds/24) that are needed for substeps
+   * of length ds/4 (see StepAlgorithm).
+   *
+   * Like the arrays computed by Block<D>::setupSolver, the expKsq
+   * arrays include a factor of 1/N, where N is the number of r-grid
+   * points, that normalizes the unscaled forward FFTs used by the
+   * step algorithm.
+   *
+   * \ingroup Rpc_Solver_Module
+   */
+   template <int D>
+   class ExpCache
+   {
+   public:
+
+      /**
+      * Constructor.
+      */
+      ExpCache();
+
+      /**
+      * Destructor
+      */
+      ~ExpCache();
+
+      /**
+      * Allocate memory and set associations with a Mesh and WaveList.
+      *
+      * The capacity is the maximum number of distinct keys of each
+      * type, which is never greater than the total number of blocks.
+      * Memory for the arrays of each entry is allocated when the entry
+      * is first used.
+      *
+      * \param mesh  spatial discretization mesh (input)
+      * \param wavelist  properties of wavevectors (input)
+      * \param capacity  maximum number of entries of each type
+      * \param algorithm  contour step algorithm used by all blocks
+      */
+      void allocate(Mesh<D> const & mesh, WaveList<D>& wavelist,
+                    int capacity,
+                    StepAlgorithm::Enum algorithm = StepAlgorithm::RQM4);
+
+      /**
+      * Mark all expKsq arrays as outdated.
+      *
+      * This function should be called once after every change in unit
+      * cell parameters.
+      */
+      void clearUnitCellData();
+
+      /**
+      * Remove all keys, retaining allocated memory.
+      *
+      * Stored expKsq arrays remain valid for reuse if the same key is
+      * assigned to the same entry by a subsequent call to expKsqId().
+      */
+      void clearKeys();
+
+      /**
+      * Get the index of the expW entry for a (monomerId, ds) key.
+      *
+      * Adds an entry if no entry with this key exists.
+      *
+      * \param monomerId  monomer type index
+      * \param ds  contour length step size
+      */
+      int expWId(int monomerId, double ds);
+
+      /**
+      * Get the index of the expKsq entry for a (kuhn, ds) key.
+      *
+      * Adds an entry if no entry with this key exists.
+      *
+      * \param kuhn  monomer statistical segment length
+      * \param ds  contour length step size
+      */
+      int expKsqId(double kuhn, double ds);
+
+      /**
+      * Compute all expW and expW2 arrays.
+      *
+      * \param wFields  array of chemical potential fields, by monomer id
+      */
+      void computeExpW(DArray< RField<D> > const & wFields);
+
+      /**
+      * Compute all expKsq and expKsq2 arrays that are outdated.
+      */
+      void computeExpKsq();
+
+      /**
+      * Get array exp(-w ds/2) for one entry.
+      *
+      * \param id  index of entry, as returned by expWId
+      */
+      RField<D> const & expW(int id) const;
+
+      /**
+      * Get array exp(-w ds/4) for one entry.
+      *
+      * \param id  index of entry, as returned by expWId
+      */
+      RField<D> const & expW2(int id) const;
+
+      /**
+      * Get array exp(-k^2 b^2 ds/6)/N for one entry.
+      *
+      * \param id  index of entry, as returned by expKsqId
+      */
+      RField<D> const & expKsq(int id) const;
+
+      /**
+      * Get array exp(-k^2 b^2 ds/12)/N for one entry.
+      *
+      * \param id  index of entry, as returned by expKsqId
+      */
+      RField<D> const & expKsq2(int id) const;
+
+      /**
+      * Get array exp(-w ds/8) for one entry (RQM6 algorithm only).
+      *
+      * \param id  index of entry, as returned by expWId
+      */
+      RField<D> const & expW4(int id) const;
+
+      /**
+      * Get array exp(-k^2 b^2 ds/24)/N for one entry (RQM6 only).
+      *
+      * \param id  index of entry, as returned by expKsqId
+      */
+      RField<D> const & expKsq4(int id) const;
+
+      /**
+      * Get the contour step algorithm.
+      */
+      StepAlgorithm::Enum stepAlgorithm() const
+      {  return algorithm_; }
+
+      /**
+      * Get the number of distinct (monomerId, ds) keys.
+      */
+      int nExpW() const
+      {  return nExpW_; }
+
+      /**
+      * Get the number of distinct (kuhn, ds) keys.
+      */
+      int nExpKsq() const
+      {  return nExpKsq_; }
+
+      /**
+      * Has memory been allocated?
+      */
+      bool isAllocated() const
+      {  return isAllocated_; }
+
+   private:
+
+      /// Arrays exp(-w ds/2), indexed by expW entry.
+      DArray< RField<D> > expW_;
+
+      /// Arrays exp(-w ds/4), indexed by expW entry.
+      DArray< RField<D> > expW2_;
+
+      /// Arrays exp(-k^2 b^2 ds/6)/N, indexed by expKsq entry.
+      DArray< RField<D> > expKsq_;
+
+      /// Arrays exp(-k^2 b^2 ds/12)/N, indexed by expKsq entry.
+      DArray< RField<D> > expKsq2_;
+
+      /// Arrays exp(-w ds/8), indexed by expW entry (RQM6 only).
+      DArray< RField<D> > expW4_;
+
+      /// Arrays exp(-k^2 b^2 ds/24)/N, by expKsq entry (RQM6 only).
+      DArray< RField<D> > expKsq4_;
+
+      /// Monomer type index keys of expW entries.
+      DArray<int> wMonomerIds_;
+
+      /// Contour step keys of expW entries.
+      DArray<double> wDs_;
+
+      /// Statistical segment length keys of expKsq entries.
+      DArray<double> kKuhn_;
+
+      /// Contour step keys of expKsq entries.
+      DArray<double> kDs_;
+
+      /// Are the arrays of each expKsq entry up to date?
+      DArray<bool> hasExpKsq_;
+
+      /// Number of expW entries with current keys.
+      int nExpW_;
+
+      /// Number of expKsq entries with current keys.
+      int nExpKsq_;
+
+      /// Maximum number of entries of each type.
+      int capacity_;
+
+      /// Contour step algorithm.
+      StepAlgorithm::Enum algorithm_;
+
+      /// Pointer to associated Mesh<D> object.
+      Mesh<D> const * meshPtr_;
+
+      /// Pointer to associated WaveList<D> object.
+      WaveList<D>* waveListPtr_;
+
+      /// Has memory been allocated?
+      bool isAllocated_;
+
+      /// Access associated Mesh<D> by reference.
+      Mesh<D> const & mesh() const
+      {  return *meshPtr_; }
+
+   };
+
+   // Get array exp(-w ds/2) for one entry.
+   template <int D>
+   inline RField<D> const & ExpCache<D>::expW(int id) const
+   {
+      UTIL_ASSERT(id >= 0 && id < nExpW_);
+      return expW_[id];
+   }
+
+   // Get array exp(-w ds/4) for one entry.
+   template <int D>
+   inline RField<D> const & ExpCache<D>::expW2(int id) const
+   {
+      UTIL_ASSERT(id >= 0 && id < nExpW_);
+      return expW2_[id];
+   }
+
+   // Get array exp(-k^2 b^2 ds/6)/N for one entry.
+   template <int D>
+   inline RField<D> const & ExpCache<D>::expKsq(int id) const
+   {
+      UTIL_ASSERT(id >= 0 && id < nExpKsq_);
+      return expKsq_[id];
+   }
+
+   // Get array exp(-k^2 b^2 ds/12)/N for one entry.
+   template <int D>
+   inline RField<D> const & ExpCache<D>::expKsq2(int id) const
+   {
+      UTIL_ASSERT(id >= 0 && id < nExpKsq_);
+      return expKsq2_[id];
+   }
+
+   // Get array exp(-w ds/8) for one entry.
+   template <int D>
+   inline RField<D> const & ExpCache<D>::expW4(int id) const
+   {
+      UTIL_ASSERT(id >= 0 && id < nExpW_);
+      UTIL_ASSERT(algorithm_ == StepAlgorithm::RQM6);
+      return expW4_[id];
+   }
+
+   // Get array exp(-k^2 b^2 ds/24)/N for one entry.
+   template <int D>
+   inline RField<D> const & ExpCache<D>::expKsq4(int id) const
+   {
+      UTIL_ASSERT(id >= 0 && id < nExpKsq_);
+      UTIL_ASSERT(algorithm_ == StepAlgorithm::RQM6);
+      return expKsq4_[id];
+   }
+
+   #ifndef RPC_EXP_CACHE_TPP
+   // Suppress implicit instantiation
+   extern template class ExpCache<1>;
+   extern template class ExpCache<2>;
+   extern template class ExpCache<3>;
+   #endif
+
+}
+}
+#endif
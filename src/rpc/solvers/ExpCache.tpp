@@ -0,0 +1,244 @@
+#ifndef RPC_EXP_CACHE_TPP
+#define RPC_EXP_CACHE_TPP
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "ExpCache.h"
+#include <prdc/cpu/VecOp.h>
+
+#include <cmath>
+
+namespace Pscf {
+namespace Rpc
+{
+
+   template <int D>
+   ExpCache<D>::ExpCache()
+    : nExpW_(0),
+      nExpKsq_(0),
+      capacity_(0),
+      algorithm_(StepAlgorithm::RQM4),
+      meshPtr_(nullptr),
+      waveListPtr_(nullptr),
+      isAllocated_(false)
+   {}
+
+   template <int D>
+   ExpCache<D>::~ExpCache()
+   {}
+
+   /*
+   * Allocate key arrays and set associations.
+   */
+   template <int D>
+   void ExpCache<D>::allocate(Mesh<D> const & mesh,
+                              WaveList<D>& wavelist,
+                              int capacity,
+                              StepAlgorithm::Enum algorithm)
+   {
+      UTIL_CHECK(!isAllocated_);
+      UTIL_CHECK(mesh.size() > 0);
+      UTIL_CHECK(wavelist.isAllocated());
+      UTIL_CHECK(capacity > 0);
+
+      meshPtr_ = &mesh;
+      waveListPtr_ = &wavelist;
+      capacity_ = capacity;
+      algorithm_ = algorithm;
+
+      expW_.allocate(capacity_);
+      expW2_.allocate(capacity_);
+      expKsq_.allocate(capacity_);
+      expKsq2_.allocate(capacity_);
+      if (algorithm_ == StepAlgorithm::RQM6) {
+         expW4_.allocate(capacity_);
+         expKsq4_.allocate(capacity_);
+      }
+      wMonomerIds_.allocate(capacity_);
+      wDs_.allocate(capacity_);
+      kKuhn_.allocate(capacity_);
+      kDs_.allocate(capacity_);
+      hasExpKsq_.allocate(capacity_);
+      for (int i = 0; i < capacity_; ++i) {
+         wMonomerIds_[i] = -1;
+         wDs_[i] = 0.0;
+         kKuhn_[i] = 0.0;
+         kDs_[i] = 0.0;
+         hasExpKsq_[i] = false;
+      }
+      nExpW_ = 0;
+      nExpKsq_ = 0;
+
+      isAllocated_ = true;
+   }
+
+   /*
+   * Mark all expKsq arrays as outdated.
+   */
+   template <int D>
+   void ExpCache<D>::clearUnitCellData()
+   {
+      for (int i = 0; i < capacity_; ++i) {
+         hasExpKsq_[i] = false;
+      }
+   }
+
+   /*
+   * Remove all keys (stored values of keys are retained for reuse).
+   */
+   template <int D>
+   void ExpCache<D>::clearKeys()
+   {
+      nExpW_ = 0;
+      nExpKsq_ = 0;
+   }
+
+   /*
+   * Find or add the expW entry for a (monomerId, ds) key.
+   */
+   template <int D>
+   int ExpCache<D>::expWId(int monomerId, double ds)
+   {
+      UTIL_CHECK(isAllocated_);
+      UTIL_CHECK(monomerId >= 0);
+      UTIL_CHECK(ds > 0.0);
+
+      // Search existing entries
+      for (int i = 0; i < nExpW_; ++i) {
+         if (wMonomerIds_[i] == monomerId && wDs_[i] == ds) {
+            return i;
+         }
+      }
+
+      // Add a new entry
+      UTIL_CHECK(nExpW_ < capacity_);
+      int id = nExpW_;
+      wMonomerIds_[id] = monomerId;
+      wDs_[id] = ds;
+      if (!expW_[id].isAllocated()) {
+         expW_[id].allocate(mesh().dimensions());
+         expW2_[id].allocate(mesh().dimensions());
+         if (algorithm_ == StepAlgorithm::RQM6) {
+            expW4_[id].allocate(mesh().dimensions());
+         }
+      }
+      ++nExpW_;
+      return id;
+   }
+
+   /*
+   * Find or add the expKsq entry for a (kuhn, ds) key.
+   */
+   template <int D>
+   int ExpCache<D>::expKsqId(double kuhn, double ds)
+   {
+      UTIL_CHECK(isAllocated_);
+      UTIL_CHECK(ds > 0.0);
+
+      // Search existing entries
+      for (int i = 0; i < nExpKsq_; ++i) {
+         if (kKuhn_[i] == kuhn && kDs_[i] == ds) {
+            return i;
+         }
+      }
+
+      // Add a new entry. Stored arrays remain valid if this entry
+      // had the same key before the last call to clearKeys().
+      UTIL_CHECK(nExpKsq_ < capacity_);
+      int id = nExpKsq_;
+      if (kKuhn_[id] != kuhn || kDs_[id] != ds) {
+         kKuhn_[id] = kuhn;
+         kDs_[id] = ds;
+         hasExpKsq_[id] = false;
+      }
+      if (!expKsq_[id].isAllocated()) {
+         IntVec<D> const & kMeshDimensions
+                                    = waveListPtr_->kMeshDimensions();
+         expKsq_[id].allocate(kMeshDimensions);
+         expKsq2_[id].allocate(kMeshDimensions);
+         if (algorithm_ == StepAlgorithm::RQM6) {
+            expKsq4_[id].allocate(kMeshDimensions);
+         }
+         hasExpKsq_[id] = false;
+      }
+      ++nExpKsq_;
+      return id;
+   }
+
+   /*
+   * Compute arrays exp(-w ds/2) and exp(-w ds/4) for all entries.
+   */
+   template <int D>
+   void ExpCache<D>::computeExpW(DArray< RField<D> > const & wFields)
+   {
+      UTIL_CHECK(isAllocated_);
+      int nx = mesh().size();
+      int monomerId;
+      double ds;
+      for (int j = 0; j < nExpW_; ++j) {
+         monomerId = wMonomerIds_[j];
+         UTIL_CHECK(monomerId < wFields.capacity());
+         RField<D> const & w = wFields[monomerId];
+         UTIL_CHECK(w.capacity() == nx);
+         RField<D>& expW = expW_[j];
+         RField<D>& expW2 = expW2_[j];
+         ds = wDs_[j];
+         VecOp::expVc(expW, w, -0.5*ds);
+         VecOp::expVc(expW2, w, -0.5*0.5*ds);
+         if (algorithm_ == StepAlgorithm::RQM6) {
+            VecOp::expVc(expW4_[j], w, -0.5*0.25*ds);
+         }
+      }
+   }
+
+   /*
+   * Compute arrays exp(-k^2 b^2 ds/6)/N and exp(-k^2 b^2 ds/12)/N.
+   */
+   template <int D>
+   void ExpCache<D>::computeExpKsq()
+   {
+      UTIL_CHECK(isAllocated_);
+
+      // Compute kSq in the wavelist, if necessary
+      if (nExpKsq_ > 0 && !waveListPtr_->hasKSq()) {
+         waveListPtr_->computeKSq();
+      }
+
+      int nk = waveListPtr_->kSize();
+      double scale = 1.0/double(mesh().size());
+      double factor;
+      for (int j = 0; j < nExpKsq_; ++j) {
+         if (hasExpKsq_[j]) continue;
+         RField<D> const & kSq = waveListPtr_->kSq();
+         RField<D>& expKsq = expKsq_[j];
+         RField<D>& expKsq2 = expKsq2_[j];
+         UTIL_CHECK(expKsq.capacity() == nk);
+         factor = -1.0*kKuhn_[j]*kKuhn_[j]*kDs_[j]/6.0;
+         #ifdef PSCF_OPENMP
+         #pragma omp parallel for
+         #endif
+         for (int i = 0; i < nk; ++i) {
+            expKsq[i] = exp(kSq[i]*factor)*scale;
+            expKsq2[i] = exp(kSq[i]*factor*0.5)*scale;
+         }
+         if (algorithm_ == StepAlgorithm::RQM6) {
+            RField<D>& expKsq4 = expKsq4_[j];
+            #ifdef PSCF_OPENMP
+            #pragma omp parallel for
+            #endif
+            for (int i = 0; i < nk; ++i) {
+               expKsq4[i] = exp(kSq[i]*factor*0.25)*scale;
+            }
+         }
+         hasExpKsq_[j] = true;
+      }
+   }
+
+}
+}
+#endif
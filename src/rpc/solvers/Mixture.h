@@ -10,6 +10,11 @@
 
 #include "Polymer.h"
 #include "Solvent.h"
+#include "WaveList.h"
+#include "ExpCache.h"
+#include "StepAlgorithm.h"
+#include <prdc/cpu/FFTMirror.h>
+#include <prdc/crystal/MeshOrbits.h>
 #include <pscf/solvers/MixtureTmpl.h>
 #include <pscf/inter/Interaction.h>
 #include <pscf/chem/Monomer.h>
@@ -21,6 +26,7 @@
 namespace Pscf { 
    template <int D> class Mesh; 
    namespace Prdc {
+      template <int D> class SpaceGroup;
       namespace Cpu {
          template <int D> class FFT;
          template <int D> class RField;
@@ -81,8 +87,36 @@ namespace Rpc {
       * Read all parameters and initialize.
       *
       * This function reads in a complete description of the structure of
-      * all species and the composition of the mixture, as well as the
-      * target contour length step size ds.
+      * all species and the composition of the mixture, the target
+      * contour length step size ds, and optional boolean parameters
+      * useCheckpoints and useFloatQ (both false by default) that, if 
+      * true, cause all propagators to store only checkpoint slices or 
+      * to store slices in single precision, respectively. An optional
+      * boolean parameter parallelPropagators (false by default) enables
+      * concurrent solution of independent propagators within each 
+      * polymer (see PolymerTmpl::setParallelSolve), and an optional 
+      * boolean parameter parallelSpecies (false by default) enables
+      * concurrent solution of different species. An optional boolean
+      * parameter shareIdenticalPropagators (false by default) enables
+      * sharing of identical propagators within each polymer (see
+      * PolymerTmpl::setShareIdentical). An optional boolean parameter
+      * fuseConcentration (false by default) causes block concentrations
+      * to be computed during solution of the second propagator of each
+      * block (see Block::setFuseConcentration). An optional parameter
+      * stepAlgorithm, read immediately after ds, selects the algorithm
+      * used to take each contour step (RQM4 by default, see 
+      * StepAlgorithm). An optional array blockDs, with one element for
+      * each block of the mixture (ordered as in createBlockCRGrid), 
+      * overrides ds for blocks with positive values. An optional 
+      * positive parameter dsTolerance enables adaptive choice of the 
+      * contour step of each block (see adaptContourSteps).
+      * An optional boolean parameter useMirrorTransforms (false by 
+      * default) enables solution of the MDE on a reduced grid using
+      * real-to-real transforms when the w fields are mirror-symmetric
+      * (see setSymmetric and Block::setMirrorFFT). An optional boolean
+      * parameter useAsymmetricUnit (false by default) causes interior 
+      * propagator slices to be stored only within the asymmetric unit
+      * of the space group (see setSpaceGroup and Block::setMeshOrbits).
       *
       * \param in input parameter stream
       */
@@ -94,7 +128,9 @@ namespace Rpc {
       * The Mesh<D> object must have already been initialized, e.g., by 
       * reading its parameters from a file, so that the mesh dimensions 
       * are known on entry. The FFT<D> object must have been setup with
-      * meshDimensions equal to those of the mesh.
+      * meshDimensions equal to those of the mesh. This function also 
+      * allocates a WaveList<D> that is owned by this Mixture and shared
+      * by all blocks.
       *
       * \param mesh  associated Mesh<D> object (stores address).
       * \param fft  associated FFT<D> object (stores address).
@@ -106,9 +142,42 @@ namespace Rpc {
 
       /**
       * Allocate required internal memory for all solvers.
+      *
+      * This function also allocates an ExpCache<D> that is owned by this
+      * Mixture and that stores the exponential arrays used by the MDE
+      * step algorithm for all blocks.
       */
       void allocate();
 
+      /**
+      * Set the space group of symmetry-constrained calculations.
+      *
+      * This constructs the orbits of mesh nodes under the group, which
+      * are used to store propagator slices on the asymmetric unit if the
+      * parameter useAsymmetricUnit is true, and determines whether the
+      * group contains the mirror planes required by the parameter 
+      * useMirrorTransforms (see SpaceGroup::hasMirrorPlanes). If used, 
+      * it must be called after associate and before allocate. 
+      *
+      * \param group  space group of the structure
+      */
+      void setSpaceGroup(SpaceGroup<D> const & group);
+
+      /**
+      * Declare whether the w fields are invariant under the space group.
+      *
+      * If isSymmetric is true, subsequent calls to compute may assume 
+      * that every w field is invariant under the group passed to 
+      * setSpaceGroup. This is required if the parameter 
+      * useAsymmetricUnit is true, and enables reduced grid solution if
+      * the parameter useMirrorTransforms is true. This is false by 
+      * default, and is set by the parent System before each call to 
+      * compute. 
+      *
+      * \param isSymmetric  true iff all w fields are symmetric
+      */
+      void setSymmetric(bool isSymmetric);
+
       /**
       * Clear all data in solvers that depends on the unit cell parameters.
       * 
@@ -117,7 +186,8 @@ namespace Rpc {
       * It should be called once after every change in the unit cell and
       * before the next call to compute or computeStress. Such outdated
       * internal data is then recomputed just before it is needed for 
-      * solution of the MDE or calculation of the stress. 
+      * solution of the MDE or calculation of the stress. This includes
+      * data stored in the WaveList<D> shared by all blocks.
       */
       void clearUnitCellData();
 
@@ -136,8 +206,9 @@ namespace Rpc {
       /**
       * Compute partition functions and concentrations.
       *
-      * This function calls the compute function of every molecular
-      * species, and then adds the resulting block concentration fields
+      * This function solves the MDE for every polymer species, computes
+      * concentrations for every solvent species, and then adds the 
+      * resulting block concentration fields
       * for blocks of the same monomer type to compute a total monomer
       * concentration (or volume fraction) for each monomer type.
       * Upon return, values are set for volume fraction and chemical 
@@ -151,6 +222,13 @@ namespace Rpc {
       * The arrays wFields and cFields must each have capacity nMonomer(),
       * and contain fields that are indexed by monomer type index. 
       *
+      * The arrays exp(-w ds/2) and exp(-k^2 b^2 ds/6) used by the MDE
+      * step algorithm are computed once for each distinct (monomerId, 
+      * ds) and (kuhn, ds) pair, respectively, and shared by all blocks
+      * with matching values (see ExpCache). Arrays that depend on k^2 
+      * are retained between calls until the unit cell, the kuhn length
+      * or the contour step of a block changes.
+      *
       * The optional parameter phiTot is only relevant to problems such as 
       * thin films in which the material is excluded from part of the unit
       * cell by imposing an inhomogeneous constraint on the sum of monomer 
@@ -202,6 +280,26 @@ namespace Rpc {
       */
       void computeStress(double phiTot = 1.0);
 
+      /**
+      * Clear contour step error estimates of all blocks.
+      *
+      * After this, each block accumulates the maximum step error found
+      * in subsequent calls to compute (see Block::stepError).
+      */
+      void clearStepErrors();
+
+      /**
+      * Adjust the contour step size of each block (adaptive mode).
+      *
+      * Rescales ds for each block whose step error estimate, obtained
+      * since the last call to clearStepErrors, lies outside the range
+      * allowed by dsTolerance, then clears all error estimates. This
+      * requires dsTolerance > 0. The contour discretization is never
+      * changed by compute, so that it remains fixed during iteration:
+      * System::iterate calls this function once before each solve.
+      */
+      void adaptContourSteps();
+
       /**
       * Get derivative of free energy w/ respect to a unit cell parameter.
       *
@@ -224,6 +322,26 @@ namespace Rpc {
       */
       bool isCanonical();
 
+      /**
+      * Get the WaveList<D> shared by all blocks, by const reference.
+      */
+      WaveList<D> const & waveList() const;
+
+      /**
+      * Get the ExpCache<D> shared by all blocks, by const reference.
+      */
+      ExpCache<D> const & expCache() const;
+
+      /**
+      * Get the contour step algorithm used by all blocks.
+      */
+      StepAlgorithm::Enum stepAlgorithm() const;
+
+      /**
+      * Get the contour step error tolerance (<= 0 if not adaptive).
+      */
+      double dsTolerance() const;
+
       // Inherited public member functions with non-dependent names
       using MixtureTmpl< Polymer<D>, Solvent<D> >::nMonomer;
       using MixtureTmpl< Polymer<D>, Solvent<D> >::nPolymer;
@@ -239,15 +357,67 @@ namespace Rpc {
       using MixtureTmpl< Polymer<D>, Solvent<D> >::setClassName;
       using ParamComposite::read;
       using ParamComposite::readOptional;
+      using ParamComposite::readOptionalDArray;
 
    private:
 
       /// Array to store total stress
       FArray<double, 6> stress_;
 
+      /// Properties of wavevectors, shared by all blocks.
+      WaveList<D> waveList_;
+
+      /// Exponential arrays used by the MDE solver, shared by all blocks.
+      ExpCache<D> expCache_;
+
       /// Optimal contour length step size.
       double ds_;
 
+      /// Algorithm used for each contour step.
+      StepAlgorithm::Enum stepAlgorithm_;
+
+      /// Optional desired step size for each block (ignored if <= 0).
+      DArray<double> blockDs_;
+
+      /// Tolerance for contour step error (adaptive ds if positive).
+      double dsTolerance_;
+
+      /// Should propagators store only checkpoint slices?
+      bool useCheckpoints_;
+
+      /// Should propagators store interior slices in single precision?
+      bool useFloatQ_;
+
+      /// Should independent propagators be solved concurrently?
+      bool parallelPropagators_;
+
+      /// Should different species be solved concurrently?
+      bool parallelSpecies_;
+
+      /// Should identical propagators be solved only once?
+      bool shareIdenticalPropagators_;
+
+      /// Should block concentrations be computed during solution?
+      bool fuseConcentration_;
+
+      /// Should mirror-symmetric fields use real-to-real transforms?
+      bool useMirrorTransforms_;
+
+      /// Should propagators store slices on the asymmetric unit?
+      bool useAsymmetricUnit_;
+
+      /// Are the w fields passed to compute invariant under the group?
+      bool isSymmetric_;
+
+      /// Does the space group contain mirror planes normal to each axis?
+      bool hasMirrorPlanes_;
+
+      /// Real-to-real transform for mirror-symmetric fields.
+      FFTMirror<D> fftMirror_;
+
+      /// Orbits of mesh nodes under the space group.
+      MeshOrbits<D> meshOrbits_;
+
       /// Pointer to associated Mesh<D> object.
       Mesh<D> const * meshPtr_;
 
@@ -257,11 +427,18 @@ namespace Rpc {
       /// Has stress been computed for current w fields?
       bool hasStress_;
 
-      // Private function
+      // Private functions
       
       /// Return associated Mesh<D> by const reference.
       Mesh<D> const & mesh() const;
 
+      /**
+      * Compute shared exponential arrays and set up all block solvers.
+      *
+      * \param wFields array of chemical potential fields (input)
+      */
+      void setupSolvers(DArray< RField<D> > const & wFields);
+
    };
 
    // Inline member function
@@ -274,6 +451,26 @@ namespace Rpc {
       return stress_[n]; 
    }
 
+   // Get the WaveList<D> by const reference.
+   template <int D>
+   inline WaveList<D> const & Mixture<D>::waveList() const
+   {  return waveList_; }
+
+   // Get the ExpCache<D> by const reference.
+   template <int D>
+   inline ExpCache<D> const & Mixture<D>::expCache() const
+   {  return expCache_; }
+
+   // Get the contour step algorithm.
+   template <int D>
+   inline StepAlgorithm::Enum Mixture<D>::stepAlgorithm() const
+   {  return stepAlgorithm_; }
+
+   // Get the contour step error tolerance.
+   template <int D>
+   inline double Mixture<D>::dsTolerance() const
+   {  return dsTolerance_; }
+
    // Get Mesh<D> by constant reference (private).
    template <int D>
    inline Mesh<D> const & Mixture<D>::mesh() const
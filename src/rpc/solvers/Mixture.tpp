@@ -10,9 +10,11 @@
 
 #include "Mixture.h"
 #include <prdc/cpu/RField.h>
+#include <prdc/crystal/SpaceGroup.h>
 #include <pscf/mesh/Mesh.h>
 
 #include <cmath>
+#include <exception>
 
 namespace Pscf {
 namespace Rpc
@@ -23,7 +25,24 @@ namespace Rpc
    template <int D>
    Mixture<D>::Mixture()
     : stress_(),
+      waveList_(),
+      expCache_(),
       ds_(-1.0),
+      stepAlgorithm_(StepAlgorithm::RQM4),
+      blockDs_(),
+      dsTolerance_(-1.0),
+      useCheckpoints_(false),
+      useFloatQ_(false),
+      parallelPropagators_(false),
+      parallelSpecies_(false),
+      shareIdenticalPropagators_(false),
+      fuseConcentration_(false),
+      useMirrorTransforms_(false),
+      useAsymmetricUnit_(false),
+      isSymmetric_(false),
+      hasMirrorPlanes_(false),
+      fftMirror_(),
+      meshOrbits_(),
       meshPtr_(nullptr),
       nParam_(0),
       hasStress_(false)
@@ -38,10 +57,54 @@ namespace Rpc
    {
       MixtureTmpl< Polymer<D>, Solvent<D> >::readParameters(in);
       read(in, "ds", ds_);
+      readOptional(in, "stepAlgorithm", stepAlgorithm_);
+      if (nBlock() > 0) {
+         // Elements that are absent or not positive use ds_
+         blockDs_.allocate(nBlock());
+         for (int k = 0; k < nBlock(); ++k) {
+            blockDs_[k] = 0.0;
+         }
+         readOptionalDArray(in, "blockDs", blockDs_, nBlock());
+      }
+      readOptional(in, "dsTolerance", dsTolerance_);
+      readOptional(in, "useCheckpoints", useCheckpoints_);
+      readOptional(in, "useFloatQ", useFloatQ_);
+      readOptional(in, "parallelPropagators", parallelPropagators_);
+      readOptional(in, "parallelSpecies", parallelSpecies_);
+      readOptional(in, "shareIdenticalPropagators", 
+                   shareIdenticalPropagators_);
+      readOptional(in, "fuseConcentration", fuseConcentration_);
+      readOptional(in, "useMirrorTransforms", useMirrorTransforms_);
+      readOptional(in, "useAsymmetricUnit", useAsymmetricUnit_);
 
       UTIL_CHECK(nMonomer() > 0);
       UTIL_CHECK(nPolymer()+ nSolvent() > 0);
       UTIL_CHECK(ds_ > 0);
+      if (useCheckpoints_ && useFloatQ_) {
+         UTIL_THROW("useCheckpoints and useFloatQ may not both be true");
+      }
+      if (useCheckpoints_ && shareIdenticalPropagators_) {
+         UTIL_THROW(
+            "useCheckpoints and shareIdenticalPropagators may not both be true");
+      }
+      if (fuseConcentration_ && shareIdenticalPropagators_) {
+         UTIL_THROW(
+            "fuseConcentration and shareIdenticalPropagators may not both be true");
+      }
+      if (useMirrorTransforms_ && stepAlgorithm_ != StepAlgorithm::RQM4) {
+         UTIL_THROW("useMirrorTransforms requires stepAlgorithm RQM4");
+      }
+      if (useAsymmetricUnit_ && (useCheckpoints_ || useFloatQ_)) {
+         UTIL_THROW(
+            "useAsymmetricUnit may not be combined with useCheckpoints or useFloatQ");
+      }
+
+      // Enable concurrent propagator solution and sharing of 
+      // identical propagators, if requested
+      for (int i = 0; i < nPolymer(); ++i) {
+         polymer(i).setParallelSolve(parallelPropagators_);
+         polymer(i).setShareIdentical(shareIdenticalPropagators_);
+      }
    }
 
    /*
@@ -63,13 +126,18 @@ namespace Rpc
       meshPtr_ = &mesh;
       nParam_ = cell.nParameter();
 
+      // Allocate the wavelist shared by all blocks
+      if (!waveList_.isAllocated()) {
+         waveList_.allocate(mesh, cell);
+      }
+
       // Create associations for all polymer blocks
       if (nPolymer() > 0) {
          int i, j;
          for (i = 0; i < nPolymer(); ++i) {
             polymer(i).setNParams(nParam_);
             for (j = 0; j < polymer(i).nBlock(); ++j) {
-               polymer(i).block(j).associate(mesh, fft, cell);
+               polymer(i).block(j).associate(mesh, fft, cell, waveList_);
             }
          }
       }
@@ -96,12 +164,46 @@ namespace Rpc
       UTIL_CHECK(meshPtr_->size() > 0);
       UTIL_CHECK(ds_ > 0);
 
+      if (useAsymmetricUnit_ && !meshOrbits_.isInitialized()) {
+         UTIL_THROW("useAsymmetricUnit requires a space group");
+      }
+
       // Allocate memory for all Block objects
       if (nPolymer() > 0) {
          int i, j;
+         int k = 0; // block index within the whole mixture
+         double ds;
+         DArray<int> secondIds;
          for (i = 0; i < nPolymer(); ++i) {
+
+            // In fused mode, identify the propagator of each block that
+            // is solved second (i.e., later in the computation plan)
+            if (fuseConcentration_) {
+               secondIds.allocate(polymer(i).nBlock());
+               for (j = 0; j < polymer(i).nPropagator(); ++j) {
+                  Pair<int> const & propId = polymer(i).propagatorId(j);
+                  secondIds[propId[0]] = propId[1];
+               }
+               for (j = 0; j < polymer(i).nBlock(); ++j) {
+                  polymer(i).block(j).setFuseConcentration(true, 
+                                                           secondIds[j]);
+               }
+               secondIds.deallocate();
+            }
+
             for (j = 0; j < polymer(i).nBlock(); ++j) {
-               polymer(i).block(j).allocate(ds_);
+               Block<D>& block = polymer(i).block(j);
+               ds = ds_;
+               if (blockDs_.isAllocated() && blockDs_[k] > 0.0) {
+                  ds = blockDs_[k];
+               }
+               block.setStepAlgorithm(stepAlgorithm_);
+               block.setEstimateStepError(dsTolerance_ > 0.0);
+               if (useAsymmetricUnit_) {
+                  block.setMeshOrbits(&meshOrbits_);
+               }
+               block.allocate(ds, useCheckpoints_, useFloatQ_);
+               ++k;
             }
          }
       }
@@ -113,8 +215,42 @@ namespace Rpc
          }
       }
 
+      // Allocate cache of exponential arrays shared by all blocks
+      if (nBlock() > 0 && !expCache_.isAllocated()) {
+         expCache_.allocate(mesh(), waveList_, nBlock(), 
+                            stepAlgorithm_);
+      }
+
+      // Setup real-to-real transform for mirror-symmetric fields
+      if (useMirrorTransforms_ && !fftMirror_.isSetup()) {
+         if (!FFTMirror<D>::isValidMesh(mesh().dimensions())) {
+            UTIL_THROW("useMirrorTransforms requires even mesh dimensions");
+         }
+         fftMirror_.setup(mesh().dimensions());
+      }
+
    }
 
+   /*
+   * Set the space group, and construct orbits of mesh nodes.
+   */
+   template <int D>
+   void Mixture<D>::setSpaceGroup(SpaceGroup<D> const & group)
+   {
+      UTIL_CHECK(meshPtr_);
+      hasMirrorPlanes_ = group.hasMirrorPlanes();
+      if (useAsymmetricUnit_) {
+         meshOrbits_.makeOrbits(mesh(), group);
+      }
+   }
+
+   /*
+   * Declare whether the w fields are invariant under the space group.
+   */
+   template <int D>
+   void Mixture<D>::setSymmetric(bool isSymmetric)
+   {  isSymmetric_ = isSymmetric; }
+
    /*
    * Clear all data that depends on the unit cell parameters.
    */
@@ -126,6 +262,12 @@ namespace Rpc
             polymer(i).clearUnitCellData();
          }
       }
+      if (waveList_.isAllocated()) {
+         waveList_.clearUnitCellData();
+      }
+      if (expCache_.isAllocated()) {
+         expCache_.clearUnitCellData();
+      }
       hasStress_ = false;
    }
 
@@ -164,6 +306,9 @@ namespace Rpc
       UTIL_CHECK(nPolymer() + nSolvent() > 0);
       UTIL_CHECK(wFields.capacity() == nMonomer());
       UTIL_CHECK(cFields.capacity() == nMonomer());
+      if (useAsymmetricUnit_ && !isSymmetric_) {
+         UTIL_THROW("useAsymmetricUnit requires symmetric w fields");
+      }
 
       int meshSize = mesh().size();
       int nm = nMonomer();
@@ -178,15 +323,61 @@ namespace Rpc
          }
       }
 
-      // Process polymer species
-      // Solve MDE for all polymers
-      for (i = 0; i < nPolymer(); ++i) {
-         polymer(i).compute(wFields, phiTot);
+      // Solve MDE for all polymers and compute all solvent fields.
+      // If parallelSpecies_ is true, different species are solved
+      // concurrently. Each species only modifies data owned by its own
+      // Block, Propagator and Solvent objects (including FFT work 
+      // arrays). The shared FFT<D> object is only used through const
+      // functions that execute preexisting plans, and arrays in the 
+      // shared ExpCache<D> are computed beforehand and only read.
+      int np = nPolymer();
+      int ns = nSolvent();
+      int nSpecies = np + ns;
+      if (np > 0 && !waveList_.hasKSq()) {
+         // Compute wavelist data before blocks may access it concurrently
+         waveList_.computeKSq();
+      }
+      if (np > 0) {
+         setupSolvers(wFields);
       }
-
-      // Accumulate block contributions to monomer concentrations
       int monomerId;
-      for (i = 0; i < nPolymer(); ++i) {
+      for (i = 0; i < ns; ++i) {
+         monomerId = solvent(i).monomerId();
+         UTIL_CHECK(monomerId >= 0);
+         UTIL_CHECK(monomerId < nm);
+      }
+      // An exception may not propagate out of a parallel region, so 
+      // the first one thrown is captured and rethrown after the loop.
+      std::exception_ptr error = nullptr;
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for schedule(dynamic,1) if (parallelSpecies_)
+      #endif
+      for (int s = 0; s < nSpecies; ++s) {
+         try {
+            if (s < np) {
+               polymer(s).solve(phiTot);
+            } else {
+               Solvent<D>& solv = solvent(s - np);
+               solv.compute(wFields[solv.monomerId()], phiTot);
+            }
+         } catch (...) {
+            #ifdef PSCF_OPENMP
+            #pragma omp critical (rpc_mixture_species)
+            #endif
+            {
+               if (!error) error = std::current_exception();
+            }
+         }
+      }
+      if (error) {
+         std::rethrow_exception(error);
+      }
+
+      // Accumulate block and solvent contributions to monomer 
+      // concentrations. This is done after all species are solved, 
+      // by loops in which each thread modifies a distinct set of 
+      // grid points, so that no two threads update the same element.
+      for (i = 0; i < np; ++i) {
          for (j = 0; j < polymer(i).nBlock(); ++j) {
             monomerId = polymer(i).block(j).monomerId();
             UTIL_CHECK(monomerId >= 0);
@@ -194,35 +385,117 @@ namespace Rpc
             RField<D>& monomerField = cFields[monomerId];
             RField<D> const & blockField = polymer(i).block(j).cField();
             UTIL_CHECK(blockField.capacity() == meshSize);
+            #ifdef PSCF_OPENMP
+            #pragma omp parallel for
+            #endif
             for (k = 0; k < meshSize; ++k) {
                monomerField[k] += blockField[k];
             }
          }
       }
-
-      // Process solvent species
-      // For each solvent, call compute and accumulate cFields
-      for (i = 0; i < nSolvent(); ++i) {
+      for (i = 0; i < ns; ++i) {
          monomerId = solvent(i).monomerId();
-         UTIL_CHECK(monomerId >= 0);
-         UTIL_CHECK(monomerId < nm);
-
-         // Compute solvent concentration
-         solvent(i).compute(wFields[monomerId], phiTot);
-
-         // Add solvent contribution to relevant monomer concentration
          RField<D>& monomerField = cFields[monomerId];
          RField<D> const & solventField = solvent(i).cField();
          UTIL_CHECK(solventField.capacity() == meshSize);
+         #ifdef PSCF_OPENMP
+         #pragma omp parallel for
+         #endif
          for (k = 0; k < meshSize; ++k) {
             monomerField[k] += solventField[k];
          }
-
       }
 
       hasStress_ = false;
    }
 
+   /*
+   * Clear contour step error estimates of all blocks.
+   */
+   template <int D>
+   void Mixture<D>::clearStepErrors()
+   {
+      for (int i = 0; i < nPolymer(); ++i) {
+         for (int j = 0; j < polymer(i).nBlock(); ++j) {
+            polymer(i).block(j).clearStepError();
+         }
+      }
+   }
+
+   /*
+   * Adjust the contour step of each block to the error tolerance.
+   *
+   * The error estimate e of each block, the maximum obtained since the
+   * last call to clearStepErrors, scales as ds^3. The step size is reduced whenever
+   * e > dsTolerance_, and is increased (by at most a factor of 2) only 
+   * if e < dsTolerance_/8, so that ns does not oscillate. Blocks with 
+   * no error estimate (e.g., blocks whose propagators were not solved 
+   * because they were identical to others) are left unchanged.
+   */
+   template <int D>
+   void Mixture<D>::adaptContourSteps()
+   {
+      UTIL_CHECK(dsTolerance_ > 0.0);
+      const double safety = 0.9;
+      double error, factor;
+      for (int i = 0; i < nPolymer(); ++i) {
+         for (int j = 0; j < polymer(i).nBlock(); ++j) {
+            Block<D>& block = polymer(i).block(j);
+            error = block.stepError();
+            block.clearStepError();
+            if (error <= 0.0) continue;
+            if (error > dsTolerance_ || 8.0*error < dsTolerance_) {
+               factor = safety*std::cbrt(dsTolerance_/error);
+               if (factor > 2.0) factor = 2.0;
+               block.setDs(factor*block.ds());
+            }
+         }
+      }
+   }
+
+   /*
+   * Compute shared exponential arrays and set up solvers for all blocks.
+   */
+   template <int D>
+   void Mixture<D>::setupSolvers(DArray< RField<D> > const & wFields)
+   {
+      UTIL_CHECK(expCache_.isAllocated());
+      int i, j;
+
+      // Register the (monomerId, ds) and (kuhn, ds) keys of all blocks
+      expCache_.clearKeys();
+      for (i = 0; i < nPolymer(); ++i) {
+         for (j = 0; j < polymer(i).nBlock(); ++j) {
+            Block<D> const & block = polymer(i).block(j);
+            expCache_.expWId(block.monomerId(), block.ds());
+            expCache_.expKsqId(block.kuhn(), block.ds());
+         }
+      }
+
+      // Compute each distinct array once
+      expCache_.computeExpW(wFields);
+      expCache_.computeExpKsq();
+
+      // Use reduced grid transforms only for mirror-symmetric fields
+      FFTMirror<D> const * fftMirrorPtr = nullptr;
+      if (useMirrorTransforms_ && isSymmetric_ && hasMirrorPlanes_) {
+         UTIL_CHECK(fftMirror_.isSetup());
+         fftMirrorPtr = &fftMirror_;
+      }
+
+      // Point each block to the arrays for its keys
+      int wId, kId;
+      for (i = 0; i < nPolymer(); ++i) {
+         for (j = 0; j < polymer(i).nBlock(); ++j) {
+            Block<D>& block = polymer(i).block(j);
+            block.setMirrorFFT(fftMirrorPtr);
+            wId = expCache_.expWId(block.monomerId(), block.ds());
+            kId = expCache_.expKsqId(block.kuhn(), block.ds());
+            block.setupSolver(expCache_, wId, kId);
+         }
+      }
+   }
+
    /*
    * Compute total stress for this mixture.
    */
@@ -239,8 +512,28 @@ namespace Rpc
       if (nPolymer() > 0) {
 
          // Compute stress for all polymers, after solving MDE
-         for (i = 0; i < nPolymer(); ++i) {
-            polymer(i).computeStress();
+         if (!waveList_.hasdKSq()) {
+            waveList_.computedKSq();
+         }
+         int np = nPolymer();
+         std::exception_ptr error = nullptr;
+         #ifdef PSCF_OPENMP
+         #pragma omp parallel for schedule(dynamic,1) if (parallelSpecies_)
+         #endif
+         for (int ip = 0; ip < np; ++ip) {
+            try {
+               polymer(ip).computeStress();
+            } catch (...) {
+               #ifdef PSCF_OPENMP
+               #pragma omp critical (rpc_mixture_species)
+               #endif
+               {
+                  if (!error) error = std::current_exception();
+               }
+            }
+         }
+         if (error) {
+            std::rethrow_exception(error);
          }
    
          // Accumulate stress for all the polymer chains
@@ -113,6 +113,10 @@ namespace Rpc {
       * is called, the associated Block objects store pre-computed 
       * propagator solutions and block volume fraction fields. 
       *
+      * Each block computes its own exp(-w ds/2) and exp(-k^2 b^2 ds/6)
+      * arrays. Mixture<D>::compute instead sets up all blocks to use
+      * arrays from a shared ExpCache<D>, and then calls solve directly.
+      *
       * The parameter phiTot is only relevant to problems such as thin
       * films in which the material is excluded from part of the unit
       * cell by imposing an inhogeneous constraint on the sum of the
@@ -150,6 +154,7 @@ namespace Rpc {
       using Base::ensemble;
       using Base::solve;
       using Base::length;
+      using Base::identicalBlockId;
 
    protected:
 
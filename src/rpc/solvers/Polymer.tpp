@@ -87,12 +87,18 @@ namespace Rpc {
         stress_[i] = 0.0;
       }
 
-      // Compute and accumulate stress contributions from all blocks
+      // Compute and accumulate stress contributions from all blocks.
+      // Blocks identical to a preceding block (if sharing of identical 
+      // propagators is enabled) contribute the same stress.
       double prefactor = exp(mu_)/length();
+      int r;
       for (int i = 0; i < nBlock(); ++i) {
-         block(i).computeStress(prefactor);
+         r = identicalBlockId(i);
+         if (r == i) {
+            block(i).computeStress(prefactor);
+         }
          for (int j = 0; j < nParam_ ; ++j){
-            stress_[j] += block(i).stress(j);
+            stress_[j] += block(r).stress(j);
          }
       }
 
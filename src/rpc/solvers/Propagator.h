@@ -9,6 +9,7 @@
 */
 
 #include <prdc/cpu/RField.h>             // member template
+#include <prdc/crystal/MeshOrbits.h>     // member template
 #include <pscf/solvers/PropagatorTmpl.h> // base class template
 #include <util/containers/DArray.h>      // member template
 #include <util/containers/FArray.h>      // member template
@@ -101,12 +102,48 @@ namespace Rpc {
       *
       * The address of the associated Mesh<D> object is retained.
       *
+      * If useCheckpoints is true, only a set of roughly sqrt(ns-1) 
+      * "checkpoint" slices (including the head and tail) are stored 
+      * after a solution of the MDE, along with a buffer for one segment 
+      * of slices between consecutive checkpoints. Other slices are 
+      * recomputed from the preceding checkpoint on demand by the q(int) 
+      * function. This reduces memory use from ns slices to roughly 
+      * 2*sqrt(ns) slices, at the cost of roughly one additional MDE 
+      * solution for each sequential pass through all slices.
+      *
+      * If useFloat is true, slices other than the head and tail are
+      * stored in single precision (float) arrays, while the MDE is still
+      * solved in double precision. This roughly halves the memory used
+      * to store the solution. The options useCheckpoints and useFloat 
+      * may not both be true, and neither may be combined with storage 
+      * on the asymmetric unit (see setMeshOrbits).
+      *
       * An Exception is thrown if the propagator is already allocated.
       * 
       * \param ns  number of slices (including end points)
       * \param mesh  spatial discretization mesh
+      * \param useCheckpoints  if true, store only checkpoint slices
+      * \param useFloat  if true, store interior slices as float
       */ 
-      void allocate(int ns, const Mesh<D>& mesh);
+      void allocate(int ns, const Mesh<D>& mesh, 
+                    bool useCheckpoints = false, bool useFloat = false);
+
+      /**
+      * Store interior slices only within the asymmetric unit.
+      *
+      * If orbits is not null, slices other than the head and tail are 
+      * stored with one value for each orbit of mesh nodes under the 
+      * operations of a space group (i.e., within the asymmetric unit),
+      * while the MDE is still solved on the full mesh. This reduces the
+      * memory used to store the solution by a factor approximately 
+      * equal to the order of the group. This is valid only if the w 
+      * fields, and thus all slices, are invariant under the group. It
+      * may not be combined with checkpoints or float storage. This 
+      * function must be called before allocate.
+      *
+      * \param orbits  orbits of mesh nodes, or null for full storage
+      */
+      void setMeshOrbits(MeshOrbits<D> const * orbits);
 
       /**
       * Reallocate memory used by this propagator.
@@ -126,6 +163,20 @@ namespace Rpc {
       */ 
       void reallocate(int ns);
 
+      /**
+      * Set or clear an identical propagator.
+      *
+      * This hides PropagatorTmpl::setIdentical. When an identical 
+      * propagator is set, all memory used to store slices of this 
+      * propagator is released, and all slice accessors instead return
+      * slices of the identical propagator, which must have the same 
+      * number of slices. When the association is cleared (by passing
+      * a null pointer), memory for slices is allocated again.
+      *
+      * \param identicalPtr  pointer to identical propagator, or null
+      */
+      void setIdentical(Propagator<D> const * identicalPtr);
+
       /**
       * Solve the modified diffusion equation (MDE) for this block.
       *
@@ -136,6 +187,11 @@ namespace Rpc {
       * the tail QFields of all source propagators. The MDE is solved
       * by repeatedly calling the step() function of the associated
       * Block<D> .
+      *
+      * If Block<D>::fuseConcentration() is true for the associated
+      * block and the partner propagator is already solved, each slice
+      * is also passed to Block<D>::accumulateConcentration as soon as
+      * it is computed.
       */
       void solve();
   
@@ -166,10 +222,46 @@ namespace Rpc {
       /**
       * Return q-field at specified step.
       *
+      * If checkpoints are used and slice i is not a checkpoint, the 
+      * slice is recomputed if necessary, along with all other slices 
+      * of the segment between the enclosing checkpoints, and the 
+      * returned reference is to an element of an internal buffer. Such
+      * a reference remains valid only until q() is next called with an 
+      * index in a different segment. Access to slices in increasing or 
+      * decreasing order requires one recomputation per segment.
+      *
+      * If interior slices are stored in single precision or on the
+      * asymmetric unit, slice i is converted to double precision on the
+      * full mesh in an internal buffer, and the returned reference 
+      * remains valid only until the next call to q().
+      *
+      * If an identical propagator has been set (see hasIdentical()), 
+      * this and the other slice accessors return slices of that one.
+      *
       * \param i step index, 0 <= i < ns
       */
       const QField& q(int i) const;
 
+      /**
+      * Return single precision q-field at an interior step.
+      *
+      * May only be called if useFloat() is true, for 0 < i < ns - 1.
+      *
+      * \param i step index, 0 < i < ns - 1
+      */
+      DArray<float> const & qFloat(int i) const;
+
+      /**
+      * Return q-field on the asymmetric unit at an interior step.
+      *
+      * Element k is the value at the representative node of orbit k
+      * of the associated MeshOrbits<D>. May only be called if 
+      * useOrbits() is true, for 0 < i < ns - 1.
+      *
+      * \param i step index, 0 < i < ns - 1
+      */
+      DArray<double> const & qOrbit(int i) const;
+
       /**
       * Return q-field at beginning of the block (initial condition).
       */
@@ -200,6 +292,21 @@ namespace Rpc {
       */
       bool isAllocated() const;
 
+      /**
+      * Does this propagator store only checkpoint slices?
+      */
+      bool useCheckpoints() const;
+
+      /**
+      * Does this propagator store interior slices in single precision?
+      */
+      bool useFloat() const;
+
+      /**
+      * Does this propagator store interior slices on the asymmetric unit?
+      */
+      bool useOrbits() const;
+
       // Inherited public members with non-dependent names
 
       using PropagatorTmpl< Propagator<D> >::nSource;
@@ -208,6 +315,8 @@ namespace Rpc {
       using PropagatorTmpl< Propagator<D> >::setIsSolved;
       using PropagatorTmpl< Propagator<D> >::isSolved;
       using PropagatorTmpl< Propagator<D> >::hasPartner;
+      using PropagatorTmpl< Propagator<D> >::hasIdentical;
+      using PropagatorTmpl< Propagator<D> >::identical;
 
    protected:
 
@@ -218,9 +327,21 @@ namespace Rpc {
 
    private:
      
-      /// Array of statistical weight fields 
+      /// Array of stored statistical weight fields (all or checkpoints)
       DArray<QField> qFields_;
 
+      /// Slices between two checkpoints (used only with checkpoints)
+      mutable DArray<QField> segment_;
+
+      /// Single precision interior slices (used only if useFloat_)
+      DArray< DArray<float> > qFloat_;
+
+      /// Interior slices on the asymmetric unit (used only with orbits)
+      DArray< DArray<double> > qOrbit_;
+
+      /// Full mesh copy of a float or asymmetric unit slice
+      mutable QField qBuffer_;
+
       /// Workspace
       QField work_;
 
@@ -230,12 +351,71 @@ namespace Rpc {
       /// Pointer to associated Mesh
       Mesh<D> const * meshPtr_;
 
+      /// Pointer to orbits of mesh nodes (null unless using orbits)
+      MeshOrbits<D> const * orbitsPtr_;
+
       /// Number of grid points = # of contour length steps + 1
       int ns_;
 
+      /// Number of steps between checkpoints (1 if all slices stored)
+      int stride_;
+
+      /// Index of segment currently stored in segment_ (-1 if none)
+      mutable int segmentId_;
+
+      /// Store only checkpoint slices?
+      bool useCheckpoints_;
+
+      /// Store interior slices in single precision?
+      bool useFloat_;
+
       /// Is this propagator allocated?
       bool isAllocated_;
 
+      /**
+      * Allocate qFields_ and segment_ for current ns_ and mode.
+      */
+      void allocateSlices();
+
+      /**
+      * Deallocate all stored slices (qFields_, segment_, qFloat_ and 
+      * qOrbit_).
+      */
+      void deallocateSlices();
+
+      /**
+      * Solve the MDE, given an initial condition in qFields_[0].
+      */
+      void solveFromHead();
+
+      /**
+      * Return a slice that is not stored (checkpoint mode only).
+      *
+      * \param i step index, 0 <= i < ns
+      */
+      QField const & qCheckpointed(int i) const;
+
+      /**
+      * Recompute non-checkpoint slices of one segment.
+      *
+      * \param k segment index (index of checkpoint at start of segment)
+      */
+      void computeSegment(int k) const;
+
+      /**
+      * Return a slice converted from float (float storage only).
+      *
+      * \param i step index, 0 <= i < ns
+      */
+      QField const & qFromFloat(int i) const;
+
+      /**
+      * Return a slice expanded to the full mesh (orbit storage only).
+      *
+      * \param i step index, 0 <= i < ns
+      */
+      QField const & qFromOrbit(int i) const;
+
    };
 
    // Inline member functions
@@ -246,7 +426,12 @@ namespace Rpc {
    template <int D>
    inline 
    typename Propagator<D>::QField const& Propagator<D>::head() const
-   {  return qFields_[0]; }
+   {
+      if (hasIdentical()) {
+         return identical().head();
+      }
+      return qFields_[0]; 
+   }
 
    /*
    * Return q-field at end of block, after solution.
@@ -254,7 +439,12 @@ namespace Rpc {
    template <int D>
    inline 
    typename Propagator<D>::QField const& Propagator<D>::tail() const
-   {  return qFields_[ns_-1]; }
+   {
+      if (hasIdentical()) {
+         return identical().tail();
+      }
+      return qFields_[qFields_.capacity()-1]; 
+   }
 
    /*
    * Return q-field at specified step.
@@ -262,7 +452,49 @@ namespace Rpc {
    template <int D>
    inline 
    typename Propagator<D>::QField const& Propagator<D>::q(int i) const
-   {  return qFields_[i]; }
+   {
+      if (hasIdentical()) {
+         return identical().q(i);
+      } else if (useFloat_) {
+         return qFromFloat(i);
+      } else if (orbitsPtr_) {
+         return qFromOrbit(i);
+      } else if (stride_ > 1) {
+         return qCheckpointed(i);
+      } else {
+         return qFields_[i]; 
+      }
+   }
+
+   /*
+   * Return single precision q-field at an interior step.
+   */
+   template <int D>
+   inline 
+   DArray<float> const & Propagator<D>::qFloat(int i) const
+   {
+      UTIL_ASSERT(useFloat_);
+      UTIL_ASSERT(i > 0 && i < ns_ - 1);
+      if (hasIdentical()) {
+         return identical().qFloat(i);
+      }
+      return qFloat_[i-1]; 
+   }
+
+   /*
+   * Return q-field on the asymmetric unit at an interior step.
+   */
+   template <int D>
+   inline 
+   DArray<double> const & Propagator<D>::qOrbit(int i) const
+   {
+      UTIL_ASSERT(orbitsPtr_);
+      UTIL_ASSERT(i > 0 && i < ns_ - 1);
+      if (hasIdentical()) {
+         return identical().qOrbit(i);
+      }
+      return qOrbit_[i-1]; 
+   }
 
    /*
    * Get the associated Block object.
@@ -286,6 +518,27 @@ namespace Rpc {
    inline bool Propagator<D>::isAllocated() const
    {  return isAllocated_; }
 
+   /*
+   * Does this propagator store only checkpoint slices?
+   */
+   template <int D>
+   inline bool Propagator<D>::useCheckpoints() const
+   {  return useCheckpoints_; }
+
+   /*
+   * Does this propagator store interior slices in single precision?
+   */
+   template <int D>
+   inline bool Propagator<D>::useFloat() const
+   {  return useFloat_; }
+
+   /*
+   * Does this propagator store interior slices on the asymmetric unit?
+   */
+   template <int D>
+   inline bool Propagator<D>::useOrbits() const
+   {  return (orbitsPtr_ != 0); }
+
    /*
    * Associate this propagator with a unique block.
    */
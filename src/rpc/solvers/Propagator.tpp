@@ -13,6 +13,9 @@
 
 #include <pscf/mesh/Mesh.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace Pscf {
 namespace Rpc {
 
@@ -25,7 +28,12 @@ namespace Rpc {
    Propagator<D>::Propagator()
     : blockPtr_(0),
       meshPtr_(0),
+      orbitsPtr_(0),
       ns_(0),
+      stride_(1),
+      segmentId_(-1),
+      useCheckpoints_(false),
+      useFloat_(false),
       isAllocated_(false)
    {}
 
@@ -40,19 +48,42 @@ namespace Rpc {
    * Allocate memory used by this propagator.
    */
    template <int D>
-   void Propagator<D>::allocate(int ns, const Mesh<D>& mesh)
+   void Propagator<D>::allocate(int ns, const Mesh<D>& mesh, 
+                                bool useCheckpoints, bool useFloat)
    {
       UTIL_CHECK(!isAllocated_);
+      if (useCheckpoints && useFloat) {
+         UTIL_THROW("Checkpoints and float storage cannot be combined");
+      }
+      if (orbitsPtr_ && (useCheckpoints || useFloat)) {
+         UTIL_THROW(
+            "Asymmetric unit storage cannot be combined with checkpoints or floats");
+      }
+      if (orbitsPtr_) {
+         UTIL_CHECK(orbitsPtr_->meshSize() == mesh.size());
+      }
       ns_ = ns;
       meshPtr_ = &mesh;
+      useCheckpoints_ = useCheckpoints;
+      useFloat_ = useFloat;
 
-      qFields_.allocate(ns);
-      for (int i = 0; i < ns; ++i) {
-         qFields_[i].allocate(mesh.dimensions());
-      }
+      allocateSlices();
       isAllocated_ = true;
    }
 
+   /*
+   * Set orbits used to store interior slices on the asymmetric unit.
+   */
+   template <int D>
+   void Propagator<D>::setMeshOrbits(MeshOrbits<D> const * orbits)
+   {
+      UTIL_CHECK(!isAllocated_);
+      if (orbits) {
+         UTIL_CHECK(orbits->isInitialized());
+      }
+      orbitsPtr_ = orbits;
+   }
+
    /*
    * Reallocate memory used by this propagator using new ns value.
    */
@@ -64,7 +95,7 @@ namespace Rpc {
       ns_ = ns;
 
       // Deallocate all memory previously used by this propagator.
-      qFields_.deallocate();
+      deallocateSlices();
 
       // NOTE: The qFields_ container is a DArray<QField>, where QField
       // is a typedef for DFields<D>. The DArray::deallocate() function
@@ -74,15 +105,136 @@ namespace Rpc {
       // The RField<D> destructor deletes the the double* array that 
       // stores the field associated with each slice of the propagator.
 
-      // Allocate new memory for qFields_ using new value of ns
-      qFields_.allocate(ns);
-      for (int i = 0; i < ns; ++i) {
-         qFields_[i].allocate(meshPtr_->dimensions());
+      // Allocate new memory for qFields_ using new value of ns, unless
+      // slices are currently provided by an identical propagator
+      if (!hasIdentical()) {
+         allocateSlices();
       }
 
       setIsSolved(false);
    }
 
+   /*
+   * Set or clear an identical propagator, releasing or restoring slices.
+   */
+   template <int D>
+   void Propagator<D>::setIdentical(Propagator<D> const * identicalPtr)
+   {
+      PropagatorTmpl< Propagator<D> >::setIdentical(identicalPtr);
+      if (identicalPtr) {
+         UTIL_CHECK(identicalPtr != this);
+         UTIL_CHECK(identicalPtr->ns() == ns_);
+         if (qFields_.isAllocated()) {
+            deallocateSlices();
+         }
+      } else {
+         if (isAllocated_ && !qFields_.isAllocated()) {
+            allocateSlices();
+         }
+      }
+   }
+
+   /*
+   * Allocate qFields_ (and segment_, if needed) for current ns_.
+   */
+   template <int D>
+   void Propagator<D>::allocateSlices()
+   {
+      UTIL_CHECK(ns_ > 1);
+      UTIL_CHECK(meshPtr_);
+
+      // Choose number of steps between checkpoints
+      if (useCheckpoints_) {
+         stride_ = (int) std::ceil(std::sqrt(double(ns_ - 1)));
+         if (stride_ < 1) stride_ = 1;
+      } else {
+         stride_ = 1;
+      }
+
+      // Orbit storage: Store head and tail in qFields_, and interior
+      // slices on the asymmetric unit in qOrbit_.
+      if (orbitsPtr_) {
+         qFields_.allocate(2);
+         qFields_[0].allocate(meshPtr_->dimensions());
+         qFields_[1].allocate(meshPtr_->dimensions());
+         int nOrbit = orbitsPtr_->nOrbit();
+         if (ns_ > 2) {
+            qOrbit_.allocate(ns_ - 2);
+            for (int i = 0; i < ns_ - 2; ++i) {
+               qOrbit_[i].allocate(nOrbit);
+            }
+         }
+         if (!work_.isAllocated()) {
+            work_.allocate(meshPtr_->dimensions());
+         }
+         if (!qBuffer_.isAllocated()) {
+            qBuffer_.allocate(meshPtr_->dimensions());
+         }
+         segmentId_ = -1;
+         return;
+      }
+
+      // Float storage: Store head and tail in qFields_, and interior 
+      // slices in qFloat_.
+      if (useFloat_) {
+         qFields_.allocate(2);
+         qFields_[0].allocate(meshPtr_->dimensions());
+         qFields_[1].allocate(meshPtr_->dimensions());
+         int nx = meshPtr_->size();
+         if (ns_ > 2) {
+            qFloat_.allocate(ns_ - 2);
+            for (int i = 0; i < ns_ - 2; ++i) {
+               qFloat_[i].allocate(nx);
+            }
+         }
+         if (!work_.isAllocated()) {
+            work_.allocate(meshPtr_->dimensions());
+         }
+         if (!qBuffer_.isAllocated()) {
+            qBuffer_.allocate(meshPtr_->dimensions());
+         }
+         segmentId_ = -1;
+         return;
+      }
+
+      // Checkpoints at slices 0, stride_, 2*stride_, ..., and ns_ - 1
+      int nCheckpoint = (ns_ - 1 + stride_ - 1)/stride_ + 1;
+      qFields_.allocate(nCheckpoint);
+      for (int i = 0; i < nCheckpoint; ++i) {
+         qFields_[i].allocate(meshPtr_->dimensions());
+      }
+
+      // Buffer for slices between consecutive checkpoints
+      if (stride_ > 1) {
+         segment_.allocate(stride_ - 1);
+         for (int i = 0; i < stride_ - 1; ++i) {
+            segment_[i].allocate(meshPtr_->dimensions());
+         }
+      }
+      segmentId_ = -1;
+   }
+
+   /*
+   * Deallocate qFields_, segment_, qFloat_ and qOrbit_, if allocated.
+   */
+   template <int D>
+   void Propagator<D>::deallocateSlices()
+   {
+      if (qFields_.isAllocated()) {
+         qFields_.deallocate();
+      }
+      if (segment_.isAllocated()) {
+         segment_.deallocate();
+      }
+      if (qFloat_.isAllocated()) {
+         qFloat_.deallocate();
+      }
+      if (qOrbit_.isAllocated()) {
+         qOrbit_.deallocate();
+      }
+      segmentId_ = -1;
+   }
+
    /*
    * Compute initial head QField from final tail QFields of sources.
    */
@@ -96,6 +248,9 @@ namespace Rpc {
       // Initialize qh field to 1.0 at all grid points
       int ix;
       int nx = meshPtr_->size();
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for
+      #endif
       for (ix = 0; ix < nx; ++ix) {
          qh[ix] = 1.0;
       }
@@ -106,6 +261,9 @@ namespace Rpc {
             UTIL_THROW("Source not solved in computeHead");
          }
          QField const& qt = source(is).tail();
+         #ifdef PSCF_OPENMP
+         #pragma omp parallel for
+         #endif
          for (ix = 0; ix < nx; ++ix) {
             qh[ix] *= qt[ix];
          }
@@ -119,10 +277,9 @@ namespace Rpc {
    void Propagator<D>::solve()
    {
       UTIL_CHECK(isAllocated());
+      UTIL_CHECK(!hasIdentical());
       computeHead();
-      for (int iStep = 0; iStep < ns_ - 1; ++iStep) {
-         block().step(qFields_[iStep], qFields_[iStep + 1]);
-      }
+      solveFromHead();
       setIsSolved(true);
    }
 
@@ -134,20 +291,185 @@ namespace Rpc {
    {
       int nx = meshPtr_->size();
       UTIL_CHECK(head.capacity() == nx);
+      UTIL_CHECK(!hasIdentical());
 
       // Initialize initial (head) field
       QField& qh = qFields_[0];
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for
+      #endif
       for (int i = 0; i < nx; ++i) {
          qh[i] = head[i];
       }
 
-      // Setup solver and solve
-      for (int iStep = 0; iStep < ns_ - 1; ++iStep) {
-         block().step(qFields_[iStep], qFields_[iStep + 1]);
-      }
+      // Solve
+      solveFromHead();
       setIsSolved(true);
    }
 
+   /*
+   * Solve the MDE, given an initial condition in qFields_[0].
+   */
+   template <int D>
+   void Propagator<D>::solveFromHead()
+   {
+      // If the block concentration is computed during this solution,
+      // pass each slice to the block as soon as it is computed
+      Block<D>& b = block();
+      bool fuse = b.fuseConcentration() && hasPartner() 
+                  && partner().isSolved();
+      if (fuse) {
+         b.accumulateConcentration(0, qFields_[0], partner());
+      }
+
+      if (useFloat_ || orbitsPtr_) {
+         // Step in double precision on the full mesh, alternating 
+         // between two work fields, and store a float copy or an 
+         // asymmetric unit copy of each interior slice.
+         int nx = meshPtr_->size();
+         QField const * qPtr = &qFields_[0];
+         for (int j = 1; j < ns_ - 1; ++j) {
+            QField& qNew = (j % 2 == 1) ? work_ : qBuffer_;
+            b.step(*qPtr, qNew);
+            if (orbitsPtr_) {
+               orbitsPtr_->reduce(qNew, qOrbit_[j-1]);
+            } else {
+               DArray<float>& qf = qFloat_[j-1];
+               #ifdef PSCF_OPENMP
+               #pragma omp parallel for
+               #endif
+               for (int i = 0; i < nx; ++i) {
+                  qf[i] = (float) qNew[i];
+               }
+            }
+            if (fuse) {
+               b.accumulateConcentration(j, qNew, partner());
+            }
+            qPtr = &qNew;
+         }
+         b.step(*qPtr, qFields_[1]);
+         if (fuse) {
+            b.accumulateConcentration(ns_ - 1, qFields_[1], partner());
+         }
+      } else if (stride_ == 1) {
+         for (int iStep = 0; iStep < ns_ - 1; ++iStep) {
+            b.step(qFields_[iStep], qFields_[iStep + 1]);
+            if (fuse) {
+               b.accumulateConcentration(iStep + 1, qFields_[iStep + 1],
+                                         partner());
+            }
+         }
+      } else {
+         // Loop over segments, storing interior slices in segment_ 
+         int nSegment = qFields_.capacity() - 1;
+         int begin, end, last;
+         for (int k = 0; k < nSegment; ++k) {
+            computeSegment(k);
+            begin = k*stride_;
+            end = std::min((k + 1)*stride_, ns_ - 1);
+            if (fuse) {
+               for (int j = begin + 1; j < end; ++j) {
+                  b.accumulateConcentration(j, segment_[j - begin - 1],
+                                            partner());
+               }
+            }
+            last = end - begin - 2;
+            if (last >= 0) {
+               b.step(segment_[last], qFields_[k+1]);
+            } else {
+               b.step(qFields_[k], qFields_[k+1]);
+            }
+            if (fuse) {
+               b.accumulateConcentration(end, qFields_[k+1], partner());
+            }
+         }
+      }
+   }
+
+   /*
+   * Return a slice, recomputing it if necessary (checkpoint mode only).
+   */
+   template <int D>
+   typename Propagator<D>::QField const & 
+   Propagator<D>::qCheckpointed(int i) const
+   {
+      UTIL_CHECK(i >= 0 && i < ns_);
+      if (i == ns_ - 1) {
+         return tail();
+      }
+      int k = i/stride_;
+      int j = i - k*stride_;
+      if (j == 0) {
+         return qFields_[k];
+      }
+      if (segmentId_ != k) {
+         UTIL_CHECK(isSolved());
+         computeSegment(k);
+      }
+      return segment_[j-1];
+   }
+
+   /*
+   * Recompute all slices in the interior of segment k.
+   */
+   template <int D>
+   void Propagator<D>::computeSegment(int k) const
+   {
+      UTIL_CHECK(blockPtr_);
+      int begin = k*stride_;
+      int end = std::min(begin + stride_, ns_ - 1);
+      QField const * qPtr = &qFields_[k];
+      for (int j = begin + 1; j < end; ++j) {
+         QField& qNew = segment_[j - begin - 1];
+         blockPtr_->step(*qPtr, qNew);
+         qPtr = &qNew;
+      }
+      segmentId_ = k;
+   }
+
+   /*
+   * Return a slice converted to double precision (float storage only).
+   */
+   template <int D>
+   typename Propagator<D>::QField const & 
+   Propagator<D>::qFromFloat(int i) const
+   {
+      UTIL_CHECK(i >= 0 && i < ns_);
+      if (i == 0) {
+         return head();
+      }
+      if (i == ns_ - 1) {
+         return tail();
+      }
+      DArray<float> const & qf = qFloat_[i-1];
+      int nx = meshPtr_->size();
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for
+      #endif
+      for (int k = 0; k < nx; ++k) {
+         qBuffer_[k] = (double) qf[k];
+      }
+      return qBuffer_;
+   }
+
+   /*
+   * Return a slice expanded to the full mesh (orbit storage only).
+   */
+   template <int D>
+   typename Propagator<D>::QField const & 
+   Propagator<D>::qFromOrbit(int i) const
+   {
+      UTIL_CHECK(i >= 0 && i < ns_);
+      if (i == 0) {
+         return head();
+      }
+      if (i == ns_ - 1) {
+         return tail();
+      }
+      orbitsPtr_->expand(qOrbit_[i-1], qBuffer_);
+      return qBuffer_;
+   }
+
    /*
    * Compute spatial average of product of head and tail of partner.
    */
@@ -172,6 +494,9 @@ namespace Rpc {
 
       // Take inner product of head and partner tail fields
       double Q = 0;
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for reduction(+:Q)
+      #endif
       for (int i =0; i < nx; ++i) {
          Q += qh[i]*qt[i];
       }
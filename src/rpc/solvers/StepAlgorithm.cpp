@@ -0,0 +1,90 @@
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "StepAlgorithm.h"
+#include <util/global.h>
+#include <string>
+
+namespace Pscf {
+namespace Rpc {
+
+   using namespace Util;
+
+   /*
+   * Order of accuracy.
+   */
+   int StepAlgorithm::order(StepAlgorithm::Enum algorithm)
+   {
+      if (algorithm == StepAlgorithm::RQM6) {
+         return 6;
+      } 
+      return 4;
+   }
+
+   /*
+   * Number of Strang splitting steps per contour step.
+   */
+   int StepAlgorithm::nStrangStep(StepAlgorithm::Enum algorithm)
+   {
+      if (algorithm == StepAlgorithm::RQM6) {
+         return 7;
+      } 
+      return 3;
+   }
+
+   /*
+   * Leading error constant (see class documentation).
+   */
+   double StepAlgorithm::errorConstant(StepAlgorithm::Enum algorithm)
+   {
+      if (algorithm == StepAlgorithm::RQM6) {
+         return 1.0/64.0;
+      } 
+      return 1.0/4.0;
+   }
+
+   /*
+   * Input stream extractor for a StepAlgorithm enumeration.
+   */ 
+   std::istream& operator >> (std::istream& in, 
+                              StepAlgorithm::Enum& algorithm)
+   {
+      std::string buffer;
+      in >> buffer;
+      if (buffer == "RQM4" || buffer == "rqm4") {
+         algorithm = StepAlgorithm::RQM4;
+      } else
+      if (buffer == "RQM6" || buffer == "rqm6") {
+         algorithm = StepAlgorithm::RQM6;
+      } else {
+         std::string msg = "Unknown input StepAlgorithm value string: ";
+         msg += buffer;
+         UTIL_THROW(msg.c_str());
+      } 
+      return in;
+   }
+
+   /*
+   * Output stream inserter for a StepAlgorithm enumeration.
+   */ 
+   std::ostream& operator << (std::ostream& out, 
+                              StepAlgorithm::Enum& algorithm)
+   {
+      if (algorithm == StepAlgorithm::RQM4) {
+         out << "RQM4";
+      } else
+      if (algorithm == StepAlgorithm::RQM6) {
+         out << "RQM6";
+      } else {
+         // This should never happen
+         UTIL_THROW("Error writing a StepAlgorithm value");
+      }
+      return out;
+   }
+
+}
+}
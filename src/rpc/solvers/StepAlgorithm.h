@@ -0,0 +1,106 @@
+#ifndef RPC_STEP_ALGORITHM_H
+#define RPC_STEP_ALGORITHM_H
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/archives/serialize.h>
+#include <iostream>
+
+namespace Pscf {
+namespace Rpc {
+
+   using namespace Util;
+
+   /**
+   * Struct containing an enumeration of MDE contour step algorithms.
+   *
+   * Both algorithms are based on the symmetric (Strang) splitting of 
+   * the MDE operator into diffusion and field terms, which is 2nd order
+   * accurate, combined with Richardson extrapolation:
+   *
+   *  - RQM4: Extrapolation from one step of length ds and two steps of
+   *    length ds/2. This is 4th order accurate, and requires 3 Strang 
+   *    steps (3 forward and 3 inverse FFTs) per contour step. This is 
+   *    the default algorithm.
+   *
+   *  - RQM6: Extrapolation from one step of length ds, two steps of 
+   *    length ds/2 and four steps of length ds/4. This is 6th order
+   *    accurate, and requires 7 Strang steps per contour step.
+   *
+   * The error after a contour step of length ds of a Strang splitting 
+   * with n substeps of length h = ds/n has an expansion of the form
+   * a h^2 + b h^4 + c h^6 + ..., in which a, b, c are functions of the
+   * fields and of ds that do not depend on h. The errors of the RQM4
+   * and RQM6 algorithms are -b ds^4/4 and c ds^6/64 respectively. The 
+   * prefactors 1/4 and 1/64 are returned by errorConstant(). 
+   *
+   * \ingroup Rpc_Solver_Module
+   */
+   struct StepAlgorithm {
+
+      enum Enum {RQM4, RQM6};
+
+      /**
+      * Order of accuracy p (global error of order ds^p).
+      *
+      * \param algorithm  step algorithm
+      */
+      static int order(Enum algorithm);
+
+      /**
+      * Number of Strang splitting steps per contour step.
+      *
+      * Each Strang step requires one forward and one inverse FFT.
+      *
+      * \param algorithm  step algorithm
+      */
+      static int nStrangStep(Enum algorithm);
+
+      /**
+      * Leading error constant, in units of Strang expansion coefficients.
+      *
+      * \param algorithm  step algorithm
+      */
+      static double errorConstant(Enum algorithm);
+
+   };
+
+   /**
+   * Input stream extractor for a StepAlgorithm::Enum enumeration.
+   *
+   * \param in  input stream
+   * \param algorithm  value of StepAlgorithm to be read from file
+   */ 
+   std::istream& operator >> (std::istream& in, 
+                              StepAlgorithm::Enum& algorithm); 
+
+   /**
+   * Output stream inserter for a StepAlgorithm::Enum enumeration.
+   *
+   * \param out  output stream
+   * \param algorithm  value of StepAlgorithm to be written 
+   */ 
+   std::ostream& operator << (std::ostream& out, 
+                              StepAlgorithm::Enum& algorithm); 
+
+   /**
+   * Serialize a StepAlgorithm::Enum enumeration.
+   *
+   * \param ar  archive
+   * \param data  enumeration data to be serialized
+   * \param version  version id
+   */ 
+   template <class Archive>
+   inline void 
+   serialize(Archive& ar, StepAlgorithm::Enum& data, 
+             const unsigned int version)
+   {  serializeEnum(ar, data, version); }
+
+}
+}
+#endif
@@ -0,0 +1,184 @@
+#ifndef RPC_WAVE_LIST_TPP
+#define RPC_WAVE_LIST_TPP
+
+/*
+* PSCF - Polymer Self-Consistent Field Theory
+*
+* Copyright 2016 - 2022, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "WaveList.h"
+#include <prdc/crystal/shiftToMinimum.h>
+#include <pscf/mesh/MeshIterator.h>
+
+namespace Pscf {
+namespace Rpc
+{
+
+   template <int D>
+   WaveList<D>::WaveList()
+    : kSize_(0),
+      isAllocated_(false),
+      hasMinimumImages_(false),
+      hasKSq_(false),
+      hasdKSq_(false),
+      unitCellPtr_(nullptr),
+      meshPtr_(nullptr)
+   {}
+
+   template <int D>
+   WaveList<D>::~WaveList()
+   {}
+
+   template <int D>
+   void WaveList<D>::allocate(Mesh<D> const & m, UnitCell<D> const & c)
+   {
+      UTIL_CHECK(m.size() > 0);
+      UTIL_CHECK(c.nParameter() > 0);
+      UTIL_CHECK(!isAllocated_);
+
+      // Create permanent associations with mesh and unit cell
+      unitCellPtr_ = &c;
+      meshPtr_ = &m;
+
+      int nParams = unitCell().nParameter();
+
+      // Compute DFT mesh size kSize_ and dimensions kMeshDimensions_
+      kSize_ = 1;
+      for(int i = 0; i < D; ++i) {
+         if (i < D - 1) {
+            kMeshDimensions_[i] = mesh().dimension(i);
+         } else {
+            kMeshDimensions_[i] = mesh().dimension(i) / 2 + 1;
+         }
+         kSize_ *= kMeshDimensions_[i];
+      }
+
+      minImages_.allocate(kSize_);
+      kSq_.allocate(kMeshDimensions_);
+      dKSq_.allocate(nParams);
+      for (int i = 0; i < nParams; i++) {
+         dKSq_[i].allocate(kMeshDimensions_);
+      }
+
+      // Set up implicitInverse_ array (only depends on mesh dimensions)
+      implicitInverse_.allocate(kSize_);
+      MeshIterator<D> kItr(kMeshDimensions_);
+      int inverseId;
+      for (kItr.begin(); !kItr.atEnd(); ++kItr) {
+         if (kItr.position(D-1) == 0) {
+            inverseId = 0;
+         } else {
+            inverseId = mesh().dimension(D-1) - kItr.position(D-1);
+         }
+         if (inverseId > kMeshDimensions_[D-1]) {
+            implicitInverse_[kItr.rank()] = true;
+         } else {
+            implicitInverse_[kItr.rank()] = false;
+         }
+      }
+
+      isAllocated_ = true;
+   }
+
+   template <int D>
+   void WaveList<D>::clearUnitCellData()
+   {
+      // Note: The lattice system is known if minimum images exist
+      if (hasMinimumImages_ && hasVariableAngle()) {
+         hasMinimumImages_ = false;
+      }
+      hasKSq_ = false;
+      hasdKSq_ = false;
+   }
+
+   template <int D>
+   void WaveList<D>::computeMinimumImages()
+   {
+      if (hasMinimumImages_) return; // min images already calculated
+
+      // Precondition
+      UTIL_CHECK(isAllocated_);
+      UTIL_CHECK(unitCell().lattice() != UnitCell<D>::Null);
+      UTIL_CHECK(unitCell().isInitialized());
+      UTIL_CHECK(minImages_.capacity() == kSize_);
+
+      // Compute minimum images and kSq
+      MeshIterator<D> kItr(kMeshDimensions_);
+      IntVec<D> G, Gmin;
+      int i;
+      for (kItr.begin(); !kItr.atEnd(); ++kItr) {
+         i = kItr.rank();
+         G = kItr.position();
+         Gmin = shiftToMinimum(G, mesh().dimensions(), unitCell());
+         minImages_[i] = Gmin;
+         kSq_[i] = unitCell().ksq(Gmin);
+      }
+
+      hasMinimumImages_ = true;
+      hasKSq_ = true;
+   }
+
+   template <int D>
+   void WaveList<D>::computeKSq()
+   {
+      if (hasKSq_) return; // kSq already calculated
+
+      if (!hasMinimumImages_) {
+         computeMinimumImages(); // compute both min images and kSq
+         return;
+      }
+
+      // Precondition
+      UTIL_CHECK(unitCell().nParameter() > 0);
+      UTIL_CHECK(unitCell().lattice() != UnitCell<D>::Null);
+      UTIL_CHECK(unitCell().isInitialized());
+
+      // Compute kSq using existing minimum images
+      #ifdef PSCF_OPENMP
+      #pragma omp parallel for
+      #endif
+      for (int i = 0; i < kSize_; ++i) {
+         kSq_[i] = unitCell().ksq(minImages_[i]);
+      }
+
+      hasKSq_ = true;
+   }
+
+   template <int D>
+   void WaveList<D>::computedKSq()
+   {
+      if (hasdKSq_) return; // dKSq already calculated
+
+      // Compute minimum images if needed
+      if (!hasMinimumImages_) {
+         computeMinimumImages();
+      }
+
+      // Precondition
+      UTIL_CHECK(unitCell().nParameter() > 0);
+      UTIL_CHECK(unitCell().lattice() != UnitCell<D>::Null);
+      UTIL_CHECK(unitCell().isInitialized());
+
+      int nParams = unitCell().nParameter();
+      UTIL_CHECK(dKSq_.capacity() == nParams);
+      for (int n = 0; n < nParams; ++n) {
+         RField<D>& dKSq = dKSq_[n];
+         #ifdef PSCF_OPENMP
+         #pragma omp parallel for
+         #endif
+         for (int i = 0; i < kSize_; ++i) {
+            dKSq[i] = unitCell().dksq(minImages_[i], n);
+            if (implicitInverse_[i]) { // if inverse of i is implicit
+               dKSq[i] *= 2;
+            }
+         }
+      }
+
+      hasdKSq_ = true;
+   }
+
+}
+}
+#endif
@@ -3,7 +3,10 @@ rpc_solvers_= \
   rpc/solvers/Block.cpp \
   rpc/solvers/Polymer.cpp \
   rpc/solvers/Solvent.cpp \
-  rpc/solvers/Mixture.cpp
+  rpc/solvers/Mixture.cpp \
+  rpc/solvers/WaveList.cpp \
+  rpc/solvers/ExpCache.cpp \
+  rpc/solvers/StepAlgorithm.cpp
 
 rpc_solvers_OBJS=\
      $(addprefix $(BLD_DIR)/, $(rpc_solvers_:.cpp=.o))
@@ -25,6 +25,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <cmath>
 
 using namespace Util;
 using namespace Pscf;
@@ -963,6 +964,157 @@ public:
 
    }
 
+   void testResample_hex() 
+   {
+      printMethod(TEST_FUNC);
+
+      Domain<2> domain;
+      domain.setFileMaster(fileMaster_);
+      readHeader("in/w_hex.rf", domain);
+      IntVec<2> dimensions = domain.mesh().dimensions();
+
+      DArray< RField<2> > rf_0;
+      allocateFields(nMonomer_, dimensions, rf_0);
+      readFields("in/w_hex.rf", domain, rf_0);
+
+      // Resample onto a mesh with twice as many points in each direction
+      IntVec<2> dimensions_fine;
+      dimensions_fine[0] = 2*dimensions[0];
+      dimensions_fine[1] = 2*dimensions[1];
+      std::ofstream  out;
+      openOutputFile("out/w_hex_fine.rf", out);
+      domain.fieldIo().resampleRGrid(out, rf_0, domain.unitCell(),
+                                     dimensions_fine);
+      out.close();
+
+      // Read resampled field 
+      Domain<2> domain_fine;
+      domain_fine.setFileMaster(fileMaster_);
+      readHeader("out/w_hex_fine.rf", domain_fine);
+      TEST_ASSERT(domain_fine.mesh().dimensions() == dimensions_fine);
+      DArray< RField<2> > rf_1;
+      allocateFields(nMonomer_, dimensions_fine, rf_1);
+      readFields("out/w_hex_fine.rf", domain_fine, rf_1);
+
+      // Check values at nodes of the original mesh
+      Mesh<2> mesh(dimensions);
+      Mesh<2> mesh_fine(dimensions_fine);
+      IntVec<2> p;
+      IntVec<2> p_fine;
+      int rank, rank_fine;
+      for (p[0] = 0; p[0] < dimensions[0]; ++p[0]) {
+         p_fine[0] = 2*p[0];
+         for (p[1] = 0; p[1] < dimensions[1]; ++p[1]) {
+            p_fine[1] = 2*p[1];
+            rank = mesh.rank(p);
+            rank_fine = mesh_fine.rank(p_fine);
+            for (int i=0; i < nMonomer_; ++i) {
+               TEST_ASSERT(std::abs(rf_0[i][rank] - rf_1[i][rank_fine])
+                           < 1.0E-8);
+            }
+         }
+      }
+
+      // Resample back onto the original mesh
+      DArray< RField<2> > rf_2;
+      allocateFields(nMonomer_, dimensions, rf_2);
+      domain.fieldIo().resampleFieldsRGrid(rf_1, rf_2);
+      RFieldComparison<2> comparison;
+      comparison.compare(rf_0, rf_2);
+      TEST_ASSERT(comparison.maxDiff() < 1.0E-8);
+
+      // Round trip through a mesh with odd dimensions
+      IntVec<2> dimensions_odd;
+      dimensions_odd[0] = dimensions[0] + 13;
+      dimensions_odd[1] = dimensions[1] + 13;
+      DArray< RField<2> > rf_3;
+      allocateFields(nMonomer_, dimensions_odd, rf_3);
+      domain.fieldIo().resampleFieldsRGrid(rf_0, rf_3);
+      domain.fieldIo().resampleFieldsRGrid(rf_3, rf_2);
+      comparison.compare(rf_0, rf_2);
+      if (verbose() > 0) {
+         std::cout  << "\n";
+         std::cout  << Dbl(comparison.maxDiff(), 21, 13) << "\n";
+         std::cout  << Dbl(comparison.rmsDiff(), 21, 13) << "\n";
+      }
+      TEST_ASSERT(comparison.maxDiff() < 1.0E-8);
+   }
+
+   void testResample_lam() 
+   {
+      printMethod(TEST_FUNC);
+
+      Domain<1> domain;
+      domain.setFileMaster(fileMaster_);
+      readHeader("in/w_lam.rf", domain);
+      IntVec<1> dimensions = domain.mesh().dimensions();
+      int nx = dimensions[0];
+
+      DArray< RField<1> > rf_0;
+      allocateFields(nMonomer_, dimensions, rf_0);
+      readFields("in/w_lam.rf", domain, rf_0);
+
+      // Resample onto a mesh with 3 times as many points
+      IntVec<1> dimensions_fine;
+      dimensions_fine[0] = 3*nx;
+      DArray< RField<1> > rf_1;
+      allocateFields(nMonomer_, dimensions_fine, rf_1);
+      domain.fieldIo().resampleFieldsRGrid(rf_0, rf_1);
+      for (int i = 0; i < nMonomer_; ++i) {
+         for (int j = 0; j < nx; ++j) {
+            TEST_ASSERT(std::abs(rf_0[i][j] - rf_1[i][3*j]) < 1.0E-8);
+         }
+      }
+
+      // Round trip through a mesh with an odd number of points
+      IntVec<1> dimensions_odd;
+      dimensions_odd[0] = nx + 7;
+      DArray< RField<1> > rf_2;
+      allocateFields(nMonomer_, dimensions_odd, rf_2);
+      DArray< RField<1> > rf_3;
+      allocateFields(nMonomer_, dimensions, rf_3);
+      domain.fieldIo().resampleFieldsRGrid(rf_0, rf_2);
+      domain.fieldIo().resampleFieldsRGrid(rf_2, rf_3);
+      RFieldComparison<1> comparison;
+      comparison.compare(rf_0, rf_3);
+      TEST_ASSERT(comparison.maxDiff() < 1.0E-8);
+   }
+
+   void testResample_bcc() 
+   {
+      printMethod(TEST_FUNC);
+
+      Domain<3> domain;
+      domain.setFileMaster(fileMaster_);
+      readHeader("in/w_bcc.rf", domain);
+      IntVec<3> dimensions = domain.mesh().dimensions();
+
+      DArray< RField<3> > rf_0;
+      allocateFields(nMonomer_, dimensions, rf_0);
+      readFields("in/w_bcc.rf", domain, rf_0);
+
+      // Round trip through a mesh with odd and even dimensions
+      IntVec<3> dimensions_new;
+      dimensions_new[0] = dimensions[0] + 9;
+      dimensions_new[1] = dimensions[1] + 4;
+      dimensions_new[2] = dimensions[2] + 13;
+      DArray< RField<3> > rf_1;
+      allocateFields(nMonomer_, dimensions_new, rf_1);
+      DArray< RField<3> > rf_2;
+      allocateFields(nMonomer_, dimensions, rf_2);
+      domain.fieldIo().resampleFieldsRGrid(rf_0, rf_1);
+      domain.fieldIo().resampleFieldsRGrid(rf_1, rf_2);
+
+      RFieldComparison<3> comparison;
+      comparison.compare(rf_0, rf_2);
+      if (verbose() > 0) {
+         std::cout  << "\n";
+         std::cout  << Dbl(comparison.maxDiff(), 21, 13) << "\n";
+         std::cout  << Dbl(comparison.rmsDiff(), 21, 13) << "\n";
+      }
+      TEST_ASSERT(comparison.maxDiff() < 1.0E-8);
+   }
+
    void testExpand_lam_13() 
    {
       printMethod(TEST_FUNC);
@@ -1112,6 +1264,9 @@ TEST_ADD(FieldIoTest, testKGridIo_lam)
 TEST_ADD(FieldIoTest, testConvertBasisKGridRGridKGrid_bcc)
 TEST_ADD(FieldIoTest, testConvertBasisKGridRGridKGrid_c15_1)
 TEST_ADD(FieldIoTest, testReplicate_bcc)
+TEST_ADD(FieldIoTest, testResample_hex)
+TEST_ADD(FieldIoTest, testResample_lam)
+TEST_ADD(FieldIoTest, testResample_bcc)
 TEST_ADD(FieldIoTest, testExpand_lam_13)
 TEST_ADD(FieldIoTest, testExpand_hex_23)
 TEST_END(FieldIoTest)
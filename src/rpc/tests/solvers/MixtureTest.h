@@ -230,6 +230,456 @@ public:
       
    }
 
+   void testSolver1DBranchedParallel()
+   {
+      printMethod(TEST_FUNC);
+      Mixture<1> mixture;
+
+      std::ifstream in;
+      openInputFile("in/MixtureBranched", in);
+      mixture.readParam(in);
+      UnitCell<1> unitCell;
+      in >> unitCell;
+      IntVec<1> d;
+      in >> d;
+      in.close();
+
+      Mesh<1> mesh;
+      mesh.setDimensions(d);
+      FFT<1> fft;
+      fft.setup(d);
+
+      mixture.associate(mesh, fft, unitCell);
+      mixture.allocate();
+      mixture.clearUnitCellData();
+
+      int nMonomer = mixture.nMonomer();
+      DArray< RField<1> > wFields;
+      DArray< RField<1> > cFields;
+      DArray< RField<1> > cFieldsRef;
+      wFields.allocate(nMonomer);
+      cFields.allocate(nMonomer);
+      cFieldsRef.allocate(nMonomer);
+      int nx = mesh.size();
+      for (int i = 0; i < nMonomer; ++i) {
+         wFields[i].allocate(d);
+         cFields[i].allocate(d);
+         cFieldsRef[i].allocate(d);
+      }
+
+      double cs;
+      for (int i = 0; i < nx; ++i) {
+         cs = cos(2.0*Constants::Pi*double(i)/double(nx));
+         wFields[0][i] = 0.5 + cs;
+         wFields[1][i] = 0.5 - cs;
+         wFields[2][i] = 0.5 + 0.5*cs;
+      }
+
+      // Reference solution, solving propagators sequentially
+      TEST_ASSERT(!mixture.polymer(0).parallelSolve());
+      mixture.compute(wFields, cFieldsRef);
+      double Q = mixture.polymer(0).q();
+
+      // Solve again with the dependency-aware concurrent scheduler
+      mixture.polymer(0).setParallelSolve(true);
+      mixture.compute(wFields, cFields);
+      TEST_ASSERT(eq(Q, mixture.polymer(0).q()));
+
+      for (int j = 0; j < nMonomer; ++j) {
+         for (int i = 0; i < nx; ++i) {
+            TEST_ASSERT(eq(cFields[j][i], cFieldsRef[j][i]));
+         }
+      }
+
+      // Every propagator should yield the same partition function
+      int nBlock = mixture.polymer(0).nBlock();
+      for (int ib = 0; ib < nBlock; ++ib) {
+         TEST_ASSERT(eq(Q, mixture.polymer(0).propagator(ib, 0).computeQ()));
+         TEST_ASSERT(eq(Q, mixture.polymer(0).propagator(ib, 1).computeQ()));
+      }
+   }
+
+   void testSolver1DParallelSpecies()
+   {
+      printMethod(TEST_FUNC);
+      Mixture<1> serial;
+      Mixture<1> parallel;
+
+      std::ifstream in;
+      openInputFile("in/MixtureSpecies", in);
+      serial.readParam(in);
+      UnitCell<1> unitCell;
+      in >> unitCell;
+      IntVec<1> d;
+      in >> d;
+      in.close();
+
+      // Identical mixture, with parallelSpecies enabled
+      openInputFile("in/MixtureSpeciesParallel", in);
+      parallel.readParam(in);
+      in.close();
+
+      Mesh<1> mesh;
+      mesh.setDimensions(d);
+      FFT<1> fft;
+      fft.setup(d);
+
+      serial.associate(mesh, fft, unitCell);
+      serial.allocate();
+      serial.clearUnitCellData();
+      parallel.associate(mesh, fft, unitCell);
+      parallel.allocate();
+      parallel.clearUnitCellData();
+
+      int nMonomer = serial.nMonomer();
+      TEST_ASSERT(parallel.nMonomer() == nMonomer);
+      TEST_ASSERT(parallel.nPolymer() == 2);
+      TEST_ASSERT(parallel.nSolvent() == 1);
+      DArray< RField<1> > wFields;
+      DArray< RField<1> > cFields;
+      DArray< RField<1> > cFieldsRef;
+      wFields.allocate(nMonomer);
+      cFields.allocate(nMonomer);
+      cFieldsRef.allocate(nMonomer);
+      int nx = mesh.size();
+      for (int i = 0; i < nMonomer; ++i) {
+         wFields[i].allocate(d);
+         cFields[i].allocate(d);
+         cFieldsRef[i].allocate(d);
+      }
+
+      double cs;
+      for (int i = 0; i < nx; ++i) {
+         cs = cos(2.0*Constants::Pi*double(i)/double(nx));
+         wFields[0][i] = 0.5 + cs;
+         wFields[1][i] = 0.5 - cs;
+         wFields[2][i] = 0.5 + 0.5*cs;
+      }
+
+      // Reference solution, solving species sequentially
+      serial.compute(wFields, cFieldsRef);
+      serial.computeStress();
+
+      // Solve again, solving species concurrently
+      parallel.compute(wFields, cFields);
+      parallel.computeStress();
+
+      for (int ip = 0; ip < 2; ++ip) {
+         TEST_ASSERT(eq(serial.polymer(ip).q(), parallel.polymer(ip).q()));
+      }
+      TEST_ASSERT(eq(serial.solvent(0).q(), parallel.solvent(0).q()));
+      for (int j = 0; j < nMonomer; ++j) {
+         for (int i = 0; i < nx; ++i) {
+            TEST_ASSERT(eq(cFields[j][i], cFieldsRef[j][i]));
+         }
+      }
+      TEST_ASSERT(eq(serial.stress(0), parallel.stress(0)));
+   }
+
+   void testSolver1DBlockDs()
+   {
+      printMethod(TEST_FUNC);
+      Mixture<1> mixture;
+
+      std::ifstream in;
+      openInputFile("in/MixtureBlockDs", in);
+      mixture.readParam(in);
+      UnitCell<1> unitCell;
+      in >> unitCell;
+      IntVec<1> d;
+      in >> d;
+      in.close();
+
+      Mesh<1> mesh;
+      mesh.setDimensions(d);
+      FFT<1> fft;
+      fft.setup(d);
+
+      mixture.associate(mesh, fft, unitCell);
+      mixture.allocate();
+      mixture.clearUnitCellData();
+
+      // Block 1 has blockDs = 0, and so uses the global ds
+      Polymer<1>& polymer = mixture.polymer(0);
+      TEST_ASSERT(polymer.block(0).ns() == 9);
+      TEST_ASSERT(eq(polymer.block(0).ds(), 0.05));
+      TEST_ASSERT(polymer.block(1).ns() == 61);
+      TEST_ASSERT(eq(polymer.block(1).ds(), 0.01));
+      TEST_ASSERT(polymer.block(2).ns() == 501);
+      TEST_ASSERT(eq(polymer.block(2).ds(), 0.002));
+
+      int nMonomer = mixture.nMonomer();
+      DArray< RField<1> > wFields;
+      DArray< RField<1> > cFields;
+      wFields.allocate(nMonomer);
+      cFields.allocate(nMonomer);
+      int nx = mesh.size();
+      for (int i = 0; i < nMonomer; ++i) {
+         wFields[i].allocate(d);
+         cFields[i].allocate(d);
+      }
+
+      double cs;
+      for (int i = 0; i < nx; ++i) {
+         cs = cos(2.0*Constants::Pi*double(i)/double(nx));
+         wFields[0][i] = 0.5 + cs;
+         wFields[1][i] = 0.5 - cs;
+      }
+
+      // The contour discretization is not changed by compute
+      TEST_ASSERT(eq(mixture.dsTolerance(), 1.0e-10));
+      mixture.compute(wFields, cFields);
+      mixture.compute(wFields, cFields);
+      TEST_ASSERT(polymer.block(0).ns() == 9);
+      TEST_ASSERT(polymer.block(1).ns() == 61);
+      TEST_ASSERT(polymer.block(2).ns() == 501);
+
+      // Explicit adaptation refines the coarse block
+      TEST_ASSERT(polymer.block(0).stepError() > 1.0e-10);
+      mixture.adaptContourSteps();
+      TEST_ASSERT(polymer.block(0).ns() > 9);
+      TEST_ASSERT(polymer.block(0).ds() < 0.05);
+      TEST_ASSERT(polymer.block(0).stepError() == 0.0);
+      mixture.compute(wFields, cFields);
+      TEST_ASSERT(eq(polymer.q(), polymer.propagator(0, 0).computeQ()));
+   }
+
+   void testSolver1DStarShared()
+   {
+      printMethod(TEST_FUNC);
+      Mixture<1> mixture;
+
+      std::ifstream in;
+      openInputFile("in/MixtureStar", in);
+      mixture.readParam(in);
+      UnitCell<1> unitCell;
+      in >> unitCell;
+      IntVec<1> d;
+      in >> d;
+      in.close();
+
+      Mesh<1> mesh;
+      mesh.setDimensions(d);
+      FFT<1> fft;
+      fft.setup(d);
+
+      mixture.associate(mesh, fft, unitCell);
+      mixture.allocate();
+      mixture.clearUnitCellData();
+
+      int nMonomer = mixture.nMonomer();
+      DArray< RField<1> > wFields;
+      DArray< RField<1> > cFields;
+      DArray< RField<1> > cFieldsRef;
+      wFields.allocate(nMonomer);
+      cFields.allocate(nMonomer);
+      cFieldsRef.allocate(nMonomer);
+      int nx = mesh.size();
+      for (int i = 0; i < nMonomer; ++i) {
+         wFields[i].allocate(d);
+         cFields[i].allocate(d);
+         cFieldsRef[i].allocate(d);
+      }
+
+      double cs;
+      for (int i = 0; i < nx; ++i) {
+         cs = cos(2.0*Constants::Pi*double(i)/double(nx));
+         wFields[0][i] = 0.5 + cs;
+         wFields[1][i] = 0.5 - cs;
+      }
+
+      // Reference solution, solving every propagator
+      Polymer<1>& polymer = mixture.polymer(0);
+      TEST_ASSERT(!polymer.shareIdentical());
+      mixture.compute(wFields, cFieldsRef);
+      mixture.computeStress();
+      double Q = polymer.q();
+      double stress = mixture.stress(0);
+
+      // Solve again, sharing the identical arm propagators
+      polymer.setShareIdentical(true);
+      mixture.compute(wFields, cFields);
+      mixture.computeStress();
+      TEST_ASSERT(eq(Q, polymer.q()));
+      TEST_ASSERT(eq(stress, mixture.stress(0)));
+
+      // Arms 1 and 2 are identical to arm 0, arm 3 is distinct
+      TEST_ASSERT(polymer.identicalBlockId(0) == 0);
+      TEST_ASSERT(polymer.identicalBlockId(1) == 0);
+      TEST_ASSERT(polymer.identicalBlockId(2) == 0);
+      TEST_ASSERT(polymer.identicalBlockId(3) == 3);
+      int nShared = 0;
+      for (int j = 0; j < polymer.nPropagator(); ++j) {
+         if (polymer.propagator(j).hasIdentical()) ++nShared;
+      }
+      TEST_ASSERT(nShared == 4);
+
+      for (int j = 0; j < nMonomer; ++j) {
+         for (int i = 0; i < nx; ++i) {
+            TEST_ASSERT(eq(cFields[j][i], cFieldsRef[j][i]));
+         }
+      }
+
+      // Disable sharing, and check that all propagators are solved
+      polymer.setShareIdentical(false);
+      mixture.compute(wFields, cFields);
+      for (int j = 0; j < polymer.nPropagator(); ++j) {
+         TEST_ASSERT(!polymer.propagator(j).hasIdentical());
+      }
+      TEST_ASSERT(eq(Q, polymer.q()));
+   }
+
+   void testSolver1DTriblockSymmetric()
+   {
+      printMethod(TEST_FUNC);
+      Mixture<1> mixture;
+
+      std::ifstream in;
+      openInputFile("in/MixtureTriblock", in);
+      mixture.readParam(in);
+      UnitCell<1> unitCell;
+      in >> unitCell;
+      IntVec<1> d;
+      in >> d;
+      in.close();
+
+      Mesh<1> mesh;
+      mesh.setDimensions(d);
+      FFT<1> fft;
+      fft.setup(d);
+
+      mixture.associate(mesh, fft, unitCell);
+      mixture.allocate();
+      mixture.clearUnitCellData();
+
+      int nMonomer = mixture.nMonomer();
+      DArray< RField<1> > wFields;
+      DArray< RField<1> > cFields;
+      DArray< RField<1> > cFieldsRef;
+      wFields.allocate(nMonomer);
+      cFields.allocate(nMonomer);
+      cFieldsRef.allocate(nMonomer);
+      int nx = mesh.size();
+      for (int i = 0; i < nMonomer; ++i) {
+         wFields[i].allocate(d);
+         cFields[i].allocate(d);
+         cFieldsRef[i].allocate(d);
+      }
+
+      double cs;
+      for (int i = 0; i < nx; ++i) {
+         cs = cos(2.0*Constants::Pi*double(i)/double(nx));
+         wFields[0][i] = 0.5 + cs;
+         wFields[1][i] = 0.5 - cs;
+      }
+
+      // Reference solution, solving every propagator
+      Polymer<1>& polymer = mixture.polymer(0);
+      mixture.compute(wFields, cFieldsRef);
+      mixture.computeStress();
+      double Q = polymer.q();
+      double stress = mixture.stress(0);
+
+      // Solve again, using the reversal symmetry of the ABA triblock
+      polymer.setShareIdentical(true);
+      mixture.compute(wFields, cFields);
+      mixture.computeStress();
+      TEST_ASSERT(eq(Q, polymer.q()));
+      TEST_ASSERT(eq(stress, mixture.stress(0)));
+
+      // End blocks are mirror images, and the two propagators of the
+      // middle block are identical, so half of all MDEs are skipped
+      TEST_ASSERT(polymer.identicalBlockId(0) == 0);
+      TEST_ASSERT(polymer.identicalBlockId(1) == 1);
+      TEST_ASSERT(polymer.identicalBlockId(2) == 0);
+      TEST_ASSERT(polymer.propagator(1, 0).hasIdentical() 
+                  != polymer.propagator(1, 1).hasIdentical());
+      int nShared = 0;
+      for (int j = 0; j < polymer.nPropagator(); ++j) {
+         if (polymer.propagator(j).hasIdentical()) ++nShared;
+      }
+      TEST_ASSERT(nShared == 3);
+
+      for (int j = 0; j < nMonomer; ++j) {
+         for (int i = 0; i < nx; ++i) {
+            TEST_ASSERT(eq(cFields[j][i], cFieldsRef[j][i]));
+         }
+      }
+   }
+
+   void testSolver1DTriblockExpCache()
+   {
+      printMethod(TEST_FUNC);
+      Mixture<1> mixture;
+
+      std::ifstream in;
+      openInputFile("in/MixtureTriblock", in);
+      mixture.readParam(in);
+      UnitCell<1> unitCell;
+      in >> unitCell;
+      IntVec<1> d;
+      in >> d;
+      in.close();
+
+      Mesh<1> mesh;
+      mesh.setDimensions(d);
+      FFT<1> fft;
+      fft.setup(d);
+
+      mixture.associate(mesh, fft, unitCell);
+      mixture.allocate();
+      mixture.clearUnitCellData();
+
+      int nMonomer = mixture.nMonomer();
+      DArray< RField<1> > wFields;
+      DArray< RField<1> > cFields;
+      wFields.allocate(nMonomer);
+      cFields.allocate(nMonomer);
+      int nx = mesh.size();
+      for (int i = 0; i < nMonomer; ++i) {
+         wFields[i].allocate(d);
+         cFields[i].allocate(d);
+      }
+
+      double cs;
+      for (int i = 0; i < nx; ++i) {
+         cs = cos(2.0*Constants::Pi*double(i)/double(nx));
+         wFields[0][i] = 0.5 + cs;
+         wFields[1][i] = 0.5 - cs;
+      }
+
+      // Reference solution, in which every block computes its own arrays
+      Polymer<1>& polymer = mixture.polymer(0);
+      polymer.compute(wFields);
+      double Q = polymer.q();
+      DArray< RField<1> > cBlockRef;
+      cBlockRef.allocate(polymer.nBlock());
+      for (int j = 0; j < polymer.nBlock(); ++j) {
+         cBlockRef[j] = polymer.block(j).cField();
+      }
+
+      // End blocks share expW arrays, and all blocks share expKsq arrays
+      mixture.compute(wFields, cFields);
+      ExpCache<1> const & cache = mixture.expCache();
+      TEST_ASSERT(cache.nExpW() == 2);
+      TEST_ASSERT(cache.nExpKsq() == 1);
+      TEST_ASSERT(eq(Q, polymer.q()));
+      for (int j = 0; j < polymer.nBlock(); ++j) {
+         for (int i = 0; i < nx; ++i) {
+            TEST_ASSERT(eq(polymer.block(j).cField()[i], cBlockRef[j][i]));
+         }
+      }
+
+      // Changing the kuhn length of monomer 1 adds an expKsq entry
+      mixture.setKuhn(1, 1.5);
+      polymer.compute(wFields);
+      Q = polymer.q();
+      mixture.compute(wFields, cFields);
+      TEST_ASSERT(cache.nExpW() == 2);
+      TEST_ASSERT(cache.nExpKsq() == 2);
+      TEST_ASSERT(eq(Q, polymer.q()));
+   }
+
    void testSolver2D()
    {
       printMethod(TEST_FUNC);
@@ -503,6 +953,12 @@ TEST_ADD(MixtureTest, testConstructor1D)
 TEST_ADD(MixtureTest, testReadParameters1D)
 TEST_ADD(MixtureTest, testReadParameters1DBranched)
 TEST_ADD(MixtureTest, testSolver1D)
+TEST_ADD(MixtureTest, testSolver1DBranchedParallel)
+TEST_ADD(MixtureTest, testSolver1DParallelSpecies)
+TEST_ADD(MixtureTest, testSolver1DBlockDs)
+TEST_ADD(MixtureTest, testSolver1DStarShared)
+TEST_ADD(MixtureTest, testSolver1DTriblockSymmetric)
+TEST_ADD(MixtureTest, testSolver1DTriblockExpCache)
 TEST_ADD(MixtureTest, testSolver2D)
 TEST_ADD(MixtureTest, testSolver2D_hex)
 TEST_ADD(MixtureTest, testSolver3D)
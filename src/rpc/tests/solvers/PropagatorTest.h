@@ -5,6 +5,11 @@
 #include <test/UnitTestRunner.h>
 
 #include <rpc/solvers/Block.h>
+#include <rpc/solvers/WaveList.h>
+#include <rpc/solvers/StepAlgorithm.h>
+#include <prdc/cpu/FFTMirror.h>
+#include <prdc/crystal/MeshOrbits.h>
+#include <prdc/crystal/SpaceGroup.h>
 
 #include <prdc/crystal/UnitCell.h>
 
@@ -88,7 +93,11 @@ public:
       setupUnitCell<1>(unitCell, "in/Lamellar");
 
       double ds = 0.02;
-      block.associate(mesh, fft, unitCell);
+      // Create wavelist
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      block.associate(mesh, fft, unitCell, wavelist);
       block.allocate(ds);
 
       TEST_ASSERT(eq(block.length(), 2.0));
@@ -115,7 +124,11 @@ public:
       UnitCell<2> unitCell;
       setupUnitCell<2>(unitCell, "in/Rectangular");
 
-      block.associate(mesh, fft, unitCell);
+      // Create wavelist
+      WaveList<2> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      block.associate(mesh, fft, unitCell, wavelist);
 
       double ds = 0.26;
       block.allocate(ds);
@@ -144,8 +157,12 @@ public:
       UnitCell<3> unitCell;
       setupUnitCell<3>(unitCell, "in/Hexagonal");
 
+      // Create wavelist
+      WaveList<3> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
       // Associate block
-      block.associate(mesh, fft, unitCell);
+      block.associate(mesh, fft, unitCell, wavelist);
 
       // Allocate block
       double ds = 0.3;
@@ -177,7 +194,11 @@ public:
       setupUnitCell<1>(unitCell, "in/Lamellar");
 
       double ds = 0.02;
-      block.associate(mesh, fft, unitCell);
+      // Create wavelist
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      block.associate(mesh, fft, unitCell, wavelist);
       block.allocate(ds);
 
       TEST_ASSERT(eq(unitCell.rBasis(0)[0], 4.0));
@@ -212,7 +233,11 @@ public:
       setupUnitCell<2>(unitCell, "in/Rectangular");
 
       double ds = 0.02;
-      block.associate(mesh, fft, unitCell);
+      // Create wavelist
+      WaveList<2> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      block.associate(mesh, fft, unitCell, wavelist);
       block.allocate(ds);
 
       TEST_ASSERT(eq(unitCell.rBasis(0)[0], 3.0));
@@ -249,7 +274,11 @@ public:
       setupUnitCell<3>(unitCell, "in/Orthorhombic");
 
       double ds = 0.02;
-      block.associate(mesh, fft, unitCell);
+      // Create wavelist
+      WaveList<3> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      block.associate(mesh, fft, unitCell, wavelist);
       block.allocate(ds);
 
       TEST_ASSERT(eq(unitCell.rBasis(0)[0], 3.0));
@@ -286,7 +315,11 @@ public:
       setupUnitCell<1>(unitCell, "in/Lamellar");
 
       double ds = 0.02;
-      block.associate(mesh, fft, unitCell);
+      // Create wavelist
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      block.associate(mesh, fft, unitCell, wavelist);
       block.allocate(ds);
 
       // Setup chemical potential field
@@ -358,7 +391,11 @@ public:
       setupUnitCell<2>(unitCell, "in/Rectangular");
 
       double ds = 0.02;
-      block.associate(mesh, fft, unitCell);
+      // Create wavelist
+      WaveList<2> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      block.associate(mesh, fft, unitCell, wavelist);
       block.allocate(ds);
 
       TEST_ASSERT(eq(unitCell.rBasis(0)[0], 3.0));
@@ -444,7 +481,11 @@ public:
       setupUnitCell<3>(unitCell, "in/Orthorhombic");
 
       double ds = 0.02;
-      block.associate(mesh, fft, unitCell);
+      // Create wavelist
+      WaveList<3> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      block.associate(mesh, fft, unitCell, wavelist);
       block.allocate(ds);
 
       TEST_ASSERT(eq(unitCell.rBasis(0)[0], 3.0));
@@ -512,6 +553,548 @@ public:
       }
    }
 
+   void testCheckpoints1D()
+   {
+      printMethod(TEST_FUNC);
+
+      // Create and initialize mesh, fft and unit cell
+      Mesh<1> mesh;
+      setupMesh<1>(mesh);
+      FFT<1> fft;
+      fft.setup(mesh.dimensions());
+      UnitCell<1> unitCell;
+      setupUnitCell<1>(unitCell, "in/Lamellar");
+
+      // Create two blocks, with and without checkpoints
+      double ds = 0.02;
+      Block<1> block;
+      setupBlock<1>(block);
+      // Create wavelist
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      block.associate(mesh, fft, unitCell, wavelist);
+      block.allocate(ds);
+      Block<1> blockCp;
+      setupBlock<1>(blockCp);
+      blockCp.associate(mesh, fft, unitCell, wavelist);
+      blockCp.allocate(ds, true);
+      TEST_ASSERT(!block.propagator(0).useCheckpoints());
+      TEST_ASSERT(blockCp.propagator(0).useCheckpoints());
+      TEST_ASSERT(block.ns() == blockCp.ns());
+      int ns = block.ns();
+
+      // Setup inhomogeneous chemical potential field
+      RField<1> w;
+      w.allocate(mesh.dimensions());
+      int nx = mesh.size();
+      double twoPi = 2.0*Constants::Pi;
+      for (int i=0; i < nx; ++i) {
+         w[i] = 0.5*cos(twoPi*double(i)/double(nx));
+      }
+      block.clearUnitCellData();
+      block.setupSolver(w);
+      blockCp.clearUnitCellData();
+      blockCp.setupSolver(w);
+
+      // Solve both propagators of both blocks
+      for (int j = 0; j < 2; ++j) {
+         block.propagator(j).solve();
+         blockCp.propagator(j).solve();
+      }
+
+      // Compare all slices, in increasing and decreasing order
+      for (int j = 0; j < ns; ++j) {
+         RField<1> const & q = block.propagator(0).q(j);
+         RField<1> const & qCp = blockCp.propagator(0).q(j);
+         for (int i = 0; i < nx; ++i) {
+            TEST_ASSERT(eq(q[i], qCp[i]));
+         }
+      }
+      for (int j = ns - 1; j >= 0; --j) {
+         RField<1> const & q = block.propagator(1).q(j);
+         RField<1> const & qCp = blockCp.propagator(1).q(j);
+         for (int i = 0; i < nx; ++i) {
+            TEST_ASSERT(eq(q[i], qCp[i]));
+         }
+      }
+
+      // Compare block concentrations
+      block.computeConcentration(1.0);
+      blockCp.computeConcentration(1.0);
+      for (int i = 0; i < nx; ++i) {
+         TEST_ASSERT(eq(block.cField()[i], blockCp.cField()[i]));
+      }
+
+   }
+
+   void testFloatQ1D()
+   {
+      printMethod(TEST_FUNC);
+
+      // Create and initialize mesh, fft and unit cell
+      Mesh<1> mesh;
+      setupMesh<1>(mesh);
+      FFT<1> fft;
+      fft.setup(mesh.dimensions());
+      UnitCell<1> unitCell;
+      setupUnitCell<1>(unitCell, "in/Lamellar");
+
+      // Create two blocks, with double and float slice storage
+      double ds = 0.02;
+      Block<1> block;
+      setupBlock<1>(block);
+      // Create wavelist
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      block.associate(mesh, fft, unitCell, wavelist);
+      block.allocate(ds);
+      Block<1> blockF;
+      setupBlock<1>(blockF);
+      blockF.associate(mesh, fft, unitCell, wavelist);
+      blockF.allocate(ds, false, true);
+      TEST_ASSERT(!block.propagator(0).useFloat());
+      TEST_ASSERT(blockF.propagator(0).useFloat());
+      int ns = block.ns();
+
+      // Setup inhomogeneous chemical potential field
+      RField<1> w;
+      w.allocate(mesh.dimensions());
+      int nx = mesh.size();
+      double twoPi = 2.0*Constants::Pi;
+      for (int i=0; i < nx; ++i) {
+         w[i] = 0.5*cos(twoPi*double(i)/double(nx));
+      }
+      block.clearUnitCellData();
+      block.setupSolver(w);
+      blockF.clearUnitCellData();
+      blockF.setupSolver(w);
+
+      // Solve both propagators of both blocks
+      for (int j = 0; j < 2; ++j) {
+         block.propagator(j).solve();
+         blockF.propagator(j).solve();
+      }
+
+      // Head and tail are stored in double precision
+      for (int i = 0; i < nx; ++i) {
+         TEST_ASSERT(eq(block.propagator(0).tail()[i], 
+                        blockF.propagator(0).tail()[i]));
+      }
+
+      // Accuracy of interior slices 
+      double err, maxErr = 0.0;
+      for (int j = 0; j < ns; ++j) {
+         RField<1> const & q = block.propagator(0).q(j);
+         RField<1> const & qF = blockF.propagator(0).q(j);
+         for (int i = 0; i < nx; ++i) {
+            err = std::abs(q[i] - qF[i])/std::abs(q[i]);
+            if (err > maxErr) maxErr = err;
+         }
+      }
+      TEST_ASSERT(maxErr < 1.0E-6);
+
+      // Accuracy of block concentration
+      block.computeConcentration(1.0);
+      blockF.computeConcentration(1.0);
+      double cErr = 0.0;
+      for (int i = 0; i < nx; ++i) {
+         err = std::abs(block.cField()[i] - blockF.cField()[i]);
+         err /= std::abs(block.cField()[i]);
+         if (err > cErr) cErr = err;
+      }
+      TEST_ASSERT(cErr < 1.0E-6);
+
+      // Accuracy of stress
+      block.computeStress(1.0);
+      blockF.computeStress(1.0);
+      double sErr = std::abs(block.stress(0) - blockF.stress(0));
+      TEST_ASSERT(sErr < 1.0E-6*std::abs(block.stress(0)) + 1.0E-10);
+
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         std::cout << "Max relative error in q      = " << maxErr << std::endl;
+         std::cout << "Max relative error in c      = " << cErr << std::endl;
+         std::cout << "Absolute error in stress     = " << sErr << std::endl;
+      }
+
+   }
+
+   void testStepError1D()
+   {
+      printMethod(TEST_FUNC);
+
+      // Create and initialize mesh, fft, unit cell and wavelist
+      Mesh<1> mesh;
+      setupMesh<1>(mesh);
+      FFT<1> fft;
+      fft.setup(mesh.dimensions());
+      UnitCell<1> unitCell;
+      setupUnitCell<1>(unitCell, "in/Lamellar");
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      Block<1> block;
+      setupBlock<1>(block);
+      block.associate(mesh, fft, unitCell, wavelist);
+      block.setEstimateStepError(true);
+      block.allocate(0.2);
+      int ns = block.ns();
+
+      // Setup inhomogeneous chemical potential field
+      RField<1> w;
+      w.allocate(mesh.dimensions());
+      int nx = mesh.size();
+      double twoPi = 2.0*Constants::Pi;
+      for (int i=0; i < nx; ++i) {
+         w[i] = 2.0*cos(twoPi*double(i)/double(nx));
+      }
+
+      // Solve with initial step size
+      block.setupSolver(w);
+      block.propagator(0).solve();
+      double error1 = block.stepError();
+      TEST_ASSERT(error1 > 0.0);
+
+      // Halve the step size: error estimate should scale as ds^3
+      block.setDs(0.1);
+      TEST_ASSERT(block.ns() == 2*ns - 1);
+      TEST_ASSERT(eq(block.dsTarget(), 0.1));
+      block.clearStepError();
+      TEST_ASSERT(block.stepError() == 0.0);
+      block.setupSolver(w);
+      block.propagator(0).solve();
+      double error2 = block.stepError();
+      TEST_ASSERT(error2 > 0.0);
+      TEST_ASSERT(error2 < 0.25*error1);
+   }
+
+   void testStepAlgorithm1D()
+   {
+      printMethod(TEST_FUNC);
+
+      TEST_ASSERT(StepAlgorithm::order(StepAlgorithm::RQM4) == 4);
+      TEST_ASSERT(StepAlgorithm::order(StepAlgorithm::RQM6) == 6);
+
+      // Create and initialize mesh, fft, unit cell and wavelist
+      Mesh<1> mesh;
+      setupMesh<1>(mesh);
+      FFT<1> fft;
+      fft.setup(mesh.dimensions());
+      UnitCell<1> unitCell;
+      setupUnitCell<1>(unitCell, "in/Lamellar");
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      // Create coarse blocks (RQM4 and RQM6) and a fine reference block
+      double ds = 0.25;
+      Block<1> block4;
+      setupBlock<1>(block4);
+      block4.associate(mesh, fft, unitCell, wavelist);
+      block4.allocate(ds);
+      Block<1> block6;
+      setupBlock<1>(block6);
+      block6.setStepAlgorithm(StepAlgorithm::RQM6);
+      block6.associate(mesh, fft, unitCell, wavelist);
+      block6.allocate(ds);
+      Block<1> blockRef;
+      setupBlock<1>(blockRef);
+      blockRef.setStepAlgorithm(StepAlgorithm::RQM6);
+      blockRef.associate(mesh, fft, unitCell, wavelist);
+      blockRef.allocate(0.1*ds);
+      TEST_ASSERT(block6.stepAlgorithm() == StepAlgorithm::RQM6);
+      TEST_ASSERT(block4.ns() == block6.ns());
+
+      // Setup strongly inhomogeneous chemical potential field
+      RField<1> w;
+      w.allocate(mesh.dimensions());
+      int nx = mesh.size();
+      double twoPi = 2.0*Constants::Pi;
+      for (int i=0; i < nx; ++i) {
+         w[i] = 2.0*cos(twoPi*double(i)/double(nx));
+      }
+      block4.setupSolver(w);
+      block6.setupSolver(w);
+      blockRef.setupSolver(w);
+      block4.propagator(0).solve();
+      block6.propagator(0).solve();
+      blockRef.propagator(0).solve();
+
+      // Compare tail slices to the reference solution
+      RField<1> const & q4 = block4.propagator(0).tail();
+      RField<1> const & q6 = block6.propagator(0).tail();
+      RField<1> const & qRef = blockRef.propagator(0).tail();
+      double error4 = 0.0;
+      double error6 = 0.0;
+      double diff;
+      for (int i = 0; i < nx; ++i) {
+         diff = std::abs(q4[i] - qRef[i]);
+         if (diff > error4) error4 = diff;
+         diff = std::abs(q6[i] - qRef[i]);
+         if (diff > error6) error6 = diff;
+      }
+      TEST_ASSERT(error4 > 0.0);
+      TEST_ASSERT(error6 < error4);
+   }
+
+   void testMirrorStep1D()
+   {
+      printMethod(TEST_FUNC);
+
+      // Create and initialize mesh, fft, unit cell and wavelist
+      Mesh<1> mesh;
+      setupMesh<1>(mesh);
+      FFT<1> fft;
+      fft.setup(mesh.dimensions());
+      FFTMirror<1> fftMirror;
+      fftMirror.setup(mesh.dimensions());
+      UnitCell<1> unitCell;
+      setupUnitCell<1>(unitCell, "in/Lamellar");
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+
+      // Create full grid and reduced grid blocks
+      double ds = 0.02;
+      Block<1> block;
+      setupBlock<1>(block);
+      block.associate(mesh, fft, unitCell, wavelist);
+      block.allocate(ds);
+      block.setEstimateStepError(true);
+      Block<1> blockMirror;
+      setupBlock<1>(blockMirror);
+      blockMirror.associate(mesh, fft, unitCell, wavelist);
+      blockMirror.allocate(ds);
+      blockMirror.setEstimateStepError(true);
+      blockMirror.setMirrorFFT(&fftMirror);
+
+      // Setup a chemical potential field that is even about x = 0
+      RField<1> w;
+      w.allocate(mesh.dimensions());
+      int nx = mesh.size();
+      double twoPi = 2.0*Constants::Pi;
+      for (int i=0; i < nx; ++i) {
+         w[i] = cos(twoPi*double(i)/double(nx))
+              + 0.5*cos(2.0*twoPi*double(i)/double(nx));
+      }
+      block.setupSolver(w);
+      blockMirror.setupSolver(w);
+      block.propagator(0).solve();
+      blockMirror.propagator(0).solve();
+
+      // Results on full and reduced grids should agree to round-off
+      RField<1> const & q = block.propagator(0).tail();
+      RField<1> const & qMirror = blockMirror.propagator(0).tail();
+      for (int i = 0; i < nx; ++i) {
+         TEST_ASSERT(std::abs(q[i] - qMirror[i]) < 1.0E-10);
+      }
+      TEST_ASSERT(std::abs(block.stepError() - blockMirror.stepError())
+                  < 1.0E-10);
+   }
+
+   void testFusedConcentration1D()
+   {
+      printMethod(TEST_FUNC);
+
+      // Create and initialize mesh, fft and unit cell
+      Mesh<1> mesh;
+      setupMesh<1>(mesh);
+      FFT<1> fft;
+      fft.setup(mesh.dimensions());
+      UnitCell<1> unitCell;
+      setupUnitCell<1>(unitCell, "in/Lamellar");
+
+      // Create two blocks, with separate and fused concentration
+      double ds = 0.02;
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+      Block<1> block;
+      setupBlock<1>(block);
+      block.associate(mesh, fft, unitCell, wavelist);
+      block.allocate(ds);
+      Block<1> blockFu;
+      setupBlock<1>(blockFu);
+      blockFu.associate(mesh, fft, unitCell, wavelist);
+      blockFu.setFuseConcentration(true, 1);
+      blockFu.allocate(ds);
+      TEST_ASSERT(blockFu.fuseConcentration());
+      TEST_ASSERT(!blockFu.propagator(0).useCheckpoints());
+      TEST_ASSERT(blockFu.propagator(1).useCheckpoints());
+
+      // Setup inhomogeneous chemical potential field
+      RField<1> w;
+      w.allocate(mesh.dimensions());
+      int nx = mesh.size();
+      double twoPi = 2.0*Constants::Pi;
+      for (int i=0; i < nx; ++i) {
+         w[i] = 0.5*cos(twoPi*double(i)/double(nx));
+      }
+      block.clearUnitCellData();
+      block.setupSolver(w);
+      blockFu.clearUnitCellData();
+      blockFu.setupSolver(w);
+
+      // Solve both propagators of both blocks, in order 0, 1
+      for (int j = 0; j < 2; ++j) {
+         block.propagator(j).solve();
+         blockFu.propagator(j).solve();
+      }
+
+      // Compare block concentrations
+      block.computeConcentration(1.0);
+      blockFu.computeConcentration(1.0);
+      for (int i = 0; i < nx; ++i) {
+         TEST_ASSERT(eq(block.cField()[i], blockFu.cField()[i]));
+      }
+
+      // Compare stress (slices of propagator 1 are recomputed)
+      block.computeStress(1.0);
+      blockFu.computeStress(1.0);
+      TEST_ASSERT(eq(block.stress(0), blockFu.stress(0)));
+   }
+
+   void testOrbitStorage1D()
+   {
+      printMethod(TEST_FUNC);
+
+      // Create and initialize mesh, fft and unit cell
+      Mesh<1> mesh;
+      setupMesh<1>(mesh);
+      FFT<1> fft;
+      fft.setup(mesh.dimensions());
+      UnitCell<1> unitCell;
+      setupUnitCell<1>(unitCell, "in/Lamellar");
+
+      // Centrosymmetric 1D group, and orbits of mesh nodes
+      SpaceGroup<1> group;
+      SpaceSymmetry<1> inversion;
+      inversion.R(0,0) = -1;
+      inversion.t(0) = 0;
+      group.add(inversion);
+      group.makeCompleteGroup();
+      TEST_ASSERT(group.size() == 2);
+      MeshOrbits<1> orbits;
+      orbits.makeOrbits(mesh, group);
+      TEST_ASSERT(orbits.nOrbit() == mesh.size()/2 + 1);
+
+      // Create blocks with full and asymmetric unit storage
+      double ds = 0.02;
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+      Block<1> block;
+      setupBlock<1>(block);
+      block.associate(mesh, fft, unitCell, wavelist);
+      block.allocate(ds);
+      Block<1> blockOrb;
+      setupBlock<1>(blockOrb);
+      blockOrb.associate(mesh, fft, unitCell, wavelist);
+      blockOrb.setMeshOrbits(&orbits);
+      blockOrb.allocate(ds);
+      TEST_ASSERT(blockOrb.propagator(0).useOrbits());
+      TEST_ASSERT(blockOrb.propagator(1).useOrbits());
+
+      // Setup symmetric chemical potential field
+      RField<1> w;
+      w.allocate(mesh.dimensions());
+      int nx = mesh.size();
+      double twoPi = 2.0*Constants::Pi;
+      for (int i=0; i < nx; ++i) {
+         w[i] = 0.5*cos(twoPi*double(i)/double(nx));
+      }
+      block.setupSolver(w);
+      blockOrb.setupSolver(w);
+      for (int j = 0; j < 2; ++j) {
+         block.propagator(j).solve();
+         blockOrb.propagator(j).solve();
+      }
+
+      // Compare an interior slice, expanded to the full mesh
+      int k = block.ns()/2;
+      RField<1> const & q = block.propagator(0).q(k);
+      RField<1> const & qOrb = blockOrb.propagator(0).q(k);
+      for (int i = 0; i < nx; ++i) {
+         TEST_ASSERT(eq(q[i], qOrb[i]));
+      }
+
+      // Compare block concentrations and stress
+      block.computeConcentration(1.0);
+      blockOrb.computeConcentration(1.0);
+      for (int i = 0; i < nx; ++i) {
+         TEST_ASSERT(eq(block.cField()[i], blockOrb.cField()[i]));
+      }
+      block.computeStress(1.0);
+      blockOrb.computeStress(1.0);
+      TEST_ASSERT(eq(block.stress(0), blockOrb.stress(0)));
+   }
+
+   void testOrbitStorageIdentical1D()
+   {
+      printMethod(TEST_FUNC);
+
+      // Create and initialize mesh, fft and unit cell
+      Mesh<1> mesh;
+      setupMesh<1>(mesh);
+      FFT<1> fft;
+      fft.setup(mesh.dimensions());
+      UnitCell<1> unitCell;
+      setupUnitCell<1>(unitCell, "in/Lamellar");
+
+      // Centrosymmetric 1D group, and orbits of mesh nodes
+      SpaceGroup<1> group;
+      SpaceSymmetry<1> inversion;
+      inversion.R(0,0) = -1;
+      inversion.t(0) = 0;
+      group.add(inversion);
+      group.makeCompleteGroup();
+      MeshOrbits<1> orbits;
+      orbits.makeOrbits(mesh, group);
+
+      // Homopolymer blocks with full and asymmetric unit storage
+      double ds = 0.02;
+      WaveList<1> wavelist;
+      wavelist.allocate(mesh, unitCell);
+      Block<1> block;
+      setupBlock<1>(block);
+      block.associate(mesh, fft, unitCell, wavelist);
+      block.allocate(ds);
+      Block<1> blockOrb;
+      setupBlock<1>(blockOrb);
+      blockOrb.associate(mesh, fft, unitCell, wavelist);
+      blockOrb.setMeshOrbits(&orbits);
+      blockOrb.allocate(ds);
+
+      // Setup symmetric chemical potential field
+      RField<1> w;
+      w.allocate(mesh.dimensions());
+      int nx = mesh.size();
+      double twoPi = 2.0*Constants::Pi;
+      for (int i=0; i < nx; ++i) {
+         w[i] = 0.5*cos(twoPi*double(i)/double(nx));
+      }
+      block.setupSolver(w);
+      blockOrb.setupSolver(w);
+
+      // Solve both propagators of block. For blockOrb, solve only 
+      // propagator 0, and share it with propagator 1 (as for the 
+      // identical propagators of a homopolymer).
+      block.propagator(0).solve();
+      block.propagator(1).solve();
+      blockOrb.propagator(0).solve();
+      blockOrb.propagator(1).setIdentical(&blockOrb.propagator(0));
+      blockOrb.propagator(1).setIsSolved(true);
+      TEST_ASSERT(blockOrb.propagator(1).hasIdentical());
+
+      // Compare block concentrations and stress
+      block.computeConcentration(1.0);
+      blockOrb.computeConcentration(1.0);
+      for (int i = 0; i < nx; ++i) {
+         TEST_ASSERT(eq(block.cField()[i], blockOrb.cField()[i]));
+      }
+      block.computeStress(1.0);
+      blockOrb.computeStress(1.0);
+      TEST_ASSERT(eq(block.stress(0), blockOrb.stress(0)));
+   }
+
 };
 
 TEST_BEGIN(PropagatorTest)
@@ -524,6 +1107,14 @@ TEST_ADD(PropagatorTest, testSetupSolver3D)
 TEST_ADD(PropagatorTest, testSolver1D)
 TEST_ADD(PropagatorTest, testSolver2D)
 TEST_ADD(PropagatorTest, testSolver3D)
+TEST_ADD(PropagatorTest, testCheckpoints1D)
+TEST_ADD(PropagatorTest, testFloatQ1D)
+TEST_ADD(PropagatorTest, testFusedConcentration1D)
+TEST_ADD(PropagatorTest, testStepAlgorithm1D)
+TEST_ADD(PropagatorTest, testStepError1D)
+TEST_ADD(PropagatorTest, testMirrorStep1D)
+TEST_ADD(PropagatorTest, testOrbitStorage1D)
+TEST_ADD(PropagatorTest, testOrbitStorageIdentical1D)
 TEST_END(PropagatorTest)
 
 #endif
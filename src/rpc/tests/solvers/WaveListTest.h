@@ -0,0 +1,144 @@
+#ifndef RPC_WAVE_LIST_TEST_H
+#define RPC_WAVE_LIST_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <rpc/solvers/WaveList.h>
+#include <prdc/crystal/shiftToMinimum.h>
+#include <prdc/crystal/UnitCell.h>
+#include <pscf/mesh/Mesh.h>
+#include <pscf/mesh/MeshIterator.h>
+
+#include <fstream>
+
+using namespace Util;
+using namespace Pscf;
+using namespace Pscf::Prdc;
+using namespace Pscf::Rpc;
+
+class WaveListTest : public UnitTest
+{
+
+private:
+
+   Mesh<2> mesh2;
+   Mesh<3> mesh3;
+
+   UnitCell<2> cell2;
+   UnitCell<3> cell3;
+
+public:
+
+   void setUp()
+   {
+      IntVec<2> meshDims2;
+      meshDims2[0] = 32;
+      meshDims2[1] = 48;
+      mesh2.setDimensions(meshDims2);
+
+      IntVec<3> meshDims3;
+      meshDims3[0] = 24;
+      meshDims3[1] = 24;
+      meshDims3[2] = 21;
+      mesh3.setDimensions(meshDims3);
+
+      std::ifstream in2, in3;
+      openInputFile("in/Rectangular", in2);
+      in2 >> cell2;
+      in2.close();
+
+      openInputFile("in/Hexagonal", in3);
+      in3 >> cell3;
+      in3.close();
+   }
+
+   void tearDown()
+   {}
+
+   void testAllocate()
+   {
+      printMethod(TEST_FUNC);
+
+      WaveList<2> wavelist2;
+      wavelist2.allocate(mesh2, cell2);
+      TEST_ASSERT(wavelist2.isAllocated());
+      TEST_ASSERT(!wavelist2.hasMinimumImages());
+      TEST_ASSERT(!wavelist2.hasVariableAngle());
+      TEST_ASSERT(wavelist2.kSize() == 32*25);
+
+      WaveList<3> wavelist3;
+      wavelist3.allocate(mesh3, cell3);
+      TEST_ASSERT(wavelist3.isAllocated());
+      TEST_ASSERT(!wavelist3.hasVariableAngle());
+      TEST_ASSERT(wavelist3.kSize() == 24*24*11);
+   }
+
+   void testComputeKSq2D()
+   {
+      printMethod(TEST_FUNC);
+
+      WaveList<2> wavelist;
+      wavelist.allocate(mesh2, cell2);
+      wavelist.computeKSq();
+      TEST_ASSERT(wavelist.hasMinimumImages());
+      TEST_ASSERT(wavelist.hasKSq());
+
+      // Compare to values computed directly for each wavevector
+      IntVec<2> G, Gmin;
+      MeshIterator<2> iter(wavelist.kMeshDimensions());
+      for (iter.begin(); !iter.atEnd(); ++iter) {
+         G = iter.position();
+         Gmin = shiftToMinimum(G, mesh2.dimensions(), cell2);
+         TEST_ASSERT(Gmin == wavelist.minImages()[iter.rank()]);
+         TEST_ASSERT(eq(cell2.ksq(Gmin), wavelist.kSq()[iter.rank()]));
+      }
+
+      // Clearing unit cell data invalidates kSq but not minimum images
+      wavelist.clearUnitCellData();
+      TEST_ASSERT(!wavelist.hasKSq());
+      TEST_ASSERT(!wavelist.hasdKSq());
+      TEST_ASSERT(wavelist.hasMinimumImages());
+   }
+
+   void testComputedKSq3D()
+   {
+      printMethod(TEST_FUNC);
+
+      WaveList<3> wavelist;
+      wavelist.allocate(mesh3, cell3);
+      wavelist.computedKSq();
+      TEST_ASSERT(wavelist.hasdKSq());
+
+      // Compare to values computed directly for each wavevector,
+      // with a factor of 2 for waves with an implicit inverse
+      int nParams = cell3.nParameter();
+      IntVec<3> G, Gmin;
+      IntVec<3> kMeshDims = wavelist.kMeshDimensions();
+      MeshIterator<3> iter(kMeshDims);
+      double dksq;
+      int inverse;
+      for (int n = 0; n < nParams; ++n) {
+         for (iter.begin(); !iter.atEnd(); ++iter) {
+            G = iter.position();
+            Gmin = shiftToMinimum(G, mesh3.dimensions(), cell3);
+            dksq = cell3.dksq(Gmin, n);
+            inverse = (G[2] == 0) ? 0 : mesh3.dimension(2) - G[2];
+            if (inverse > kMeshDims[2]) {
+               dksq *= 2.0;
+               TEST_ASSERT(wavelist.implicitInverse()[iter.rank()]);
+            }
+            TEST_ASSERT(eq(dksq, wavelist.dKSq(n)[iter.rank()]));
+         }
+      }
+   }
+
+};
+
+TEST_BEGIN(WaveListTest)
+TEST_ADD(WaveListTest, testAllocate)
+TEST_ADD(WaveListTest, testComputeKSq2D)
+TEST_ADD(WaveListTest, testComputedKSq3D)
+TEST_END(WaveListTest)
+
+#endif
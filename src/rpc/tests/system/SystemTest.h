@@ -553,6 +553,165 @@ public:
 
    }
 
+   void testIterate1D_lam_rigid_lr()
+   {
+      printMethod(TEST_FUNC);
+
+      System<1> system;
+      system.fileMaster().setInputPrefix(filePrefix());
+      system.fileMaster().setOutputPrefix(filePrefix());
+      openLogFile("out/testIterate1D_lam_rigid_lr.log");
+
+      std::ifstream in;
+      openInputFile("in/diblock/lam/param.rigid_lr", in);
+      system.readParam(in);
+      in.close();
+      TEST_ASSERT(system.iterator().isSymmetric());
+
+      // Iterate from initial guess
+      system.readWBasis("in/diblock/lam/omega.in");
+      int error = system.iterate();
+      if (error) {
+         TEST_THROW("Iterator failed to converge.");
+      }
+      system.writeWBasis("out/testIterate1D_lam_rigid_lr_w.bf");
+
+      // Compare to reference omega.ref
+      double wMaxDiff = readCompareWBasis(system, "in/diblock/lam/omega.ref");
+      TEST_ASSERT(wMaxDiff < 2.0E-7);
+
+      // Compare free energies to values used in testIterate1D_lam_rigid
+      double fHelmholtz = 2.42932542391e+00;
+      double pressure = 3.01212693885e+00;
+      compareFreeEnergies(system, fHelmholtz, pressure);
+      TEST_ASSERT(fHelmholtz < 1.0E-7);
+      TEST_ASSERT(pressure < 1.0E-7);
+   }
+
+   void testIterateCoarseToFine1D_lam()
+   {
+      printMethod(TEST_FUNC);
+
+      System<1> system;
+      system.fileMaster().setInputPrefix(filePrefix());
+      system.fileMaster().setOutputPrefix(filePrefix());
+      openLogFile("out/testIterateCoarseToFine1D_lam.log");
+
+      std::ifstream in;
+      openInputFile("in/diblock/lam/param.rigid", in);
+      system.readParam(in);
+      in.close();
+      TEST_ASSERT(system.domain().mesh().dimension(0) == 32);
+
+      // Iterate from initial guess, first on meshes of 8 and 16 points
+      system.readWBasis("in/diblock/lam/omega.in");
+      int error = system.iterateCoarseToFine(2);
+      if (error) {
+         TEST_THROW("Iterator failed to converge.");
+      }
+      TEST_ASSERT(system.domain().mesh().dimension(0) == 32);
+      system.writeWBasis("out/testIterateCoarseToFine1D_lam_w.bf");
+
+      // Compare to reference omega.ref
+      double wMaxDiff = readCompareWBasis(system, "in/diblock/lam/omega.ref");
+      TEST_ASSERT(wMaxDiff < 2.0E-7);
+
+      // Compare free energies to values used in testIterate1D_lam_rigid
+      double fHelmholtz = 2.42932542391e+00;
+      double pressure = 3.01212693885e+00;
+      compareFreeEnergies(system, fHelmholtz, pressure);
+      TEST_ASSERT(fHelmholtz < 1.0E-7);
+      TEST_ASSERT(pressure < 1.0E-7);
+   }
+
+   void testIterate1D_lam_rigid_grid()
+   {
+      printMethod(TEST_FUNC);
+
+      System<1> system;
+      system.fileMaster().setInputPrefix(filePrefix());
+      system.fileMaster().setOutputPrefix(filePrefix());
+      openLogFile("out/testIterate1D_lam_rigid_grid.log");
+
+      std::ifstream in;
+      openInputFile("in/diblock/lam/param.rigid_grid", in);
+      system.readParam(in);
+      in.close();
+      TEST_ASSERT(!system.iterator().isSymmetric());
+
+      // Read converged w fields, store reference values on the grid
+      system.readWBasis("in/diblock/lam/omega.ref");
+      DArray< RField<1> > wFieldsRGrid_check;
+      wFieldsRGrid_check = system.w().rgrid();
+
+      // Iterate and compare result to input
+      int error = system.iterate();
+      if (error) {
+         TEST_THROW("Iterator failed to converge.");
+      }
+      system.writeWRGrid("out/testIterate1D_lam_rigid_grid_w.rf");
+      TEST_ASSERT(!system.w().isSymmetric());
+
+      RFieldComparison<1> comparison;
+      comparison.compare(wFieldsRGrid_check, system.w().rgrid());
+      if (verbose() > 0) {
+         std::cout << "\n";
+         std::cout << "Max error = " << comparison.maxDiff();
+      }
+      TEST_ASSERT(comparison.maxDiff() < 2.0E-7);
+
+      // Compare free energies to values used in testIterate1D_lam_rigid
+      double fHelmholtz = 2.42932542391e+00;
+      double pressure = 3.01212693885e+00;
+      compareFreeEnergies(system, fHelmholtz, pressure);
+      TEST_ASSERT(fHelmholtz < 1.0E-7);
+      TEST_ASSERT(pressure < 1.0E-7);
+   }
+
+   void testIterate1D_lam_rigid_jfnk()
+   {
+      printMethod(TEST_FUNC);
+
+      System<1> system;
+      system.fileMaster().setInputPrefix(filePrefix());
+      system.fileMaster().setOutputPrefix(filePrefix());
+      openLogFile("out/testIterate1D_lam_rigid_jfnk.log");
+
+      std::ifstream in;
+      openInputFile("in/diblock/lam/param.rigid_jfnk", in);
+      system.readParam(in);
+      in.close();
+      TEST_ASSERT(!system.iterator().isSymmetric());
+
+      // Read reference w fields, then start from the initial guess
+      system.readWBasis("in/diblock/lam/omega.ref");
+      DArray< RField<1> > wFieldsRGrid_check;
+      wFieldsRGrid_check = system.w().rgrid();
+      system.readWBasis("in/diblock/lam/omega.in");
+
+      // Iterate and compare result to reference
+      int error = system.iterate();
+      if (error) {
+         TEST_THROW("Iterator failed to converge.");
+      }
+      system.writeWRGrid("out/testIterate1D_lam_rigid_jfnk_w.rf");
+
+      RFieldComparison<1> comparison;
+      comparison.compare(wFieldsRGrid_check, system.w().rgrid());
+      if (verbose() > 0) {
+         std::cout << "\n";
+         std::cout << "Max error = " << comparison.maxDiff();
+      }
+      TEST_ASSERT(comparison.maxDiff() < 2.0E-7);
+
+      // Compare free energies to values used in testIterate1D_lam_rigid
+      double fHelmholtz = 2.42932542391e+00;
+      double pressure = 3.01212693885e+00;
+      compareFreeEnergies(system, fHelmholtz, pressure);
+      TEST_ASSERT(fHelmholtz < 1.0E-7);
+      TEST_ASSERT(pressure < 1.0E-7);
+   }
+
    void testIterate1D_lam_flex()
    {
       printMethod(TEST_FUNC);
@@ -865,6 +1024,47 @@ public:
       // v1.1 test used omega.ref as input, compared to input
    }
 
+   void testIterateCoarseToFine3D_bcc()
+   {
+      printMethod(TEST_FUNC);
+
+      System<3> system;
+      system.fileMaster().setInputPrefix(filePrefix());
+      system.fileMaster().setOutputPrefix(filePrefix());
+      openLogFile("out/testIterateCoarseToFine3D_bcc.log");
+
+      std::ifstream in;
+      openInputFile("in/diblock/bcc/param.rigid", in);
+      system.readParam(in);
+      in.close();
+
+      // Coarse meshes must be multiples of the divisors of I_m_-3_m
+      IntVec<3> divisors = system.domain().group().meshDivisors();
+      for (int i = 0; i < 3; ++i) {
+         TEST_ASSERT(divisors[i] == 2);
+         TEST_ASSERT(system.domain().mesh().dimension(i) == 32);
+      }
+
+      // Iterate from initial guess, first on a mesh of 16^3 points
+      system.readWBasis("in/diblock/bcc/omega.in");
+      int error = system.iterateCoarseToFine(1);
+      if (error) {
+         TEST_THROW("Iterator failed to converge.");
+      }
+      system.writeWBasis("out/testIterateCoarseToFine3D_bcc_w.bf");
+
+      // Compare to reference omega.ref
+      double wMaxDiff = readCompareWBasis(system, "in/diblock/bcc/omega.ref");
+      TEST_ASSERT(wMaxDiff < 1.0E-5);
+
+      // Compare free energies to values used in testIterate3D_bcc_rigid
+      double fHelmholtz =   3.36918380842e+00;
+      double pressure =     4.03176984344e+00;
+      compareFreeEnergies(system, fHelmholtz, pressure);
+      TEST_ASSERT(fHelmholtz < 1.0E-6);
+      TEST_ASSERT(pressure < 1.0E-6);
+   }
+
    void testIterate3D_bcc_flex()
    {
       printMethod(TEST_FUNC);
@@ -1043,6 +1243,10 @@ TEST_ADD(SystemTest, testConversion2D_hex)
 TEST_ADD(SystemTest, testConversion3D_bcc)
 TEST_ADD(SystemTest, testCheckSymmetry3D_bcc)
 TEST_ADD(SystemTest, testIterate1D_lam_rigid)
+TEST_ADD(SystemTest, testIterate1D_lam_rigid_lr)
+TEST_ADD(SystemTest, testIterateCoarseToFine1D_lam)
+TEST_ADD(SystemTest, testIterate1D_lam_rigid_grid)
+TEST_ADD(SystemTest, testIterate1D_lam_rigid_jfnk)
 TEST_ADD(SystemTest, testIterate1D_lam_flex)
 TEST_ADD(SystemTest, testIterate1D_lam_soln)
 TEST_ADD(SystemTest, testIterate1D_lam_open_soln)
@@ -1051,6 +1255,7 @@ TEST_ADD(SystemTest, testIterate1D_lam_open_shift)
 TEST_ADD(SystemTest, testIterate2D_hex_rigid)
 TEST_ADD(SystemTest, testIterate2D_hex_flex)
 TEST_ADD(SystemTest, testIterate3D_bcc_rigid)
+TEST_ADD(SystemTest, testIterateCoarseToFine3D_bcc)
 TEST_ADD(SystemTest, testIterate3D_bcc_flex)
 TEST_ADD(SystemTest, testIterate3D_altGyr_flex)
 TEST_ADD(SystemTest, testIterate3D_c15_1_flex)
@@ -51,7 +51,7 @@ $(BLD_DIR)/%.o:$(SRC_DIR)/%.cu
 
 # Pattern rule to link executable Test programs in src/rpg/tests
 $(BLD_DIR)/%Test: $(BLD_DIR)/%Test.o  $(PSCF_LIBS)
-	$(NVXX) $(LDFLAGS) -o $@ $< $(LIBS)
+	$(NVXX) $(NVXX_LDFLAGS) -o $@ $< $(LIBS)
 
 # Note: In the linking rule for tests, we include the list $(PSCF_LIBS) 
 # of PSCF-specific libraries as dependencies but link to the full list 